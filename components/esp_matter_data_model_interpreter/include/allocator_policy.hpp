@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ALLOCATOR_POLICY_HPP
+#define ALLOCATOR_POLICY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+/**
+ * @brief Placement of the large buffers of the data model, e.g. internal RAM or PSRAM.
+ *
+ * DataModelManager, the storages and the Interpreter take their large,
+ * rarely touched buffers from a Policy, so that modules with PSRAM can keep
+ * internal RAM free for the network stacks. The default policy uses malloc().
+ * HeapCapsPolicy places each usage with heap_caps capabilities, falling back
+ * to the default heap when they have no room.
+ *
+ * Every policy counts, per usage, the bytes in use, their peak, the bytes
+ * placed in external RAM and the failed allocations. The counters of all
+ * policies are printed by the "dm alloc" console command.
+ *
+ * The memory esp_matter allocates for attributes is not covered; see
+ * CONFIG_ESP_MATTER_MEM_ALLOC_MODE in esp_matter for that.
+ */
+namespace allocator_policy {
+
+enum class Usage : uint8_t {
+    Binary,         // data model binaries read from storage
+    UpdateStaging,  // new data model streamed by DataModelManager::begin_update()
+    DecodeScratch,  // decoded messages of the interpreter
+    Payload,        // string and array values kept by the interpreter: value pool and endpoint shapes
+    Count,
+};
+
+constexpr size_t kUsageCount = static_cast<size_t>(Usage::Count);
+
+const char *usage_name(Usage usage);
+
+struct Counters {
+    size_t in_use;         // bytes allocated and not freed
+    size_t peak;           // highest in_use
+    size_t external;       // bytes of in_use placed in external RAM
+    uint32_t allocations;
+    uint32_t failures;
+};
+
+class Policy {
+public:
+    Policy();
+    virtual ~Policy();
+
+    Policy(const Policy &) = delete;
+    Policy &operator=(const Policy &) = delete;
+
+    virtual const char *name() const = 0;
+
+    /* Returns nullptr on failure. */
+    void *allocate(Usage usage, size_t size);
+    void deallocate(Usage usage, void *ptr, size_t size);
+
+    Counters counters(Usage usage) const;
+
+    /* Restart the peaks from the current use. */
+    void reset_peaks();
+
+protected:
+    virtual void *do_allocate(Usage usage, size_t size) = 0;
+    virtual void do_deallocate(Usage usage, void *ptr) = 0;
+    virtual bool is_external(const void *) const { return false; }
+
+private:
+    struct AtomicCounters {
+        std::atomic<size_t> in_use{0};
+        std::atomic<size_t> peak{0};
+        std::atomic<size_t> external{0};
+        std::atomic<uint32_t> allocations{0};
+        std::atomic<uint32_t> failures{0};
+    };
+    AtomicCounters counters_[kUsageCount];
+};
+
+/* malloc() and free(), the policy used when none is given. */
+class MallocPolicy : public Policy {
+public:
+    const char *name() const override { return "malloc"; }
+
+protected:
+    void *do_allocate(Usage usage, size_t size) override;
+    void do_deallocate(Usage usage, void *ptr) override;
+};
+
+/**
+ * @brief heap_caps_malloc() with capabilities per usage.
+ *
+ * An allocation is tried with the capabilities of its usage first, then with
+ * MALLOC_CAP_DEFAULT, so a full or missing PSRAM only moves the buffer back to
+ * internal RAM.
+ */
+class HeapCapsPolicy : public Policy {
+public:
+    /* Use caps (e.g. MALLOC_CAP_SPIRAM) for every usage. */
+    explicit HeapCapsPolicy(uint32_t caps);
+
+    void set_caps(Usage usage, uint32_t caps);
+
+    const char *name() const override { return "heap_caps"; }
+
+protected:
+    void *do_allocate(Usage usage, size_t size) override;
+    void do_deallocate(Usage usage, void *ptr) override;
+    bool is_external(const void *ptr) const override;
+
+private:
+    uint32_t caps_[kUsageCount];
+};
+
+/* The MallocPolicy used by default. */
+Policy &default_policy();
+
+/**
+ * @brief Print the counters of every policy alive, as shown by the "dm alloc" console command.
+ */
+void print_counters();
+
+/**
+ * @brief Byte buffer of a data model, with the placement of its policy and usage.
+ *
+ * The component is built without C++ exceptions, so the calls that allocate
+ * return ESP_ERR_NO_MEM, and leave the buffer unchanged, when the policy fails.
+ */
+class Buffer {
+public:
+    /* Empty buffer of the default policy, for binaries. */
+    Buffer() noexcept;
+    Buffer(Policy &policy, Usage usage) noexcept;
+    ~Buffer();
+
+    Buffer(Buffer &&other) noexcept;
+    Buffer &operator=(Buffer &&other) noexcept;
+    Buffer(const Buffer &) = delete;
+    Buffer &operator=(const Buffer &) = delete;
+
+    /* Set the size, keeping the first bytes; new bytes are zero. */
+    esp_err_t resize(size_t size);
+    /* Make room for capacity bytes without changing the size. */
+    esp_err_t reserve(size_t capacity);
+    /* Add length bytes at the end, growing the capacity geometrically. */
+    esp_err_t append(const uint8_t *data, size_t length);
+    /* Replace the content with length bytes of data. */
+    esp_err_t assign(const uint8_t *data, size_t length);
+
+    /* Set the size to 0 and keep the memory. */
+    void clear() noexcept { size_ = 0; }
+    /* Set the size to 0 and free the memory. */
+    void release() noexcept;
+    /* Free the unused capacity, if a smaller block can be allocated. */
+    void shrink_to_fit() noexcept;
+
+    uint8_t *data() noexcept { return data_; }
+    const uint8_t *data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    Policy &policy() const noexcept { return *policy_; }
+    Usage usage() const noexcept { return usage_; }
+
+private:
+    esp_err_t reallocate(size_t capacity);
+
+    Policy *policy_;
+    Usage usage_;
+    uint8_t *data_;
+    size_t size_;
+    size_t capacity_;
+};
+
+} // namespace allocator_policy
+
+#endif // ALLOCATOR_POLICY_HPP
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ATTRIBUTE_COALESCER_HPP
+#define ATTRIBUTE_COALESCER_HPP
+
+#include <cstdint>
+
+#include "esp_err.h"
+#include "esp_matter.h"
+
+#include "attribute_dispatcher.hpp"
+
+/**
+ * @brief Coalescing and rate limiting of attribute updates before the driver.
+ *
+ * Transitions and fast controllers write some attributes (levels, hues, color
+ * temperatures) many times a second. Updates of the attributes given a window
+ * with set_window() are queued by submit() instead of being dispatched from the
+ * Matter task, and a driver task delivers them through the AttributeDispatcher:
+ *
+ * - An attribute is delivered at most once per window. The first update after
+ *   a quiet window is delivered right away, the next ones when the window ends.
+ * - Updates of a queued attribute replace its value, so only the latest value
+ *   reaches the driver.
+ * - Updates due at the same time are delivered grouped by endpoint, and the
+ *   batch callback is called after each endpoint, e.g. to write the light once
+ *   for a new level and color.
+ *
+ * Only scalar values are queued. As the handler runs after the update was
+ * accepted, attributes whose handler may reject a value should not be given a
+ * window. Queued updates are kept in CONFIG_DM_ATTRIBUTE_COALESCER_SLOTS slots,
+ * also used to remember when an attribute was last delivered.
+ */
+namespace attribute_coalescer {
+
+/* attribute_id of set_window() matching all attributes of the cluster. */
+constexpr uint32_t kAnyAttribute = UINT32_MAX;
+
+/* Counters since start() or reset_stats(). */
+struct Stats {
+    uint32_t submitted;  // updates queued or merged by submit()
+    uint32_t merged;     // updates that replaced the value of a queued update
+    uint32_t dropped;    // updates not queued because all slots were queued, dispatched by the caller
+    uint32_t delivered;  // updates dispatched by the driver task
+    uint32_t batches;    // endpoint batches delivered
+    uint32_t failed;     // deliveries for which the handler returned an error
+};
+
+/* Called by the driver task once the updates of an endpoint in a batch are delivered. */
+using BatchCallback = void (*)(uint16_t endpoint_id, void *arg);
+
+/**
+ * @brief Start the driver task.
+ *
+ * @param dispatcher Dispatcher the updates are delivered through, it has to outlive the coalescer.
+ * @param batch_callback Optional callback called after the updates of each endpoint.
+ * @param arg Argument passed to batch_callback.
+ * @return ESP_OK on success,
+ *         ESP_ERR_INVALID_STATE if already started,
+ *         or ESP_ERR_NO_MEM if the task could not be created.
+ */
+esp_err_t start(esp_matter_data_model_interpreter::AttributeDispatcher &dispatcher,
+                BatchCallback batch_callback = nullptr, void *arg = nullptr);
+
+/**
+ * @brief Coalesce the updates of an attribute, or of all attributes of a cluster with kAnyAttribute.
+ *
+ * A window for an attribute takes precedence over the window of its cluster.
+ * A window of 0 removes the entry.
+ *
+ * @return ESP_OK on success or ESP_ERR_NO_MEM if CONFIG_DM_ATTRIBUTE_COALESCER_WINDOWS windows are set.
+ */
+esp_err_t set_window(uint32_t cluster_id, uint32_t attribute_id, uint32_t window_ms);
+
+/**
+ * @brief Queue an attribute update, from the attribute update callback.
+ *
+ * @return ESP_OK if the update is queued, otherwise dispatch it synchronously:
+ *         ESP_ERR_NOT_SUPPORTED if the attribute has no window, the value is not a scalar or the coalescer is not started,
+ *         ESP_ERR_NOT_FOUND if the dispatcher has no handler for the attribute,
+ *         or ESP_ERR_NO_MEM if all slots are queued (counted as dropped).
+ */
+esp_err_t submit(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val);
+
+void get_stats(Stats &stats);
+void reset_stats();
+
+/**
+ * @brief Print the counters and the windows, as shown by the "dm coalesce" console command.
+ */
+void print_stats();
+
+} // namespace attribute_coalescer
+
+#endif // ATTRIBUTE_COALESCER_HPP
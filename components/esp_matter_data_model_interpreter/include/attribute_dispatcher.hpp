@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ATTRIBUTE_DISPATCHER_HPP
+#define ATTRIBUTE_DISPATCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "esp_err.h"
+#include "esp_matter.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "attribute_path_table.hpp"
+
+namespace esp_matter_data_model_interpreter {
+
+/**
+ * @brief Routes attribute updates to the driver handling their cluster.
+ *
+ * Handlers are registered per cluster id before the data model is
+ * interpreted. Pass on_attribute_created() to
+ * Interpreter::set_attribute_created_callback() and every attribute of a
+ * handled cluster is added to an AttributePathTable, keyed by
+ * (endpoint, cluster, attribute), with its handler and context. Pass
+ * on_endpoint_removed() to Interpreter::set_endpoint_removed_callback() to
+ * remove them again with their endpoint. dispatch()
+ * is then a single probe sequence without allocation or logging, suitable
+ * for the attribute update callback.
+ *
+ * The context of an entry is the one given to register_cluster_handler(),
+ * or the one returned by the context resolver if one is set, e.g. a driver
+ * instance per endpoint.
+ *
+ * The table is guarded by a mutex: the interpreter adds and removes entries
+ * from the task applying a delta while the attribute coalescer dispatches
+ * from its driver task. Handlers are called after the mutex is released, so
+ * a context has to stay valid after its entries are removed.
+ */
+class AttributeDispatcher {
+public:
+    using Handler = esp_err_t (*)(void *context, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                  esp_matter_attr_val_t *val);
+    using ContextResolver = void *(*)(uint16_t endpoint_id, uint32_t cluster_id, void *arg);
+
+    AttributeDispatcher();
+    ~AttributeDispatcher();
+
+    /**
+     * @brief Handle the attributes of a cluster id, on every endpoint.
+     *
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if attributes were already added,
+     *         or ESP_ERR_NO_MEM if 255 clusters are already handled.
+     */
+    esp_err_t register_cluster_handler(uint32_t cluster_id, Handler handler, void *context = nullptr);
+
+    /**
+     * @brief Resolve the context of each attribute when it is added, instead of the handler context.
+     */
+    void set_context_resolver(ContextResolver resolver, void *arg);
+
+    /**
+     * @brief Add an attribute, ignored if no handler is registered for its cluster.
+     *
+     * @return ESP_OK on success or ESP_ERR_NO_MEM.
+     */
+    esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+    /**
+     * @brief Remove the attributes of an endpoint, e.g. when it is destroyed.
+     *
+     * Called through on_endpoint_removed() for the endpoints the interpreter removes.
+     */
+    void remove_endpoint(uint16_t endpoint_id);
+
+    /**
+     * @brief Remove all attributes and keep the handlers, e.g. after a failed interpretation destroyed the node.
+     */
+    void clear();
+
+    /**
+     * @brief Call the handler of an attribute.
+     *
+     * @return The result of the handler, or ESP_ERR_NOT_FOUND if the attribute has no handler.
+     */
+    esp_err_t dispatch(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val) const;
+
+    /* Whether dispatch() would call a handler for the attribute. */
+    bool has_handler(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const;
+
+    /* Number of attributes with a handler. */
+    size_t size() const;
+
+    /* Adapter for Interpreter::set_attribute_created_callback(), arg is the dispatcher. */
+    static void on_attribute_created(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, void *arg);
+
+    /* Adapter for Interpreter::set_endpoint_removed_callback(), arg is the dispatcher. */
+    static void on_endpoint_removed(uint16_t endpoint_id, void *arg);
+
+private:
+    struct Target {
+        uint8_t handler;  // index into handlers_
+        void *context;
+    };
+
+    struct ClusterHandler {
+        uint32_t cluster_id;
+        Handler handler;
+        void *context;
+    };
+
+    std::vector<ClusterHandler> handlers_;
+    ContextResolver resolver_;
+    void *resolver_arg_;
+    AttributePathTable<Target> table_;
+    StaticSemaphore_t lock_buffer_;
+    SemaphoreHandle_t lock_;
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // ATTRIBUTE_DISPATCHER_HPP
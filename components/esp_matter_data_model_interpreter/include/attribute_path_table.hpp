@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ATTRIBUTE_PATH_TABLE_HPP
+#define ATTRIBUTE_PATH_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace esp_matter_data_model_interpreter {
+
+/* Hash of an attribute path, shared by the open-addressing tables of the interpreter. */
+inline uint32_t hash_attribute_path(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    // Attribute and cluster ids are small or share their vendor prefix, mix all the bits.
+    uint32_t h = attribute_id * 0x9e3779b1u;
+    h ^= (cluster_id + 0x7f4a7c15u + (h << 6) + (h >> 2)) * 0x85ebca6bu;
+    h ^= (endpoint_id + 0x165667b1u + (h << 6) + (h >> 2)) * 0xc2b2ae35u;
+    return h ^ (h >> 16);
+}
+
+/**
+ * @brief Open-addressing hash table from an attribute path (endpoint, cluster, attribute) to a Value.
+ *
+ * Linear probing over a power-of-two number of slots. Removed entries leave a tombstone so that
+ * the probe sequences of the other entries stay intact, and the table is rebuilt, doubled when
+ * mostly full of entries, once entries and tombstones take 3/4 of it. Used by the AttributeIndex
+ * of the interpreter and by the AttributeDispatcher.
+ *
+ * Value has to be trivially copyable. The table does no locking.
+ */
+template <typename Value>
+class AttributePathTable {
+public:
+    AttributePathTable() : capacity_(0), count_(0), used_(0) {}
+    AttributePathTable(const AttributePathTable &) = delete;
+    AttributePathTable &operator=(const AttributePathTable &) = delete;
+
+    /* The value of an attribute, or nullptr if it is not in the table. */
+    const Value *find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+    {
+        size_t i = find_slot(endpoint_id, cluster_id, attribute_id);
+        return i < capacity_ ? &entries_[i].value : nullptr;
+    }
+
+    /*
+     * The value of an attribute, added value-initialized if it is not in the table yet.
+     * Returns nullptr if the table has to grow and cannot.
+     */
+    Value *insert(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+    {
+        // Keep the load, tombstones included, under 3/4.
+        if ((used_ + 1) * 4 > capacity_ * 3 && !grow()) {
+            return nullptr;
+        }
+
+        size_t mask = capacity_ - 1;
+        Entry *slot = nullptr;
+        for (size_t i = hash_attribute_path(endpoint_id, cluster_id, attribute_id) & mask;; i = (i + 1) & mask) {
+            Entry &entry = entries_[i];
+            if (entry.state != kUsed) {
+                if (!slot) {
+                    slot = &entry;
+                }
+                if (entry.state == kFree) {
+                    break;
+                }
+            } else if (entry.attribute_id == attribute_id && entry.cluster_id == cluster_id &&
+                       entry.endpoint_id == endpoint_id) {
+                return &entry.value;
+            }
+        }
+        if (slot->state == kFree) {
+            used_++;
+        }
+        *slot = {cluster_id, attribute_id, endpoint_id, kUsed, Value()};
+        count_++;
+        return &slot->value;
+    }
+
+    /* Remove the attributes of an endpoint. */
+    void remove_endpoint(uint16_t endpoint_id)
+    {
+        for (size_t i = 0; i < capacity_; i++) {
+            Entry &entry = entries_[i];
+            if (entry.state == kUsed && entry.endpoint_id == endpoint_id) {
+                entry.state = kTombstone;
+                count_--;
+            }
+        }
+    }
+
+    /* Remove all attributes and release the table. */
+    void clear()
+    {
+        entries_.reset();
+        capacity_ = 0;
+        count_ = 0;
+        used_ = 0;
+    }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return capacity_; }
+    size_t memory_bytes() const { return capacity_ * sizeof(Entry); }
+
+private:
+    static constexpr size_t kInitialCapacity = 64;
+    static constexpr uint8_t kFree = 0;
+    static constexpr uint8_t kUsed = 1;
+    static constexpr uint8_t kTombstone = 2;
+
+    struct Entry {
+        uint32_t cluster_id;
+        uint32_t attribute_id;
+        uint16_t endpoint_id;
+        uint8_t state;
+        Value value;
+    };
+
+    /* The slot of an attribute, or capacity_ if it is not in the table. */
+    size_t find_slot(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+    {
+        if (capacity_ == 0) {
+            return 0;
+        }
+        size_t mask = capacity_ - 1;
+        for (size_t i = hash_attribute_path(endpoint_id, cluster_id, attribute_id) & mask;; i = (i + 1) & mask) {
+            const Entry &entry = entries_[i];
+            if (entry.state == kFree) {
+                return capacity_;
+            }
+            if (entry.state == kUsed && entry.attribute_id == attribute_id && entry.cluster_id == cluster_id &&
+                entry.endpoint_id == endpoint_id) {
+                return i;
+            }
+        }
+    }
+
+    bool grow()
+    {
+        // Double when mostly full of entries, otherwise only drop the tombstones.
+        size_t capacity = capacity_ == 0 ? kInitialCapacity : (count_ * 2 >= capacity_ ? capacity_ * 2 : capacity_);
+        std::unique_ptr<Entry[]> entries(new (std::nothrow) Entry[capacity]());
+        if (!entries) {
+            return false;
+        }
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < capacity_; i++) {
+            const Entry &entry = entries_[i];
+            if (entry.state != kUsed) {
+                continue;
+            }
+            size_t j = hash_attribute_path(entry.endpoint_id, entry.cluster_id, entry.attribute_id) & mask;
+            while (entries[j].state != kFree) {
+                j = (j + 1) & mask;
+            }
+            entries[j] = entry;
+        }
+        entries_ = std::move(entries);
+        capacity_ = capacity;
+        used_ = count_;
+        return true;
+    }
+
+    std::unique_ptr<Entry[]> entries_;
+    size_t capacity_;  // power of two
+    size_t count_;
+    size_t used_;      // entries and tombstones
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // ATTRIBUTE_PATH_TABLE_HPP
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef BOOT_PROFILER_HPP
+#define BOOT_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+namespace boot_profiler {
+
+/**
+ * @brief Phases of the boot of a data model based application.
+ *
+ * Phases that are entered several times in one boot (e.g. a blob read
+ * retried from the fallback key) keep their first start time and sum up
+ * their durations.
+ */
+enum class Phase : uint8_t {
+    NvsInit,             // nvs_flash_init() of the default partition
+    StorageOpen,         // initialisation of the data model storage
+    BlobRead,            // reading and verifying the data model blob
+    Promotion,           // slot state updates: boot attempts, rollback, fallback key promotion
+    Interpretation,      // Interpreter::interpret_data()
+    MatterStart,         // esp_matter::start()
+    FirstAdvertisement,  // the first commissioning window opened, a point in time
+    Count,
+};
+
+/**
+ * @brief Timing of one boot, in microseconds since esp_timer started.
+ *
+ * start_us is 0 for phases that were not reached.
+ */
+struct BootRecord {
+    uint32_t boot_number;   // counts the boots since the history was last lost
+    uint8_t reset_reason;   // esp_reset_reason_t of this boot
+    uint32_t start_us[static_cast<size_t>(Phase::Count)];
+    uint32_t duration_us[static_cast<size_t>(Phase::Count)];
+};
+
+/**
+ * @brief Start the record of this boot, call it first thing in app_main().
+ *
+ * The records of the last CONFIG_DM_BOOT_PROFILER_HISTORY boots are kept in
+ * memory that is not initialised at startup (RTC_NOINIT_ATTR). It survives
+ * software resets, panics and watchdog resets but not a power cycle, after
+ * which the history starts over.
+ */
+void init();
+
+/**
+ * @brief Mark the start and the end of a phase of this boot.
+ */
+void begin(Phase phase);
+void end(Phase phase);
+
+/**
+ * @brief Record a phase that is a single point in time, once per boot.
+ */
+void mark(Phase phase);
+
+/**
+ * @brief RAII helper calling begin() and end() for a phase.
+ */
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase) : phase_(phase) { begin(phase_); }
+    ~ScopedPhase() { end(phase_); }
+
+private:
+    Phase phase_;
+};
+
+/**
+ * @brief Get the record of a past boot.
+ *
+ * @param age 0 for this boot, 1 for the previous boot, and so on.
+ * @param[out] record The record.
+ * @return ESP_OK on success,
+ *         ESP_ERR_NOT_FOUND if the boot is not in the history,
+ *         or ESP_ERR_NOT_SUPPORTED if CONFIG_DM_BOOT_PROFILER is disabled.
+ */
+esp_err_t get_record(size_t age, BootRecord &record);
+
+const char *phase_name(Phase phase);
+
+/**
+ * @brief Print the history, most recent boot first, as shown by the "dm boot" console command.
+ */
+void print_history();
+
+} // namespace boot_profiler
+
+#endif // BOOT_PROFILER_HPP
@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef DATA_MODEL_CONSOLE_HPP
+#define DATA_MODEL_CONSOLE_HPP
+
+#include "esp_err.h"
+
+namespace esp_matter_data_model_interpreter {
+namespace console {
+
+/**
+ * @brief Register the "dm" command with the esp_matter console.
+ *
+ * Subcommands:
+ *   dm boot    timing of the boot phases of the last boots, see boot_profiler.hpp
+ *   dm heap    heap taken by the endpoints and clusters, see heap_accounting.hpp
+ *   dm coalesce [reset]  counters of the attribute update coalescer, see attribute_coalescer.hpp
+ *   dm alloc   memory of the data model buffers per allocator policy, see allocator_policy.hpp
+ *
+ * Call it with the other console registrations, before esp_matter::console::init().
+ *
+ * @return ESP_OK on success, or ESP_ERR_NOT_SUPPORTED if CONFIG_ENABLE_CHIP_SHELL is disabled.
+ */
+esp_err_t register_commands();
+
+} // namespace console
+} // namespace esp_matter_data_model_interpreter
+
+#endif // DATA_MODEL_CONSOLE_HPP
@@ -6,19 +6,34 @@
 #ifndef DATA_MODEL_MANAGER_HPP
 #define DATA_MODEL_MANAGER_HPP
 
-#include <vector>
 #include <cstddef>
+#include <cstdint>
 
+#include "allocator_policy.hpp"
 #include "data_model_storage.hpp"
 
 namespace data_model_manager {
 
 /**
- * @brief Manager class that orchestrates the retrieval (and later update)
+ * @brief Manager class that orchestrates the retrieval and update
  *        of the data model binary.
  *
  * This class uses an underlying storage implementation (via IDataModelStorage)
  * to load the data model binary. It handles the key selection and fallback logic.
+ *
+ * Each running partition owns two data model slots and a small slot state record
+ * ("<label>_dms") that maps each slot to the key of the blob holding its data
+ * model and points at the active slot. A new data model is streamed into the
+ * inactive slot and activated by rewriting the slot state record, which NVS
+ * commits atomically. A freshly activated data model stays pending until
+ * mark_data_model_valid() is called; if the device reboots before that, the
+ * previous slot is restored on the next boot.
+ *
+ * Blobs are shared between slots and partitions when their content is identical
+ * and are erased only once no slot state record refers to them.
+ *
+ * Data model binaries and the update staging buffer are allocated with the
+ * allocator policy given at construction, see allocator_policy.hpp.
  */
 class DataModelManager {
 public:
@@ -26,24 +41,170 @@ public:
      * @brief Construct a DataModelManager with a storage object.
      *
      * @param storage Reference to an object implementing IDataModelStorage.
+     * @param policy Placement of the binaries, it has to outlive the manager and the binaries it returns.
      */
-    DataModelManager(IDataModelStorage &storage);
+    DataModelManager(IDataModelStorage &storage,
+                     allocator_policy::Policy &policy = allocator_policy::default_policy());
     ~DataModelManager();
 
     /**
      * @brief Get the data model binary.
      *
-     * This function retrieves the data model binary from storage using a key constructed
-     * from the current running partition label. If that key is not found,
-     * it falls back to the key "ota_0_dm" and renames it.
+     * This function retrieves the data model binary from the active slot of the
+     * current running partition. If the active slot holds a pending data model
+     * that was not confirmed during the previous boot, the previous slot is
+     * restored first. If no data model is stored for the running partition,
+     * it falls back to the confirmed data model of partition "ota_0", found
+     * through its slot state record, or to the key "ota_0_dm" if it has none,
+     * and records that key in the slot state record of the running partition;
+     * the blob itself is not copied.
      *
      * @param[out] data_model_binary_size Output parameter for the binary size.
-     * @return A vector containing the data model binary. An empty vector indicates an error.
+     * @return A buffer containing the data model binary. An empty buffer indicates an error.
+     */
+    allocator_policy::Buffer get_data_model_binary(size_t &data_model_binary_size);
+
+    /**
+     * @brief Read the data model binary of the active slot.
+     *
+     * Unlike get_data_model_binary(), this does not count a boot attempt or
+     * change the slot state. It is used as the source when applying a patch.
+     *
+     * @param[out] data Output buffer filled with the verified binary.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_CRC if the stored binary fails verification,
+     *         or a storage error code.
+     */
+    esp_err_t get_active_data_model(allocator_policy::Buffer &data);
+
+    /**
+     * @brief Start streaming a new data model binary into the inactive slot.
+     *
+     * @param size Total size of the new data model binary in bytes.
+     * @param crc32 CRC-32 (IEEE 802.3, as computed by zlib.crc32) of the new binary.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_ARG if size is zero,
+     *         ESP_ERR_INVALID_STATE if an update is already in progress or the
+     *         active data model has not been confirmed yet,
+     *         ESP_ERR_NO_MEM if the staging buffer cannot be allocated.
+     */
+    esp_err_t begin_update(size_t size, uint32_t crc32);
+
+    /**
+     * @brief Append a chunk of the new data model binary.
+     *
+     * @param data Pointer to the chunk.
+     * @param length Length of the chunk in bytes.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if no update is in progress,
+     *         ESP_ERR_INVALID_SIZE if the chunk exceeds the announced size.
      */
-    std::vector<uint8_t> get_data_model_binary(size_t &data_model_binary_size);
+    esp_err_t write_update(const uint8_t *data, size_t length);
+
+    /**
+     * @brief Verify the streamed binary and switch the active slot to it.
+     *
+     * The new data model is used from the next call to get_data_model_binary()
+     * (normally the next boot) and stays pending until mark_data_model_valid().
+     *
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if no update is in progress,
+     *         ESP_ERR_INVALID_SIZE if fewer bytes than announced were written,
+     *         ESP_ERR_INVALID_CRC if the CRC-32 does not match,
+     *         or a storage error code.
+     */
+    esp_err_t end_update();
+
+    /**
+     * @brief Discard an update in progress. The active slot is left untouched.
+     */
+    void abort_update();
+
+    /**
+     * @brief Confirm the active data model and cancel the pending rollback.
+     *
+     * Call this once the data model returned by get_data_model_binary() has
+     * been interpreted successfully.
+     *
+     * @return ESP_OK on success or a storage error code.
+     */
+    esp_err_t mark_data_model_valid();
+
+    /**
+     * @brief Check whether the active data model is pending confirmation.
+     *
+     * @param[out] pending True if the active data model has not been confirmed yet.
+     * @return ESP_OK on success or a storage error code.
+     */
+    esp_err_t is_data_model_pending(bool &pending);
+
+    /**
+     * @brief Switch to the data model of the other slot, after the active one failed to interpret.
+     *
+     * Call this when the Interpreter rejects the binary returned by
+     * get_data_model_binary(), instead of rebooting until the rollback. If the
+     * active data model is pending, the previous slot is restored and stays
+     * confirmed. If it was confirmed, e.g. before a firmware update that no
+     * longer accepts it, the other slot becomes active and pending: confirming
+     * it with mark_data_model_valid() makes the switch permanent, leaving it
+     * pending returns to the failed slot on the next boot.
+     *
+     * @param[out] data Filled with the verified binary of the other slot.
+     * @return ESP_OK on success,
+     *         ESP_ERR_NOT_FOUND if there is no other data model,
+     *         ESP_ERR_INVALID_CRC if it fails verification,
+     *         or a storage error code.
+     */
+    esp_err_t fall_back_to_last_known_good(allocator_policy::Buffer &data);
+
+    /* A stored data model binary. */
+    struct BlobRef {
+        char key[16];  // NVS key, empty if none; NVS keys are at most 15 characters
+        uint32_t size;
+        uint32_t crc32;
+    };
+
+    /**
+     * @brief Get the blob of the binary last returned by get_data_model_binary() or
+     *        fall_back_to_last_known_good().
+     *
+     * The blob stays stored while a slot refers to it: after end_update() or
+     * fall_back_to_last_known_good(), the inactive slot does. A second update
+     * without a reboot may overwrite it, which read_blob() reports.
+     *
+     * @param[out] blob The key, size and CRC-32 of the binary.
+     * @return ESP_OK on success,
+     *         ESP_ERR_NOT_FOUND if no binary has been returned yet.
+     */
+    esp_err_t get_loaded_blob(BlobRef &blob) const;
+
+    /**
+     * @brief Read a blob returned by get_loaded_blob(), verified against its size and CRC-32.
+     *
+     * @param blob The blob to read.
+     * @param[out] data Output buffer filled with the verified binary.
+     * @return ESP_OK on success,
+     *         ESP_ERR_NOT_FOUND if blob has no key,
+     *         ESP_ERR_INVALID_CRC if the blob now holds another binary,
+     *         or a storage error code.
+     */
+    esp_err_t read_blob(const BlobRef &blob, allocator_policy::Buffer &data);
+
+    /* Policy the binaries are allocated with. */
+    allocator_policy::Policy &policy() const { return policy_; }
 
 private:
+    void set_loaded_blob(const char *key, const allocator_policy::Buffer &data, uint32_t size, uint32_t crc32);
+
     class IDataModelStorage &storage_;
+    allocator_policy::Policy &policy_;
+    BlobRef loaded_;
+
+    allocator_policy::Buffer update_buffer_;
+    size_t update_size_;
+    uint32_t update_crc32_;
+    uint32_t update_running_crc32_;
+    bool update_in_progress_;
 };
 
 } // namespace data_model_manager
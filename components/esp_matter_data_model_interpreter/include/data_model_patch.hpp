@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef DATA_MODEL_PATCH_HPP
+#define DATA_MODEL_PATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "data_model_manager.hpp"
+
+namespace data_model_manager {
+
+/**
+ * @brief Streaming applier for data model binary patches.
+ *
+ * A patch is produced on the host by `matter_data_model_patch.py` from the old
+ * and the new data model binaries. It is laid out as:
+ *
+ *   "DMP" <version:u8>
+ *   <source size:varint> <source crc32:u32 LE>
+ *   <target size:varint> <target crc32:u32 LE>
+ *   <op>...
+ *
+ * where each op is either COPY (0x00) <offset:varint> <length:varint>, copying
+ * bytes of the source binary, or INSERT (0x01) <length:varint> <bytes>.
+ *
+ * The source is the active data model of the DataModelManager and must match
+ * the source size and CRC-32 of the patch. The output is streamed into the
+ * inactive slot through DataModelManager::write_update(), which verifies the
+ * target size and CRC-32 before the slot is activated.
+ */
+class DataModelPatcher {
+public:
+    /**
+     * @brief Construct a DataModelPatcher that updates the given manager.
+     *
+     * @param manager Manager whose active data model is the patch source.
+     */
+    DataModelPatcher(DataModelManager &manager);
+    ~DataModelPatcher();
+
+    /**
+     * @brief Start applying a new patch.
+     *
+     * @return ESP_OK on success, ESP_ERR_INVALID_STATE if a patch is already being applied.
+     */
+    esp_err_t begin();
+
+    /**
+     * @brief Feed the next chunk of the patch. Chunks may be split anywhere.
+     *
+     * @param data Pointer to the chunk.
+     * @param length Length of the chunk in bytes.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if begin() was not called,
+     *         ESP_ERR_INVALID_VERSION if the patch header is not recognized,
+     *         ESP_ERR_INVALID_ARG if the patch contains an unknown op,
+     *         ESP_ERR_INVALID_CRC if the active data model is not the patch source,
+     *         ESP_ERR_INVALID_SIZE if an op is out of bounds,
+     *         or an error returned by the DataModelManager.
+     *         On error the patch is aborted.
+     */
+    esp_err_t write(const uint8_t *data, size_t length);
+
+    /**
+     * @brief Finish the patch and activate the patched data model.
+     *
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if the patch is truncated,
+     *         or an error returned by DataModelManager::end_update().
+     */
+    esp_err_t end();
+
+    /**
+     * @brief Discard the patch being applied.
+     */
+    void abort();
+
+private:
+    enum class State : uint8_t {
+        Idle,
+        Magic,
+        SourceSize,
+        SourceCrc,
+        TargetSize,
+        TargetCrc,
+        Op,
+        CopyOffset,
+        CopyLength,
+        InsertLength,
+        InsertData,
+    };
+
+    esp_err_t on_header_complete();
+    esp_err_t on_value(uint32_t value);
+
+    DataModelManager &manager_;
+    State state_;
+    allocator_policy::Buffer source_;
+    uint32_t value_;
+    uint8_t value_bytes_;
+    uint32_t source_size_;
+    uint32_t source_crc32_;
+    uint32_t target_size_;
+    uint32_t target_crc32_;
+    uint32_t copy_offset_;
+    uint32_t remaining_;
+    bool update_started_;
+};
+
+} // namespace data_model_manager
+
+#endif // DATA_MODEL_PATCH_HPP
@@ -6,11 +6,12 @@
 #ifndef IDATA_MODEL_STORAGE_HPP
 #define IDATA_MODEL_STORAGE_HPP
 
-#include <vector>
 #include <string_view>
 
 #include "esp_err.h"
 
+#include "allocator_policy.hpp"
+
 /**
  * @brief Abstract interface for data model storage.
  *
@@ -23,14 +24,15 @@ public:
     /**
      * @brief Retrieve the data model binary associated with the given key.
      *
-     * The binary is returned in the provided vector. If the key is not found,
-     * the vector will be left empty.
+     * The binary is returned in the provided buffer, allocated with the policy
+     * and usage of the buffer. If the key is not found, the buffer will be
+     * left empty.
      *
      * @param key Key name as a std::string_view.
-     * @param data Output vector that will be filled with the binary data.
+     * @param data Output buffer that will be filled with the binary data.
      * @return ESP_OK on success or an error code on failure.
      */
-    virtual esp_err_t get_data_model(std::string_view key, std::vector<uint8_t> &data) = 0;
+    virtual esp_err_t get_data_model(std::string_view key, allocator_policy::Buffer &data) = 0;
 
     /**
      * @brief Store the given data model binary under the specified key.
@@ -39,7 +41,7 @@ public:
      * @param data The binary data to store.
      * @return ESP_OK on success or an error code on failure.
      */
-    virtual esp_err_t set_data_model(std::string_view key, const std::vector<uint8_t> &data) = 0;
+    virtual esp_err_t set_data_model(std::string_view key, const allocator_policy::Buffer &data) = 0;
 
     /**
      * @brief Remove the data model associated with the given key.
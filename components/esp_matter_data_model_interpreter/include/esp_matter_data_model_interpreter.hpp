@@ -9,31 +9,222 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "esp_matter.h"
+#include "allocator_policy.hpp"
+#include "esp_matter_data_model_static.hpp"
 
 namespace esp_matter_data_model_interpreter {
 
+class IPayloadSource;
+
 /**
  * @brief Interprets the data model binary and creates a Matter node.
  *
  * Internally, it makes the relevant API esp_matter::create* calls
  * to initialise the Matter data model.
+ *
+ * All decoding state is held by the instance, and messages are decoded into
+ * a buffer the instance keeps for the following messages and binaries.
  */
 class Interpreter {
 public:
+    /* Called for each attribute created, with the id of the endpoint as created. */
+    using AttributeCreatedCallback = void (*)(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                              void *arg);
+    /* Called for each endpoint removed, before it is destroyed. */
+    using EndpointRemovedCallback = void (*)(uint16_t endpoint_id, void *arg);
+
     Interpreter();
+
+    /**
+     * @brief Create an interpreter that takes its decode buffers and kept payloads from policy.
+     *
+     * @param policy Allocator policy, it has to outlive the interpreter.
+     */
+    explicit Interpreter(allocator_policy::Policy &policy);
+
     ~Interpreter();
 
     /**
      * @brief Interpret the provided data model binary.
      *
+     * The binary is interpreted as a whole or not at all. With
+     * CONFIG_DM_INTERPRETER_VALIDATE, it is checked before anything is created;
+     * any message that fails to apply destroys the partly created node with
+     * esp_matter::node::destroy(). After a failure, another binary can be
+     * interpreted, e.g. the last known good one from
+     * DataModelManager::fall_back_to_last_known_good().
+     *
+     * Attributes reported to the attribute created callback before a failure
+     * belong to the destroyed node.
+     *
      * @param data Pointer to the binary data.
      * @param length Length of the binary data.
      * @return Pointer to the created Matter node, or nullptr on failure.
      */
     esp_matter::node_t* interpret_data(const uint8_t *data, size_t length);
 
+    /**
+     * @brief Create the Matter node from a data model compiled into the application.
+     *
+     * The tables are generated by the serializer with --header and read in place
+     * from flash, so nothing is decoded and no copy of the data model is made.
+     * The node is the same as the one interpret_data() creates from the binary
+     * of the same .matter file. The node can be changed later with apply_delta()
+     * and instantiate().
+     *
+     * @param model The generated model, e.g. esp_matter_static_data_model::model.
+     * @return Pointer to the created Matter node, or nullptr on failure (the node is then destroyed).
+     */
+    esp_matter::node_t* interpret_static(const static_model::Model &model);
+
+    /**
+     * @brief Apply a data model delta to the node created by interpret_data().
+     *
+     * A delta is a data model binary that may also remove endpoints and update
+     * attribute values and bounds. It is generated by the serializer from two
+     * .matter files. All messages are applied while holding the Matter stack
+     * lock once, and endpoints created by the delta are enabled at the end.
+     *
+     * With CONFIG_DM_INTERPRETER_VALIDATE, a malformed delta is rejected
+     * before any message is applied. If a message fails to apply, the
+     * remaining messages are skipped and the node is left partially updated;
+     * restart to rebuild it from the stored data model.
+     *
+     * @param data Pointer to the delta binary.
+     * @param length Length of the delta binary.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if no node has been created yet,
+     *         ESP_ERR_INVALID_ARG or ESP_ERR_INVALID_SIZE if the delta is malformed,
+     *         or the error of the first failing message.
+     */
+    esp_err_t apply_delta(const uint8_t *data, size_t length);
+
+    /**
+     * @brief Register an endpoint shape that can be instantiated many times.
+     *
+     * The shape is a data model binary fragment describing one endpoint: a
+     * create endpoint message followed by the device types, clusters,
+     * attributes, commands and events of that endpoint. It is generated by the
+     * serializer with --shape-endpoint. The fragment is decoded once into a
+     * compact form, so the data buffer can be released afterwards.
+     *
+     * @param data Pointer to the shape fragment.
+     * @param length Length of the shape fragment.
+     * @param[out] shape_id Identifier to pass to instantiate().
+     * @return ESP_OK on success or ESP_ERR_INVALID_ARG if the fragment is not a single endpoint.
+     */
+    esp_err_t register_shape(const uint8_t *data, size_t length, uint16_t &shape_id);
+
+    /**
+     * @brief Create count endpoints from a registered shape, e.g. for bridged devices.
+     *
+     * Endpoints get the next free endpoint ids and are created destroyable. The
+     * whole batch is created while holding the Matter stack lock once; if the
+     * Matter stack has started, each endpoint is enabled once it is complete.
+     *
+     * @param shape_id Identifier returned by register_shape().
+     * @param count Number of endpoints to create.
+     * @param[out] endpoint_ids Optional vector the ids of the created endpoints are appended to.
+     * @return ESP_OK on success,
+     *         ESP_ERR_INVALID_STATE if no node has been created yet,
+     *         ESP_ERR_INVALID_ARG if the shape is unknown,
+     *         or the error of the first failing endpoint (endpoints created before it are kept).
+     */
+    esp_err_t instantiate(uint16_t shape_id, size_t count, std::vector<uint16_t> *endpoint_ids = nullptr);
+
+    /**
+     * @brief Be notified of every attribute created by this interpreter.
+     *
+     * The callback is called by interpret_data(), interpret_static(),
+     * apply_delta() and instantiate() once the attribute and its bounds are
+     * created, while holding the Matter stack lock. It is used to build an
+     * AttributeDispatcher, see attribute_dispatcher.hpp. Set it before
+     * creating the node.
+     *
+     * @param callback The callback, or nullptr to stop notifications.
+     * @param arg Argument passed to the callback.
+     */
+    void set_attribute_created_callback(AttributeCreatedCallback callback, void *arg);
+
+    /**
+     * @brief Be notified of every endpoint removed by apply_delta() or forget_endpoint().
+     *
+     * The callback is called before the endpoint is destroyed, while holding
+     * the Matter stack lock for apply_delta(). It lets an AttributeDispatcher
+     * drop the attributes of the endpoint, see attribute_dispatcher.hpp.
+     *
+     * @param callback The callback, or nullptr to stop notifications.
+     * @param arg Argument passed to the callback.
+     */
+    void set_endpoint_removed_callback(EndpointRemovedCallback callback, void *arg);
+
+    /**
+     * @brief Find an attribute of the node by ids, e.g. to read or update it from application code.
+     *
+     * With CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX, the handles of the attributes
+     * created by this interpreter are kept in an open-addressing hash table, so
+     * the lookup does not walk the endpoint, cluster and attribute lists of
+     * esp_matter. Attributes not in the index, e.g. created by the application,
+     * and every attribute without the option are looked up with
+     * esp_matter::attribute::get().
+     *
+     * Call it where esp_matter::attribute::get() could be called, with the
+     * Matter stack lock held once the stack has started.
+     *
+     * @return The attribute, or nullptr if it does not exist.
+     */
+    esp_matter::attribute_t *get_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const;
+
+    struct AttributeIndexStats {
+        size_t attributes;  // attributes in the index
+        size_t capacity;    // slots of the hash table
+        size_t bytes;       // heap taken by the hash table
+    };
+
+    /* Size of the attribute index, all zero without CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX. */
+    AttributeIndexStats attribute_index_stats() const;
+
+    /**
+     * @brief Drop the attributes of an endpoint from the index, before destroying it outside the interpreter.
+     *
+     * Also calls the endpoint removed callback. Endpoints removed by apply_delta() are dropped by the
+     * interpreter itself.
+     */
+    void forget_endpoint(uint16_t endpoint_id);
+
+    /**
+     * @brief Read the out-of-line payloads of the data model binary on first access, from source.
+     *
+     * The serializer moves the payloads of large attributes that are not writable, e.g. label lists,
+     * to a payload section at the end of the binary (--out-of-line-threshold). With a source,
+     * interpret_data() creates these attributes with an empty value and an override callback. The
+     * first read of one of them reads all the payloads not read yet from source in one batch, checks
+     * their CRC-32 and keeps them in the Payload usage of the allocator policy for the next reads.
+     * Without a source, they are created with their payload, like the other attributes.
+     * apply_delta() replaces the kept payload of such an attribute, without reading it, and reports
+     * the new value; a value of a type without a payload is rejected with ESP_ERR_INVALID_ARG.
+     *
+     * esp_matter::attribute::get_val() returns the empty value of these attributes. Set the source
+     * before interpret_data(); the source and the interpreter have to outlive the node.
+     *
+     * @param source The source, e.g. an ActiveDataModelPayloadSource (see payload_source.hpp), or nullptr.
+     */
+    void set_payload_source(IPayloadSource *source);
+
+    struct DeferredPayloadStats {
+        size_t attributes;      // attributes created without their payload
+        size_t loaded;          // of which the payload has been read
+        size_t deferred_bytes;  // payload bytes not read yet
+        size_t loaded_bytes;    // payload bytes read and kept
+        uint32_t failures;      // reads that failed, e.g. on a CRC mismatch
+    };
+
+    /* Attributes of the node created from interpret_data() with a deferred payload. */
+    DeferredPayloadStats deferred_payload_stats() const;
+
 private:
     // Forward declaration of the implementation.
     class Impl;
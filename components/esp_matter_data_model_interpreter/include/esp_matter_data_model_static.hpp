@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_MATTER_DATA_MODEL_STATIC_HPP
+#define ESP_MATTER_DATA_MODEL_STATIC_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esp_matter_data_model_interpreter {
+namespace static_model {
+
+/*
+ * Tables describing a data model compiled into the application.
+ *
+ * They are generated by the serializer with --header and are all constexpr, so the whole model stays in
+ * flash rodata. Interpreter::interpret_static() walks them with the same semantics as interpret_data()
+ * on the binary generated from the same .matter file.
+ */
+
+/**
+ * @brief An attribute value or bound.
+ *
+ * field is the field number of the value in the EspMatterVal message of the binary format
+ * (1 for b, 2 for i, 3 for f, ... 14 for octet_string), or 0 if no value is set.
+ */
+struct Value {
+    uint8_t field;
+    uint64_t bits;      // scalar values, sign-extended for signed fields, IEEE 754 bits for floats
+    const void *data;   // char_string (null-terminated), octet_string and array elements
+    uint32_t size;      // octet_string and array elements size in bytes
+    uint32_t count;     // array elements count
+};
+
+struct Attribute {
+    uint32_t id;
+    uint16_t flags;
+    uint8_t type;             // esp_matter_val_type_t
+    uint16_t max_val_size;    // string attributes only, 0 if not set
+    const Value *val;         // nullptr if no value is set
+    const Value *bounds_min;  // bounds are only applied if both are set
+    const Value *bounds_max;
+};
+
+struct Command {
+    uint32_t id;
+    uint32_t flags;
+};
+
+struct Cluster {
+    uint32_t id;
+    uint8_t flags;
+    const Attribute *attributes;
+    uint16_t attribute_count;
+    const Command *commands;
+    uint16_t command_count;
+    const uint32_t *events;
+    uint16_t event_count;
+};
+
+struct DeviceType {
+    uint32_t id;
+    uint8_t version;
+};
+
+struct Endpoint {
+    uint16_t id;
+    uint8_t flags;
+    const DeviceType *device_types;
+    uint16_t device_type_count;
+    const Cluster *clusters;
+    uint16_t cluster_count;
+};
+
+struct Model {
+    const Endpoint *endpoints;
+    uint16_t endpoint_count;
+};
+
+} // namespace static_model
+} // namespace esp_matter_data_model_interpreter
+
+#endif // ESP_MATTER_DATA_MODEL_STATIC_HPP
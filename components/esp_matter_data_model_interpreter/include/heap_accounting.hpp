@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef HEAP_ACCOUNTING_HPP
+#define HEAP_ACCOUNTING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace heap_accounting {
+
+/* cluster_id of the span from a create endpoint message to the first cluster: the endpoint and its device types. */
+constexpr uint32_t kEndpointOverhead = UINT32_MAX;
+
+/* Heap taken by a cluster of an endpoint, with its attributes, commands and events. */
+struct Consumer {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    int32_t bytes;
+};
+
+/* Heap taken by a cluster id over all endpoints. */
+struct ClusterTotal {
+    uint32_t cluster_id;
+    uint16_t instances;
+    int32_t bytes;
+};
+
+/**
+ * @brief Heap used by the last data model interpreted, with CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING.
+ *
+ * The interpreter reads the free size of the default heap (heap_caps) when it
+ * starts an endpoint or a cluster, and attributes the difference to the
+ * previous endpoint or cluster. The numbers include the heap allocator
+ * overhead, and are only exact if no other task allocates during the
+ * interpretation; with CONFIG_DM_INTERPRETER_PIPELINED_DECODE, the decode task
+ * does.
+ */
+struct Report {
+    size_t free_before;
+    size_t free_after;
+    size_t largest_block_before;
+    size_t largest_block_after;
+    size_t minimum_free;           // lowest free size since boot, at the end of the interpretation
+    int32_t total_bytes;           // sum of all spans
+    std::vector<Consumer> top;     // largest first, at most CONFIG_DM_INTERPRETER_HEAP_TOP_CONSUMERS
+    std::vector<ClusterTotal> clusters;  // largest first
+
+    /* Share of the free heap that is not in the largest free block, in percent. */
+    static uint8_t fragmentation(size_t free, size_t largest_block)
+    {
+        return free ? static_cast<uint8_t>(100 - largest_block * 100 / free) : 0;
+    }
+};
+
+/**
+ * @brief Get the report of the last interpretation.
+ *
+ * @return The report, or nullptr if no data model was interpreted with
+ *         CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING enabled.
+ */
+const Report *last_report();
+
+/**
+ * @brief Print the last report, as shown by the "dm heap" console command.
+ */
+void print_report();
+
+/*
+ * Collection, called by the interpreter. begin_span() closes the previous span and is ignored
+ * outside of start() and finish().
+ */
+void start();
+void begin_span(uint16_t endpoint_id, uint32_t cluster_id);
+void finish();
+
+} // namespace heap_accounting
+
+#endif // HEAP_ACCOUNTING_HPP
@@ -7,7 +7,6 @@
 #define NVS_DATA_MODEL_STORAGE_HPP
 
 #include <string>
-#include <vector>
 
 #include "data_model_storage.hpp"
 
@@ -16,8 +15,8 @@ public:
     NVSDataModelStorage();
     virtual ~NVSDataModelStorage();
 
-    virtual esp_err_t get_data_model(std::string_view key, std::vector<uint8_t> &data) override;
-    virtual esp_err_t set_data_model(std::string_view key, const std::vector<uint8_t> &data) override;
+    virtual esp_err_t get_data_model(std::string_view key, allocator_policy::Buffer &data) override;
+    virtual esp_err_t set_data_model(std::string_view key, const allocator_policy::Buffer &data) override;
     virtual esp_err_t remove_key(std::string_view key) override;
 
 private:
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef PAYLOAD_SOURCE_HPP
+#define PAYLOAD_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+#include "allocator_policy.hpp"
+#include "data_model_manager.hpp"
+
+namespace esp_matter_data_model_interpreter {
+
+/**
+ * @brief Where the Interpreter reads the out-of-line attribute payloads after the binary is released.
+ *
+ * The serializer moves large constant payloads, e.g. label lists, into a payload section at the end
+ * of the binary (--out-of-line-threshold). With a payload source, the Interpreter creates these
+ * attributes without their payload and reads it on the first access, see
+ * Interpreter::set_payload_source().
+ */
+class IPayloadSource {
+public:
+    virtual ~IPayloadSource() {}
+
+    /**
+     * @brief Bind the source to the binary a node is created from.
+     *
+     * Called by Interpreter::interpret_data() before the node is created, if the binary has a
+     * payload section, so that the later reads are made from the same binary.
+     *
+     * @param binary The data model binary.
+     * @param length Length of the binary.
+     * @return ESP_OK on success or an error code if the source cannot read this binary, in which
+     *         case no node is created.
+     */
+    virtual esp_err_t pin(const uint8_t *binary, size_t length)
+    {
+        (void)binary;
+        (void)length;
+        return ESP_OK;
+    }
+
+    /**
+     * @brief Read bytes of the data model binary the node was created from.
+     *
+     * Called by the Matter task, with the Matter stack lock held, on the first read of an attribute.
+     * The Interpreter checks the CRC-32 of every payload, so a source returning the bytes of another
+     * binary only fails the read.
+     *
+     * @param offset Offset in the binary.
+     * @param out Buffer of size bytes to fill.
+     * @param size Number of bytes to read.
+     * @return ESP_OK on success or an error code on failure.
+     */
+    virtual esp_err_t read(size_t offset, uint8_t *out, size_t size) = 0;
+
+    /**
+     * @brief Start a batch of reads, ended by end_reads().
+     *
+     * On the first access to an attribute with a deferred payload, the Interpreter reads all the
+     * payloads not read yet in one batch, so that a source can prepare once for all of them.
+     *
+     * @return ESP_OK on success or an error code on failure, in which case no read is made.
+     */
+    virtual esp_err_t begin_reads() { return ESP_OK; }
+
+    /**
+     * @brief End the batch of reads started by begin_reads().
+     */
+    virtual void end_reads() {}
+};
+
+/**
+ * @brief Payload source reading the data model a DataModelManager returned for the node.
+ *
+ * pin() keeps the blob key, size and CRC-32 of the binary last returned by get_data_model_binary()
+ * or fall_back_to_last_known_good(), and the reads are made from that blob, which stays stored
+ * after end_update() or a fallback. NVS cannot read part of a blob, so begin_reads() loads the
+ * whole binary into a buffer of the policy of the manager, which the reads of the batch copy from
+ * and end_reads() releases. A read outside of a batch loads the binary for itself.
+ */
+class ActiveDataModelPayloadSource : public IPayloadSource {
+public:
+    /* The manager has to outlive the source. */
+    explicit ActiveDataModelPayloadSource(data_model_manager::DataModelManager &manager);
+
+    esp_err_t pin(const uint8_t *binary, size_t length) override;
+    esp_err_t read(size_t offset, uint8_t *out, size_t size) override;
+    esp_err_t begin_reads() override;
+    void end_reads() override;
+
+private:
+    data_model_manager::DataModelManager &manager_;
+    data_model_manager::DataModelManager::BlobRef blob_;  // empty key until pinned
+    allocator_policy::Buffer binary_;  // the pinned data model during a batch, empty otherwise
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // PAYLOAD_SOURCE_HPP
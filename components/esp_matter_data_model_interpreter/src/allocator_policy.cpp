@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "allocator_policy.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+
+namespace allocator_policy {
+
+namespace {
+
+constexpr size_t kMaxPolicies = 8;
+
+// Policies alive, for print_counters(). Policies beyond kMaxPolicies work but are not printed.
+std::atomic<Policy *> registry[kMaxPolicies];
+
+} // namespace
+
+const char *usage_name(Usage usage)
+{
+    static const char *const names[kUsageCount] = {"binary", "update_staging", "decode_scratch", "payload"};
+    size_t index = static_cast<size_t>(usage);
+    return index < kUsageCount ? names[index] : "unknown";
+}
+
+Policy::Policy()
+{
+    for (std::atomic<Policy *> &entry : registry) {
+        Policy *expected = nullptr;
+        if (entry.compare_exchange_strong(expected, this)) {
+            break;
+        }
+    }
+}
+
+Policy::~Policy()
+{
+    for (std::atomic<Policy *> &entry : registry) {
+        Policy *expected = this;
+        if (entry.compare_exchange_strong(expected, nullptr)) {
+            break;
+        }
+    }
+}
+
+void *Policy::allocate(Usage usage, size_t size)
+{
+    AtomicCounters &counters = counters_[static_cast<size_t>(usage)];
+    void *ptr = do_allocate(usage, size);
+    if (!ptr) {
+        counters.failures.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    if (is_external(ptr)) {
+        counters.external.fetch_add(size, std::memory_order_relaxed);
+    }
+    size_t in_use = counters.in_use.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (in_use > peak && !counters.peak.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void Policy::deallocate(Usage usage, void *ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+    AtomicCounters &counters = counters_[static_cast<size_t>(usage)];
+    if (is_external(ptr)) {
+        counters.external.fetch_sub(size, std::memory_order_relaxed);
+    }
+    counters.in_use.fetch_sub(size, std::memory_order_relaxed);
+    do_deallocate(usage, ptr);
+}
+
+Counters Policy::counters(Usage usage) const
+{
+    const AtomicCounters &counters = counters_[static_cast<size_t>(usage)];
+    return {counters.in_use.load(std::memory_order_relaxed), counters.peak.load(std::memory_order_relaxed),
+            counters.external.load(std::memory_order_relaxed), counters.allocations.load(std::memory_order_relaxed),
+            counters.failures.load(std::memory_order_relaxed)};
+}
+
+void Policy::reset_peaks()
+{
+    for (AtomicCounters &counters : counters_) {
+        counters.peak.store(counters.in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void *MallocPolicy::do_allocate(Usage usage, size_t size)
+{
+    return std::malloc(size);
+}
+
+void MallocPolicy::do_deallocate(Usage usage, void *ptr)
+{
+    std::free(ptr);
+}
+
+HeapCapsPolicy::HeapCapsPolicy(uint32_t caps)
+{
+    for (uint32_t &usage_caps : caps_) {
+        usage_caps = caps;
+    }
+}
+
+void HeapCapsPolicy::set_caps(Usage usage, uint32_t caps)
+{
+    caps_[static_cast<size_t>(usage)] = caps;
+}
+
+void *HeapCapsPolicy::do_allocate(Usage usage, size_t size)
+{
+    return heap_caps_malloc_prefer(size, 2, caps_[static_cast<size_t>(usage)], MALLOC_CAP_DEFAULT);
+}
+
+void HeapCapsPolicy::do_deallocate(Usage usage, void *ptr)
+{
+    heap_caps_free(ptr);
+}
+
+bool HeapCapsPolicy::is_external(const void *ptr) const
+{
+    return esp_ptr_external_ram(ptr);
+}
+
+Policy &default_policy()
+{
+    static MallocPolicy policy;
+    return policy;
+}
+
+void print_counters()
+{
+    for (std::atomic<Policy *> &entry : registry) {
+        Policy *policy = entry.load();
+        if (!policy) {
+            continue;
+        }
+        printf("Policy %s (%p):\n  %-16s %10s %10s %10s %8s %8s\n", policy->name(), policy, "usage", "in use", "peak",
+               "external", "allocs", "failures");
+        for (size_t i = 0; i < kUsageCount; i++) {
+            Counters counters = policy->counters(static_cast<Usage>(i));
+            printf("  %-16s %10zu %10zu %10zu %8" PRIu32 " %8" PRIu32 "\n", usage_name(static_cast<Usage>(i)), counters.in_use,
+                   counters.peak, counters.external, counters.allocations, counters.failures);
+        }
+    }
+}
+
+Buffer::Buffer() noexcept : Buffer(default_policy(), Usage::Binary) {}
+
+Buffer::Buffer(Policy &policy, Usage usage) noexcept
+    : policy_(&policy), usage_(usage), data_(nullptr), size_(0), capacity_(0)
+{
+}
+
+Buffer::~Buffer()
+{
+    release();
+}
+
+Buffer::Buffer(Buffer &&other) noexcept
+    : policy_(other.policy_), usage_(other.usage_), data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+Buffer &Buffer::operator=(Buffer &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        policy_ = other.policy_;
+        usage_ = other.usage_;
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+    return *this;
+}
+
+esp_err_t Buffer::reallocate(size_t capacity)
+{
+    uint8_t *data = nullptr;
+    if (capacity != 0) {
+        data = static_cast<uint8_t *>(policy_->allocate(usage_, capacity));
+        if (!data) {
+            return ESP_ERR_NO_MEM;
+        }
+        if (size_ != 0) {
+            memcpy(data, data_, size_);
+        }
+    }
+    policy_->deallocate(usage_, data_, capacity_);
+    data_ = data;
+    capacity_ = capacity;
+    return ESP_OK;
+}
+
+esp_err_t Buffer::reserve(size_t capacity)
+{
+    return capacity <= capacity_ ? ESP_OK : reallocate(capacity);
+}
+
+esp_err_t Buffer::resize(size_t size)
+{
+    esp_err_t err = reserve(size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (size > size_) {
+        memset(data_ + size_, 0, size - size_);
+    }
+    size_ = size;
+    return ESP_OK;
+}
+
+esp_err_t Buffer::append(const uint8_t *data, size_t length)
+{
+    if (length == 0) {
+        return ESP_OK;
+    }
+    if (length > capacity_ - size_) {
+        if (length > SIZE_MAX - size_) {
+            return ESP_ERR_NO_MEM;
+        }
+        size_t capacity = capacity_ < SIZE_MAX / 2 ? capacity_ * 2 : SIZE_MAX;
+        esp_err_t err = reallocate(capacity > size_ + length ? capacity : size_ + length);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    memcpy(data_ + size_, data, length);
+    size_ += length;
+    return ESP_OK;
+}
+
+esp_err_t Buffer::assign(const uint8_t *data, size_t length)
+{
+    clear();
+    return append(data, length);
+}
+
+void Buffer::release() noexcept
+{
+    policy_->deallocate(usage_, data_, capacity_);
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+void Buffer::shrink_to_fit() noexcept
+{
+    if (size_ < capacity_) {
+        // On failure the larger block is kept, the content does not change.
+        reallocate(size_);
+    }
+}
+
+} // namespace allocator_policy
@@ -0,0 +1,332 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "attribute_coalescer.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "attribute_coalescer";
+
+using esp_matter_data_model_interpreter::AttributeDispatcher;
+
+namespace attribute_coalescer {
+
+namespace {
+
+constexpr size_t kSlotCount = CONFIG_DM_ATTRIBUTE_COALESCER_SLOTS;
+constexpr size_t kWindowCount = CONFIG_DM_ATTRIBUTE_COALESCER_WINDOWS;
+// The task cannot wait less than a tick, so updates due within the next tick go with the current batch.
+constexpr int64_t kBatchSlackUs = portTICK_PERIOD_MS * 1000;
+
+struct Window {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint32_t window_us;  // 0 for a free entry
+};
+
+/* An attribute with a queued update, or delivered within the last window. */
+struct Slot {
+    uint16_t endpoint_id;
+    bool used;
+    bool queued;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    int64_t due_us;        // when the queued update is delivered
+    int64_t delivered_us;  // last delivery, the next one is at least a window later
+    uint32_t window_us;
+    esp_matter_attr_val_t val;
+};
+
+/* An update taken out of its slot by the driver task. */
+struct Delivery {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    esp_matter_attr_val_t val;
+};
+
+AttributeDispatcher *dispatcher = nullptr;
+BatchCallback batch_callback = nullptr;
+void *batch_arg = nullptr;
+TaskHandle_t task = nullptr;
+
+// submit() runs in the Matter task, the deliveries in the driver task.
+portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+Window windows[kWindowCount];
+Slot slots[kSlotCount];
+Stats stats;
+
+bool is_scalar(esp_matter_val_type_t type)
+{
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_INVALID:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        return false;
+    default:
+        return true;
+    }
+}
+
+/* Called with the lock held. */
+uint32_t window_us_for(uint32_t cluster_id, uint32_t attribute_id)
+{
+    uint32_t cluster_window_us = 0;
+    for (const Window &window : windows) {
+        if (window.window_us == 0 || window.cluster_id != cluster_id) {
+            continue;
+        }
+        if (window.attribute_id == attribute_id) {
+            return window.window_us;
+        }
+        if (window.attribute_id == kAnyAttribute) {
+            cluster_window_us = window.window_us;
+        }
+    }
+    return cluster_window_us;
+}
+
+/* Slot of the attribute, or the slot to reuse for it: a free one, else the one delivered the longest ago. */
+Slot *find_slot(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    Slot *reuse = nullptr;
+    for (Slot &slot : slots) {
+        if (!slot.used) {
+            if (!reuse || reuse->used) {
+                reuse = &slot;
+            }
+            continue;
+        }
+        if (slot.endpoint_id == endpoint_id && slot.cluster_id == cluster_id && slot.attribute_id == attribute_id) {
+            return &slot;
+        }
+        if (!slot.queued && (!reuse || (reuse->used && slot.delivered_us < reuse->delivered_us))) {
+            reuse = &slot;
+        }
+    }
+    if (reuse) {
+        reuse->used = false;
+    }
+    return reuse;
+}
+
+/* Take the due updates, ordered by endpoint. Returns the count, and the time of the next update in next_due_us. */
+size_t take_due(Delivery *due, int64_t now, int64_t &next_due_us)
+{
+    size_t count = 0;
+    next_due_us = INT64_MAX;
+    portENTER_CRITICAL(&lock);
+    for (Slot &slot : slots) {
+        if (!slot.queued) {
+            continue;
+        }
+        if (slot.due_us > now + kBatchSlackUs) {
+            next_due_us = slot.due_us < next_due_us ? slot.due_us : next_due_us;
+            continue;
+        }
+        slot.queued = false;
+        slot.delivered_us = now;
+        // Insertion by endpoint, stable so that attributes of an endpoint keep the slot order.
+        size_t i = count++;
+        while (i > 0 && due[i - 1].endpoint_id > slot.endpoint_id) {
+            due[i] = due[i - 1];
+            i--;
+        }
+        due[i] = {slot.endpoint_id, slot.cluster_id, slot.attribute_id, slot.val};
+    }
+    portEXIT_CRITICAL(&lock);
+    return count;
+}
+
+void driver_task(void *arg)
+{
+    static Delivery due[kSlotCount];
+    TickType_t wait = portMAX_DELAY;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        int64_t next_due_us;
+        size_t count = take_due(due, esp_timer_get_time(), next_due_us);
+        uint32_t failed = 0;
+        uint32_t batches = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (dispatcher->dispatch(due[i].endpoint_id, due[i].cluster_id, due[i].attribute_id, &due[i].val) != ESP_OK) {
+                failed++;
+            }
+            if (i + 1 == count || due[i + 1].endpoint_id != due[i].endpoint_id) {
+                batches++;
+                if (batch_callback) {
+                    batch_callback(due[i].endpoint_id, batch_arg);
+                }
+            }
+        }
+
+        portENTER_CRITICAL(&lock);
+        stats.delivered += count;
+        stats.batches += batches;
+        stats.failed += failed;
+        portEXIT_CRITICAL(&lock);
+
+        if (next_due_us == INT64_MAX) {
+            wait = portMAX_DELAY;
+        } else {
+            // Round up, waking before the update is due would only loop.
+            int64_t delay_us = next_due_us - esp_timer_get_time();
+            wait = delay_us > 0 ? pdMS_TO_TICKS((delay_us + 999) / 1000) : 0;
+            wait = (delay_us > 0 && wait == 0) ? 1 : wait;
+        }
+    }
+}
+
+} // namespace
+
+esp_err_t start(AttributeDispatcher &target, BatchCallback callback, void *arg)
+{
+    if (task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    dispatcher = &target;
+    batch_callback = callback;
+    batch_arg = arg;
+    reset_stats();
+    if (xTaskCreate(driver_task, "dm_driver", CONFIG_DM_ATTRIBUTE_COALESCER_TASK_STACK_SIZE, nullptr,
+                    CONFIG_DM_ATTRIBUTE_COALESCER_TASK_PRIORITY, &task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the driver task");
+        task = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t set_window(uint32_t cluster_id, uint32_t attribute_id, uint32_t window_ms)
+{
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&lock);
+    Window *free_window = nullptr;
+    for (Window &window : windows) {
+        if (window.window_us != 0 && window.cluster_id == cluster_id && window.attribute_id == attribute_id) {
+            free_window = &window;
+            break;
+        }
+        if (window.window_us == 0 && !free_window) {
+            free_window = &window;
+        }
+    }
+    if (free_window) {
+        *free_window = {cluster_id, attribute_id, window_ms * 1000};
+        err = ESP_OK;
+    } else if (window_ms == 0) {
+        err = ESP_OK;
+    }
+    portEXIT_CRITICAL(&lock);
+    return err;
+}
+
+esp_err_t submit(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val)
+{
+    if (!task || !is_scalar(val->type)) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (!dispatcher->has_handler(endpoint_id, cluster_id, attribute_id)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    int64_t now = esp_timer_get_time();
+    bool notify = false;
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&lock);
+    uint32_t window_us = window_us_for(cluster_id, attribute_id);
+    Slot *slot = window_us ? find_slot(endpoint_id, cluster_id, attribute_id) : nullptr;
+    if (!window_us) {
+        err = ESP_ERR_NOT_SUPPORTED;
+    } else if (!slot) {
+        stats.dropped++;
+        err = ESP_ERR_NO_MEM;
+    } else if (slot->used && slot->queued) {
+        slot->val = *val;
+        stats.submitted++;
+        stats.merged++;
+    } else {
+        if (!slot->used) {
+            *slot = {endpoint_id, true, false, cluster_id, attribute_id, 0, INT64_MIN / 2, window_us, *val};
+        }
+        int64_t earliest_us = slot->delivered_us + window_us;
+        slot->val = *val;
+        slot->window_us = window_us;
+        slot->due_us = earliest_us > now ? earliest_us : now;
+        slot->queued = true;
+        stats.submitted++;
+        notify = true;
+    }
+    portEXIT_CRITICAL(&lock);
+
+    if (notify) {
+        xTaskNotifyGive(task);
+    }
+    return err;
+}
+
+void get_stats(Stats &out)
+{
+    portENTER_CRITICAL(&lock);
+    out = stats;
+    portEXIT_CRITICAL(&lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&lock);
+    stats = {};
+    portEXIT_CRITICAL(&lock);
+}
+
+void print_stats()
+{
+    if (!task) {
+        printf("Attribute coalescer not started\n");
+        return;
+    }
+    Stats current;
+    get_stats(current);
+    printf("Attribute updates: %" PRIu32 " submitted, %" PRIu32 " merged, %" PRIu32 " dropped\n", current.submitted,
+           current.merged, current.dropped);
+    printf("Delivered: %" PRIu32 " updates in %" PRIu32 " endpoint batches, %" PRIu32 " failed\n", current.delivered,
+           current.batches, current.failed);
+    if (current.submitted) {
+        printf("Coalesced: %" PRIu32 "%% of the submitted updates\n",
+               static_cast<uint32_t>(static_cast<uint64_t>(current.merged) * 100 / current.submitted));
+    }
+
+    Window copy[kWindowCount];
+    portENTER_CRITICAL(&lock);
+    for (size_t i = 0; i < kWindowCount; i++) {
+        copy[i] = windows[i];
+    }
+    portEXIT_CRITICAL(&lock);
+    printf("  %-10s %-10s %10s\n", "cluster", "attribute", "window ms");
+    for (const Window &window : copy) {
+        if (window.window_us == 0) {
+            continue;
+        }
+        if (window.attribute_id == kAnyAttribute) {
+            printf("  0x%08" PRIx32 " %-10s %10" PRIu32 "\n", window.cluster_id, "any", window.window_us / 1000);
+        } else {
+            printf("  0x%08" PRIx32 " 0x%08" PRIx32 " %10" PRIu32 "\n", window.cluster_id, window.attribute_id,
+                   window.window_us / 1000);
+        }
+    }
+}
+
+} // namespace attribute_coalescer
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "attribute_dispatcher.hpp"
+
+#include <cinttypes>
+
+#include "esp_log.h"
+
+static const char *TAG = "attribute_dispatcher";
+
+namespace esp_matter_data_model_interpreter {
+
+namespace {
+
+constexpr uint8_t kMaxHandlers = UINT8_MAX;
+
+class ScopedLock {
+public:
+    explicit ScopedLock(SemaphoreHandle_t lock) : lock_(lock) { xSemaphoreTake(lock_, portMAX_DELAY); }
+    ~ScopedLock() { xSemaphoreGive(lock_); }
+    ScopedLock(const ScopedLock &) = delete;
+    ScopedLock &operator=(const ScopedLock &) = delete;
+
+private:
+    SemaphoreHandle_t lock_;
+};
+
+} // namespace
+
+AttributeDispatcher::AttributeDispatcher()
+    : resolver_(nullptr), resolver_arg_(nullptr), lock_(xSemaphoreCreateMutexStatic(&lock_buffer_))
+{
+}
+
+AttributeDispatcher::~AttributeDispatcher()
+{
+    vSemaphoreDelete(lock_);
+}
+
+esp_err_t AttributeDispatcher::register_cluster_handler(uint32_t cluster_id, Handler handler, void *context)
+{
+    ScopedLock lock(lock_);
+    if (table_.size() != 0) {
+        // The handler index of the entries added so far would not match.
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (ClusterHandler &entry : handlers_) {
+        if (entry.cluster_id == cluster_id) {
+            entry.handler = handler;
+            entry.context = context;
+            return ESP_OK;
+        }
+    }
+    if (handlers_.size() == kMaxHandlers) {
+        return ESP_ERR_NO_MEM;
+    }
+    handlers_.push_back({cluster_id, handler, context});
+    return ESP_OK;
+}
+
+void AttributeDispatcher::set_context_resolver(ContextResolver resolver, void *arg)
+{
+    ScopedLock lock(lock_);
+    resolver_ = resolver;
+    resolver_arg_ = arg;
+}
+
+esp_err_t AttributeDispatcher::add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    ScopedLock lock(lock_);
+    size_t index = 0;
+    while (index < handlers_.size() && handlers_[index].cluster_id != cluster_id) {
+        index++;
+    }
+    if (index == handlers_.size()) {
+        return ESP_OK;
+    }
+
+    // Added again with the current handler and context, e.g. by a delta after the endpoint was removed.
+    Target *target = table_.insert(endpoint_id, cluster_id, attribute_id);
+    if (!target) {
+        ESP_LOGE(TAG, "Failed to grow the table to add attribute 0x%04" PRIx32 " of cluster 0x%04" PRIx32,
+                 attribute_id, cluster_id);
+        return ESP_ERR_NO_MEM;
+    }
+    target->handler = static_cast<uint8_t>(index);
+    target->context = resolver_ ? resolver_(endpoint_id, cluster_id, resolver_arg_) : handlers_[index].context;
+    return ESP_OK;
+}
+
+void AttributeDispatcher::remove_endpoint(uint16_t endpoint_id)
+{
+    ScopedLock lock(lock_);
+    table_.remove_endpoint(endpoint_id);
+}
+
+void AttributeDispatcher::clear()
+{
+    ScopedLock lock(lock_);
+    table_.clear();
+}
+
+esp_err_t AttributeDispatcher::dispatch(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                        esp_matter_attr_val_t *val) const
+{
+    Handler handler;
+    void *context;
+    {
+        // The table may grow on another task once the lock is released, so the entry is copied.
+        ScopedLock lock(lock_);
+        const Target *target = table_.find(endpoint_id, cluster_id, attribute_id);
+        if (!target) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        handler = handlers_[target->handler].handler;
+        context = target->context;
+    }
+    return handler(context, endpoint_id, cluster_id, attribute_id, val);
+}
+
+bool AttributeDispatcher::has_handler(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+{
+    ScopedLock lock(lock_);
+    return table_.find(endpoint_id, cluster_id, attribute_id) != nullptr;
+}
+
+size_t AttributeDispatcher::size() const
+{
+    ScopedLock lock(lock_);
+    return table_.size();
+}
+
+void AttributeDispatcher::on_attribute_created(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                               void *arg)
+{
+    static_cast<AttributeDispatcher *>(arg)->add(endpoint_id, cluster_id, attribute_id);
+}
+
+void AttributeDispatcher::on_endpoint_removed(uint16_t endpoint_id, void *arg)
+{
+    static_cast<AttributeDispatcher *>(arg)->remove_endpoint(endpoint_id);
+}
+
+} // namespace esp_matter_data_model_interpreter
@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "boot_profiler.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+namespace boot_profiler {
+
+namespace {
+
+constexpr size_t kPhaseCount = static_cast<size_t>(Phase::Count);
+
+#if CONFIG_DM_BOOT_PROFILER
+
+const char *reset_reason_name(uint8_t reason)
+{
+    switch (reason) {
+    case ESP_RST_POWERON:
+        return "power-on";
+    case ESP_RST_EXT:
+        return "external";
+    case ESP_RST_SW:
+        return "software";
+    case ESP_RST_PANIC:
+        return "panic";
+    case ESP_RST_INT_WDT:
+        return "interrupt watchdog";
+    case ESP_RST_TASK_WDT:
+        return "task watchdog";
+    case ESP_RST_WDT:
+        return "watchdog";
+    case ESP_RST_DEEPSLEEP:
+        return "deep sleep";
+    case ESP_RST_BROWNOUT:
+        return "brownout";
+    case ESP_RST_UNKNOWN:
+        return "unknown";
+    default:
+        return "other";
+    }
+}
+
+constexpr uint32_t kHistoryMagic = 0x444d4250;  // "DMBP"
+constexpr size_t kHistorySize = CONFIG_DM_BOOT_PROFILER_HISTORY;
+
+/* Ring of the last boots, kept across resets. */
+struct History {
+    uint32_t magic;
+    uint32_t size;   // sizeof(History), changes with CONFIG_DM_BOOT_PROFILER_HISTORY
+    uint32_t next;   // slot of the next boot
+    uint32_t count;  // number of valid records
+    BootRecord records[kHistorySize];
+};
+
+RTC_NOINIT_ATTR History history;
+
+BootRecord *current = nullptr;
+// Start of the phases in progress, 0 if not in progress.
+uint32_t phase_begin_us[kPhaseCount];
+// mark() is called from the Matter event task, begin() and end() from the main task.
+portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t now_us()
+{
+    return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+#endif // CONFIG_DM_BOOT_PROFILER
+
+} // namespace
+
+const char *phase_name(Phase phase)
+{
+    static const char *const names[kPhaseCount] = {
+        "nvs_init", "storage_open", "blob_read", "promotion", "interpretation", "matter_start", "first_advertisement",
+    };
+    size_t index = static_cast<size_t>(phase);
+    return index < kPhaseCount ? names[index] : "unknown";
+}
+
+#if CONFIG_DM_BOOT_PROFILER
+
+void init()
+{
+    if (current) {
+        return;
+    }
+    if (history.magic != kHistoryMagic || history.size != sizeof(History) || history.next >= kHistorySize ||
+        history.count > kHistorySize) {
+        // Power-on, or the layout changed with the configuration.
+        memset(&history, 0, sizeof(history));
+        history.magic = kHistoryMagic;
+        history.size = sizeof(History);
+    }
+
+    uint32_t boot_number = 1;
+    if (history.count > 0) {
+        boot_number = history.records[(history.next + kHistorySize - 1) % kHistorySize].boot_number + 1;
+    }
+    current = &history.records[history.next];
+    memset(current, 0, sizeof(*current));
+    current->boot_number = boot_number;
+    current->reset_reason = static_cast<uint8_t>(esp_reset_reason());
+    history.next = (history.next + 1) % kHistorySize;
+    if (history.count < kHistorySize) {
+        history.count++;
+    }
+}
+
+void begin(Phase phase)
+{
+    size_t index = static_cast<size_t>(phase);
+    if (!current || index >= kPhaseCount) {
+        return;
+    }
+    uint32_t now = now_us();
+    portENTER_CRITICAL(&lock);
+    phase_begin_us[index] = now;
+    if (current->start_us[index] == 0) {
+        current->start_us[index] = now;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void end(Phase phase)
+{
+    size_t index = static_cast<size_t>(phase);
+    if (!current || index >= kPhaseCount) {
+        return;
+    }
+    uint32_t now = now_us();
+    portENTER_CRITICAL(&lock);
+    if (phase_begin_us[index] != 0) {
+        current->duration_us[index] += now - phase_begin_us[index];
+        phase_begin_us[index] = 0;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void mark(Phase phase)
+{
+    size_t index = static_cast<size_t>(phase);
+    if (!current || index >= kPhaseCount) {
+        return;
+    }
+    uint32_t now = now_us();
+    portENTER_CRITICAL(&lock);
+    if (current->start_us[index] == 0) {
+        current->start_us[index] = now;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+esp_err_t get_record(size_t age, BootRecord &record)
+{
+    if (!current || age >= history.count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    portENTER_CRITICAL(&lock);
+    record = history.records[(history.next + 2 * kHistorySize - 1 - age) % kHistorySize];
+    portEXIT_CRITICAL(&lock);
+    return ESP_OK;
+}
+
+void print_history()
+{
+    BootRecord record;
+    for (size_t age = 0; get_record(age, record) == ESP_OK; age++) {
+        printf("Boot %" PRIu32 "%s (reset: %s)\n", record.boot_number, age == 0 ? ", current" : "",
+               reset_reason_name(record.reset_reason));
+        printf("  %-20s %12s %12s\n", "phase", "start ms", "duration ms");
+        for (size_t i = 0; i < kPhaseCount; i++) {
+            const char *name = phase_name(static_cast<Phase>(i));
+            if (record.start_us[i] == 0) {
+                printf("  %-20s %12s %12s\n", name, "-", "-");
+                continue;
+            }
+            printf("  %-20s %8" PRIu32 ".%03" PRIu32 " %8" PRIu32 ".%03" PRIu32 "\n", name, record.start_us[i] / 1000,
+                   record.start_us[i] % 1000, record.duration_us[i] / 1000, record.duration_us[i] % 1000);
+        }
+    }
+}
+
+#else // CONFIG_DM_BOOT_PROFILER
+
+void init() {}
+
+void begin(Phase phase) {}
+
+void end(Phase phase) {}
+
+void mark(Phase phase) {}
+
+esp_err_t get_record(size_t age, BootRecord &record)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void print_history()
+{
+    printf("Boot profiler disabled, enable CONFIG_DM_BOOT_PROFILER\n");
+}
+
+#endif // CONFIG_DM_BOOT_PROFILER
+
+} // namespace boot_profiler
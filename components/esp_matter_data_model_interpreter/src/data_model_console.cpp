@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "data_model_console.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "sdkconfig.h"
+#if CONFIG_ENABLE_CHIP_SHELL
+#include "esp_matter_console.h"
+#endif
+
+#include "allocator_policy.hpp"
+#include "attribute_coalescer.hpp"
+#include "boot_profiler.hpp"
+#include "heap_accounting.hpp"
+
+namespace esp_matter_data_model_interpreter {
+namespace console {
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+namespace {
+
+esp_matter::console::engine dm_console;
+
+esp_err_t print_description(const esp_matter::console::command_t *command, void *arg)
+{
+    printf("\t%s: %s\n", command->name, command->description);
+    return ESP_OK;
+}
+
+esp_err_t dm_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        dm_console.for_each_command(print_description, nullptr);
+        return ESP_OK;
+    }
+    return dm_console.exec_command(argc, argv);
+}
+
+esp_err_t boot_handler(int argc, char **argv)
+{
+    boot_profiler::print_history();
+    return ESP_OK;
+}
+
+esp_err_t heap_handler(int argc, char **argv)
+{
+    heap_accounting::print_report();
+    return ESP_OK;
+}
+
+esp_err_t coalesce_handler(int argc, char **argv)
+{
+    attribute_coalescer::print_stats();
+    if (argc > 0 && strcmp(argv[0], "reset") == 0) {
+        attribute_coalescer::reset_stats();
+    }
+    return ESP_OK;
+}
+
+esp_err_t alloc_handler(int argc, char **argv)
+{
+    allocator_policy::print_counters();
+    return ESP_OK;
+}
+
+} // namespace
+
+esp_err_t register_commands()
+{
+    static const esp_matter::console::command_t command = {
+        .name = "dm",
+        .description = "Data model interpreter commands. Usage: matter esp dm <command>.",
+        .handler = dm_dispatch,
+    };
+
+    static const esp_matter::console::command_t dm_commands[] = {
+        {
+            .name = "boot",
+            .description = "Timing of the boot phases of the last boots, most recent first. Usage: matter esp dm boot.",
+            .handler = boot_handler,
+        },
+        {
+            .name = "heap",
+            .description = "Heap taken by the endpoints and clusters of the data model, top consumers first. "
+                           "Usage: matter esp dm heap.",
+            .handler = heap_handler,
+        },
+        {
+            .name = "coalesce",
+            .description = "Counters of the attribute update coalescer, \"reset\" clears them after printing. "
+                           "Usage: matter esp dm coalesce [reset].",
+            .handler = coalesce_handler,
+        },
+        {
+            .name = "alloc",
+            .description = "Memory of the data model buffers per allocator policy and usage, and how much is in PSRAM. "
+                           "Usage: matter esp dm alloc.",
+            .handler = alloc_handler,
+        },
+    };
+
+    dm_console.register_commands(dm_commands, sizeof(dm_commands) / sizeof(dm_commands[0]));
+    return esp_matter::console::add_commands(&command, 1);
+}
+
+#else // CONFIG_ENABLE_CHIP_SHELL
+
+esp_err_t register_commands()
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+} // namespace console
+} // namespace esp_matter_data_model_interpreter
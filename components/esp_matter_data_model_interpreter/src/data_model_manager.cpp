@@ -4,70 +4,684 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "data_model_manager.hpp"
+#include "boot_profiler.hpp"
 #include "data_model_storage.hpp"
 #include "esp_log.h"
 #include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "nvs_flash.h"
+#include <cinttypes>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 
 static const char *TAG = "DataModelManager";
 
 namespace data_model_manager {
 
-DataModelManager::DataModelManager(IDataModelStorage &storage)
-    : storage_(storage)
+namespace {
+
+constexpr uint8_t kSlotStateVersion = 2;
+constexpr uint8_t kSlotCount = 2;
+// Number of boots a pending data model may go through without being confirmed.
+constexpr uint8_t kMaxUnconfirmedBoots = 1;
+// NVS keys are limited to 15 characters.
+constexpr size_t kBlobKeySize = 16;
+// Blob keys a partition may write to. Slot 0 of a fresh device uses "<label>_dm".
+constexpr const char *kBlobKeySuffixes[] = {"_dm", "_dm1", "_dm2"};
+// Partition whose data model a partition without one falls back to, e.g. after a firmware OTA.
+constexpr const char *kFallbackLabel = "ota_0";
+
+/* Slot state record, stored as a blob under "<label>_dms". */
+struct SlotState {
+    uint8_t version;
+    uint8_t active;
+    uint8_t pending;
+    uint8_t boot_attempts;
+    uint32_t size[kSlotCount];  // 0 if the slot content has not been verified
+    uint32_t crc32[kSlotCount];
+    char blob_key[kSlotCount][kBlobKeySize];  // empty if the slot was never written
+};
+
+/* Version 1 of the record, without the blob keys: slot 0 used "<label>_dm" and slot 1 "<label>_dm1". */
+struct SlotStateV1 {
+    uint8_t version;
+    uint8_t active;
+    uint8_t pending;
+    uint8_t boot_attempts;
+    uint32_t size[kSlotCount];
+    uint32_t crc32[kSlotCount];
+};
+
+void make_key(char *key, size_t key_size, const char *label, const char *suffix)
+{
+    snprintf(key, key_size, "%s%s", label, suffix);
+}
+
+const char *get_running_partition_label()
+{
+    const esp_partition_t *running_partition = esp_ota_get_running_partition();
+    return running_partition ? running_partition->label : nullptr;
+}
+
+void init_slot_state(const char *label, SlotState &state)
+{
+    memset(&state, 0, sizeof(state));
+    state.version = kSlotStateVersion;
+    // Without a record, slot 0 is the historical "<label>_dm" blob, active and confirmed.
+    make_key(state.blob_key[0], sizeof(state.blob_key[0]), label, kBlobKeySuffixes[0]);
+}
+
+/* Returns ESP_ERR_NVS_NOT_FOUND, with state set to the defaults, if no record is stored. */
+esp_err_t read_slot_state(IDataModelStorage &storage, const char *label, SlotState &state)
+{
+    char key[32] = {0};
+    make_key(key, sizeof(key), label, "_dms");
+    init_slot_state(label, state);
+
+    allocator_policy::Buffer record;
+    esp_err_t err = storage.get_data_model(key, record);
+    if (err == ESP_ERR_NVS_NOT_FOUND || (err == ESP_OK && record.empty())) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    } else if (err != ESP_OK) {
+        return err;
+    }
+
+    if (record.data()[0] == 1 && record.size() == sizeof(SlotStateV1)) {
+        // Migrated in memory, and written as version 2 with the next change of the slot state.
+        SlotStateV1 v1;
+        memcpy(&v1, record.data(), sizeof(v1));
+        if (v1.active >= kSlotCount) {
+            ESP_LOGE(TAG, "Slot state record '%s' is corrupt", key);
+            return ESP_ERR_INVALID_STATE;
+        }
+        state.active = v1.active;
+        state.pending = v1.pending;
+        state.boot_attempts = v1.boot_attempts;
+        for (uint8_t slot = 0; slot < kSlotCount; slot++) {
+            state.size[slot] = v1.size[slot];
+            state.crc32[slot] = v1.crc32[slot];
+        }
+        // Slot 1 was only written by an update, which records its size.
+        if (v1.size[1] != 0) {
+            make_key(state.blob_key[1], sizeof(state.blob_key[1]), label, kBlobKeySuffixes[1]);
+        }
+        ESP_LOGI(TAG, "Slot state record '%s' migrated from version 1", key);
+        return ESP_OK;
+    }
+
+    SlotState stored;
+    if (record.size() != sizeof(stored)) {
+        ESP_LOGE(TAG, "Slot state record '%s' has unexpected size %zu", key, record.size());
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(&stored, record.data(), sizeof(stored));
+    if (stored.version != kSlotStateVersion || stored.active >= kSlotCount) {
+        ESP_LOGE(TAG, "Slot state record '%s' is not supported (version %u)", key, stored.version);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    for (uint8_t slot = 0; slot < kSlotCount; slot++) {
+        stored.blob_key[slot][kBlobKeySize - 1] = '\0';
+    }
+    state = stored;
+    return ESP_OK;
+}
+
+esp_err_t write_slot_state(IDataModelStorage &storage, const char *label, const SlotState &state)
+{
+    char key[32] = {0};
+    make_key(key, sizeof(key), label, "_dms");
+
+    allocator_policy::Buffer record;
+    esp_err_t err = record.assign(reinterpret_cast<const uint8_t *>(&state), sizeof(state));
+    if (err != ESP_OK) {
+        return err;
+    }
+    return storage.set_data_model(key, record);
+}
+
+/*
+ * Calls func(label, state) for the slot state of every app partition. The running
+ * partition is reported with the caller's in-memory state instead of the stored one.
+ */
+template <typename Func>
+void for_each_slot_state(IDataModelStorage &storage, const char *label, const SlotState &state, Func func)
+{
+    func(label, state);
+
+    esp_partition_iterator_t it = esp_partition_find(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_ANY, nullptr);
+    for (; it != nullptr; it = esp_partition_next(it)) {
+        const esp_partition_t *partition = esp_partition_get(it);
+        if (strcmp(partition->label, label) == 0) {
+            continue;
+        }
+        SlotState other;
+        esp_err_t err = read_slot_state(storage, partition->label, other);
+        if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+            continue;
+        }
+        func(partition->label, other);
+    }
+    esp_partition_iterator_release(it);
+}
+
+/* Check whether any slot of any app partition, other than skip_slot of the running one, uses key. */
+bool is_blob_referenced(IDataModelStorage &storage, const char *key, const char *label, const SlotState &state,
+                        int skip_slot)
+{
+    bool referenced = false;
+    for_each_slot_state(storage, label, state, [&](const char *owner, const SlotState &owner_state) {
+        for (uint8_t slot = 0; slot < kSlotCount; slot++) {
+            if (slot == skip_slot && strcmp(owner, label) == 0) {
+                continue;
+            }
+            if (strcmp(owner_state.blob_key[slot], key) == 0) {
+                referenced = true;
+            }
+        }
+    });
+    return referenced;
+}
+
+/* Look for an already stored blob with the same content as data. */
+bool find_shared_blob(IDataModelStorage &storage, const char *label, const SlotState &state,
+                      const allocator_policy::Buffer &data, uint32_t crc32, char *key, size_t key_size)
+{
+    bool found = false;
+    for_each_slot_state(storage, label, state, [&](const char *owner, const SlotState &owner_state) {
+        for (uint8_t slot = 0; slot < kSlotCount && !found; slot++) {
+            if (owner_state.blob_key[slot][0] == '\0' || owner_state.size[slot] != data.size() ||
+                owner_state.crc32[slot] != crc32) {
+                continue;
+            }
+            // Size and CRC match, compare the content before sharing the blob.
+            allocator_policy::Buffer candidate(data.policy(), allocator_policy::Usage::Binary);
+            if (storage.get_data_model(owner_state.blob_key[slot], candidate) == ESP_OK &&
+                candidate.size() == data.size() && memcmp(candidate.data(), data.data(), data.size()) == 0) {
+                snprintf(key, key_size, "%s", owner_state.blob_key[slot]);
+                found = true;
+            }
+        }
+    });
+    return found;
+}
+
+esp_err_t load_slot(IDataModelStorage &storage, const SlotState &state, uint8_t slot, allocator_policy::Buffer &data)
+{
+    const char *key = state.blob_key[slot];
+    if (key[0] == '\0') {
+        data.clear();
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    ESP_LOGD(TAG, "Looking for key: '%s'", key);
+
+    esp_err_t err = storage.get_data_model(key, data);
+    if (err != ESP_OK || data.empty()) {
+        data.clear();
+        return err != ESP_OK ? err : ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    if (state.size[slot] != 0) {
+        uint32_t crc32 = esp_rom_crc32_le(0, data.data(), data.size());
+        if (data.size() != state.size[slot] || crc32 != state.crc32[slot]) {
+            ESP_LOGE(TAG, "Data model in '%s' failed verification (size %zu, crc 0x%08" PRIx32 ")", key, data.size(),
+                     crc32);
+            data.clear();
+            return ESP_ERR_INVALID_CRC;
+        }
+    }
+    return ESP_OK;
+}
+
+/*
+ * Load the data model a partition without a record falls back to, and point slot 0 of state at
+ * it. An update applied on the fallback partition moves its data model off "ota_0_dm", so the
+ * blob is found through the record of that partition, and "ota_0_dm" is used without a record.
+ */
+esp_err_t load_fallback(IDataModelStorage &storage, SlotState &state, allocator_policy::Buffer &data)
+{
+    SlotState fallback;
+    esp_err_t err = read_slot_state(storage, kFallbackLabel, fallback);
+    if (err == ESP_OK) {
+        // A pending data model of the fallback partition was never confirmed, take the one before.
+        uint8_t slot = fallback.active;
+        if (fallback.pending && fallback.blob_key[slot ^ 1][0] != '\0') {
+            slot ^= 1;
+        }
+        err = load_slot(storage, fallback, slot, data);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to load the data model of partition '%s' from '%s' (%d)", kFallbackLabel,
+                     fallback.blob_key[slot], err);
+            return err;
+        }
+        memcpy(state.blob_key[0], fallback.blob_key[slot], sizeof(state.blob_key[0]));
+    } else {
+        if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGW(TAG, "Failed to read the slot state of partition '%s' (%d)", kFallbackLabel, err);
+        }
+        // init_slot_state() already points slot 0 at "<label>_dm".
+        err = load_slot(storage, fallback, 0, data);
+        if (err != ESP_OK) {
+            return err;
+        }
+        memcpy(state.blob_key[0], fallback.blob_key[0], sizeof(state.blob_key[0]));
+    }
+    state.size[0] = data.size();
+    state.crc32[0] = esp_rom_crc32_le(0, data.data(), data.size());
+    return ESP_OK;
+}
+
+void roll_back(SlotState &state)
+{
+    ESP_LOGW(TAG, "Data model in slot %u was not confirmed; rolling back to slot %u", state.active,
+             state.active ^ 1);
+    state.active ^= 1;
+    state.pending = 0;
+    state.boot_attempts = 0;
+}
+
+} // namespace
+
+static_assert(sizeof(DataModelManager::BlobRef::key) == kBlobKeySize, "BlobRef keys are NVS keys");
+
+DataModelManager::DataModelManager(IDataModelStorage &storage, allocator_policy::Policy &policy)
+    : storage_(storage), policy_(policy), loaded_(),
+      update_buffer_(policy, allocator_policy::Usage::UpdateStaging), update_size_(0), update_crc32_(0), update_running_crc32_(0), update_in_progress_(false)
 {
 }
 
 DataModelManager::~DataModelManager() { }
 
-std::vector<uint8_t> DataModelManager::get_data_model_binary(size_t &data_model_binary_size)
+allocator_policy::Buffer DataModelManager::get_data_model_binary(size_t &data_model_binary_size)
 {
     esp_err_t err;
-    std::vector<uint8_t> data_model_binary;
+    allocator_policy::Buffer data_model_binary(policy_, allocator_policy::Usage::Binary);
 
     // Retrieve the running partition info using the OTA API.
-    const esp_partition_t *running_partition = esp_ota_get_running_partition();
-    if (!running_partition) {
+    const char *label = get_running_partition_label();
+    if (!label) {
         ESP_LOGE(TAG, "Failed to get running partition");
         data_model_binary_size = 0;
-        return data_model_binary;  // Return empty vector on error.
+        return data_model_binary;  // Return empty buffer on error.
     }
 
-    // Construct the key using the partition label (e.g., "ota_0_dm" if partition label is "ota_0").
-    char key[32] = {0};
-    snprintf(key, sizeof(key), "%s_dm", running_partition->label);
-    ESP_LOGD(TAG, "Looking for key: '%s'", key);
+    SlotState state;
+    boot_profiler::begin(boot_profiler::Phase::BlobRead);
+    err = read_slot_state(storage_, label, state);
+    boot_profiler::end(boot_profiler::Phase::BlobRead);
+    bool has_record = (err == ESP_OK);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGW(TAG, "Failed to read slot state (%d); using slot 0", err);
+        init_slot_state(label, state);
+    }
 
-    // Attempt to retrieve the binary blob using the constructed key.
-    err = storage_.get_data_model(key, data_model_binary);
-    if (err != ESP_OK || data_model_binary.empty()) {
-        ESP_LOGW(TAG, "Key '%s' not found; trying fallback key 'ota_0_dm'", key);
-        data_model_binary.clear();
-        err = storage_.get_data_model("ota_0_dm", data_model_binary);
-        if (err != ESP_OK || data_model_binary.empty()) {
-            ESP_LOGE(TAG, "Fallback key 'ota_0_dm' not found");
-            data_model_binary.clear();
-            data_model_binary_size = 0;
-            return data_model_binary;
+    // A pending data model gets one boot to be confirmed, otherwise the previous slot is restored.
+    if (state.pending) {
+        boot_profiler::ScopedPhase promotion(boot_profiler::Phase::Promotion);
+        if (state.boot_attempts >= kMaxUnconfirmedBoots) {
+            roll_back(state);
+        } else {
+            state.boot_attempts++;
+        }
+        err = write_slot_state(storage_, label, state);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to write slot state (%d)", err);
+        }
+    }
+
+    boot_profiler::begin(boot_profiler::Phase::BlobRead);
+    err = load_slot(storage_, state, state.active, data_model_binary);
+    boot_profiler::end(boot_profiler::Phase::BlobRead);
+    if (err != ESP_OK && state.pending) {
+        // The freshly activated slot is unusable, there is no point in waiting for a reboot.
+        boot_profiler::begin(boot_profiler::Phase::Promotion);
+        roll_back(state);
+        if (write_slot_state(storage_, label, state) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to write slot state after rollback");
         }
-        // Promote 'ota_0_dm' data model to current partition's key.
-        err = storage_.set_data_model(key, data_model_binary);
+        boot_profiler::end(boot_profiler::Phase::Promotion);
+        boot_profiler::begin(boot_profiler::Phase::BlobRead);
+        err = load_slot(storage_, state, state.active, data_model_binary);
+        boot_profiler::end(boot_profiler::Phase::BlobRead);
+    }
+
+    if (err != ESP_OK && !has_record && strcmp(label, kFallbackLabel) != 0) {
+        ESP_LOGW(TAG, "Key '%s' not found; falling back to the data model of partition '%s'", state.blob_key[0],
+                 kFallbackLabel);
+        boot_profiler::begin(boot_profiler::Phase::BlobRead);
+        err = load_fallback(storage_, state, data_model_binary);
+        boot_profiler::end(boot_profiler::Phase::BlobRead);
         if (err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to write data model binary blob to new key '%s'", key);
+            ESP_LOGE(TAG, "No fallback data model found");
             data_model_binary.clear();
             data_model_binary_size = 0;
             return data_model_binary;
         }
-        // Remove stale 'ota_0_dm' data model.
-        err = storage_.remove_key("ota_0_dm");
+        // Promote the fallback by pointing slot 0 of the running partition at it, the blob is not copied.
+        boot_profiler::ScopedPhase promotion(boot_profiler::Phase::Promotion);
+        err = write_slot_state(storage_, label, state);
         if (err != ESP_OK) {
-            ESP_LOGW(TAG, "Failed to erase fallback key 'ota_0_dm'");
+            // Not fatal, the fallback is taken again on the next boot.
+            ESP_LOGW(TAG, "Failed to record fallback key '%s' for partition '%s'", state.blob_key[0], label);
+        } else {
+            ESP_LOGI(TAG, "Partition '%s' now uses data model '%s'", label, state.blob_key[0]);
         }
-        ESP_LOGI(TAG, "Successfully renamed fallback key to '%s'", key);
+    } else if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to load data model from slot %u (%d)", state.active, err);
+        data_model_binary.clear();
+        data_model_binary_size = 0;
+        return data_model_binary;
     }
+    set_loaded_blob(state.blob_key[state.active], data_model_binary, state.size[state.active], state.crc32[state.active]);
     data_model_binary_size = data_model_binary.size();
     return data_model_binary;
 }
 
+esp_err_t DataModelManager::get_active_data_model(allocator_policy::Buffer &data)
+{
+    const char *label = get_running_partition_label();
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        return ESP_FAIL;
+    }
+
+    SlotState state;
+    esp_err_t err = read_slot_state(storage_, label, state);
+    bool has_record = (err == ESP_OK);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    err = load_slot(storage_, state, state.active, data);
+    if (err == ESP_ERR_NVS_NOT_FOUND && !has_record && strcmp(label, kFallbackLabel) != 0) {
+        // Not promoted yet, the running partition still uses the fallback data model.
+        err = load_fallback(storage_, state, data);
+    }
+    return err;
+}
+
+esp_err_t DataModelManager::begin_update(size_t size, uint32_t crc32)
+{
+    if (size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (update_in_progress_) {
+        ESP_LOGE(TAG, "A data model update is already in progress");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const char *label = get_running_partition_label();
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        return ESP_FAIL;
+    }
+
+    SlotState state;
+    esp_err_t err = read_slot_state(storage_, label, state);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+    // The inactive slot holds the only known-good data model until the active one is confirmed.
+    if (state.pending) {
+        ESP_LOGE(TAG, "The active data model has not been confirmed yet");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    update_buffer_.release();
+    if (update_buffer_.reserve(size) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to allocate %zu bytes for the data model update", size);
+        return ESP_ERR_NO_MEM;
+    }
+
+    update_size_ = size;
+    update_crc32_ = crc32;
+    update_running_crc32_ = 0;
+    update_in_progress_ = true;
+    ESP_LOGI(TAG, "Data model update started: %zu bytes into slot %u", size, state.active ^ 1);
+    return ESP_OK;
+}
+
+esp_err_t DataModelManager::write_update(const uint8_t *data, size_t length)
+{
+    if (!update_in_progress_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (length == 0) {
+        return ESP_OK;
+    }
+    if (!data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (length > update_size_ - update_buffer_.size()) {
+        ESP_LOGE(TAG, "Data model update overflows the announced size of %zu bytes", update_size_);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    esp_err_t err = update_buffer_.append(data, length);
+    if (err != ESP_OK) {
+        return err;
+    }
+    update_running_crc32_ = esp_rom_crc32_le(update_running_crc32_, data, length);
+    return ESP_OK;
+}
+
+esp_err_t DataModelManager::end_update()
+{
+    if (!update_in_progress_) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t err = ESP_OK;
+    const char *label = get_running_partition_label();
+    SlotState state;
+    uint8_t target_slot;
+    char key[kBlobKeySize] = {0};
+    char old_key[kBlobKeySize] = {0};
+
+    if (update_buffer_.size() != update_size_) {
+        ESP_LOGE(TAG, "Data model update is incomplete: %zu of %zu bytes", update_buffer_.size(), update_size_);
+        err = ESP_ERR_INVALID_SIZE;
+        goto cleanup;
+    }
+    if (update_running_crc32_ != update_crc32_) {
+        ESP_LOGE(TAG, "Data model update CRC mismatch: expected 0x%08" PRIx32 ", got 0x%08" PRIx32, update_crc32_,
+                 update_running_crc32_);
+        err = ESP_ERR_INVALID_CRC;
+        goto cleanup;
+    }
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        err = ESP_FAIL;
+        goto cleanup;
+    }
+
+    err = read_slot_state(storage_, label, state);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        goto cleanup;
+    }
+
+    target_slot = state.active ^ 1;
+    memcpy(old_key, state.blob_key[target_slot], sizeof(old_key));
+
+    if (find_shared_blob(storage_, label, state, update_buffer_, update_crc32_, key, sizeof(key))) {
+        ESP_LOGI(TAG, "Data model update is identical to '%s'; sharing it", key);
+    } else {
+        // Pick one of our own keys that no other slot refers to.
+        key[0] = '\0';
+        for (const char *suffix : kBlobKeySuffixes) {
+            make_key(key, sizeof(key), label, suffix);
+            if (!is_blob_referenced(storage_, key, label, state, target_slot)) {
+                break;
+            }
+            key[0] = '\0';
+        }
+        if (key[0] == '\0') {
+            ESP_LOGE(TAG, "No free data model key for partition '%s'", label);
+            err = ESP_ERR_INVALID_STATE;
+            goto cleanup;
+        }
+        err = storage_.set_data_model(key, update_buffer_);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to write data model to '%s' (%d)", key, err);
+            goto cleanup;
+        }
+    }
+
+    // Flip the active pointer. This single record write is the commit point of the update.
+    memcpy(state.blob_key[target_slot], key, sizeof(key));
+    state.size[target_slot] = update_size_;
+    state.crc32[target_slot] = update_crc32_;
+    state.active = target_slot;
+    state.pending = 1;
+    state.boot_attempts = 0;
+    err = write_slot_state(storage_, label, state);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to activate slot %u (%d)", target_slot, err);
+        goto cleanup;
+    }
+    ESP_LOGI(TAG, "Data model update stored in '%s' and activated; pending confirmation", key);
+
+    // Release the blob the target slot used before, unless something else still refers to it.
+    if (old_key[0] != '\0' && strcmp(old_key, key) != 0 && !is_blob_referenced(storage_, old_key, label, state, -1)) {
+        if (storage_.remove_key(old_key) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to erase unused data model '%s'", old_key);
+        }
+    }
+
+cleanup:
+    abort_update();
+    return err;
+}
+
+void DataModelManager::abort_update()
+{
+    update_buffer_.release();
+    update_size_ = 0;
+    update_crc32_ = 0;
+    update_running_crc32_ = 0;
+    update_in_progress_ = false;
+}
+
+esp_err_t DataModelManager::mark_data_model_valid()
+{
+    const char *label = get_running_partition_label();
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        return ESP_FAIL;
+    }
+
+    SlotState state;
+    esp_err_t err = read_slot_state(storage_, label, state);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_OK;
+    } else if (err != ESP_OK || !state.pending) {
+        return err;
+    }
+
+    state.pending = 0;
+    state.boot_attempts = 0;
+    err = write_slot_state(storage_, label, state);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Data model in slot %u confirmed", state.active);
+    }
+    return err;
+}
+
+esp_err_t DataModelManager::is_data_model_pending(bool &pending)
+{
+    pending = false;
+    const char *label = get_running_partition_label();
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        return ESP_FAIL;
+    }
+
+    SlotState state;
+    esp_err_t err = read_slot_state(storage_, label, state);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_OK;
+    } else if (err != ESP_OK) {
+        return err;
+    }
+    pending = state.pending != 0;
+    return ESP_OK;
+}
+
+esp_err_t DataModelManager::fall_back_to_last_known_good(allocator_policy::Buffer &data)
+{
+    const char *label = get_running_partition_label();
+    if (!label) {
+        ESP_LOGE(TAG, "Failed to get running partition");
+        return ESP_FAIL;
+    }
+
+    SlotState state;
+    esp_err_t err = read_slot_state(storage_, label, state);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+    uint8_t previous = state.active ^ 1;
+    if (err == ESP_ERR_NVS_NOT_FOUND || state.blob_key[previous][0] == '\0') {
+        ESP_LOGE(TAG, "No other data model to fall back to");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    err = load_slot(storage_, state, previous, data);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to load the data model of slot %u (%d)", previous, err);
+        return err;
+    }
+
+    set_loaded_blob(state.blob_key[previous], data, state.size[previous], state.crc32[previous]);
+    if (state.pending) {
+        roll_back(state);
+    } else {
+        // Counted as this boot, so a reboot before the confirmation returns to the other slot.
+        ESP_LOGW(TAG, "Data model in slot %u failed; switching to slot %u, pending confirmation", state.active, previous);
+        state.active = previous;
+        state.pending = 1;
+        state.boot_attempts = kMaxUnconfirmedBoots;
+    }
+    err = write_slot_state(storage_, label, state);
+    if (err != ESP_OK) {
+        // The binary is still usable, the next boot starts from the failed slot again.
+        ESP_LOGE(TAG, "Failed to write slot state after the fallback (%d)", err);
+    }
+    return ESP_OK;
+}
+
+esp_err_t DataModelManager::get_loaded_blob(BlobRef &blob) const
+{
+    if (loaded_.key[0] == '\0') {
+        return ESP_ERR_NOT_FOUND;
+    }
+    blob = loaded_;
+    return ESP_OK;
+}
+
+esp_err_t DataModelManager::read_blob(const BlobRef &blob, allocator_policy::Buffer &data)
+{
+    if (blob.key[0] == '\0' || blob.size == 0) {
+        data.clear();
+        return ESP_ERR_NOT_FOUND;
+    }
+    // A slot pointing at the blob, so that it is verified like the data model of a slot.
+    SlotState state = {};
+    memcpy(state.blob_key[0], blob.key, sizeof(state.blob_key[0]));
+    state.blob_key[0][kBlobKeySize - 1] = '\0';
+    state.size[0] = blob.size;
+    state.crc32[0] = blob.crc32;
+    return load_slot(storage_, state, 0, data);
+}
+
+void DataModelManager::set_loaded_blob(const char *key, const allocator_policy::Buffer &data, uint32_t size,
+                                       uint32_t crc32)
+{
+    memcpy(loaded_.key, key, sizeof(loaded_.key));
+    // Slot 0 of a fresh device was never verified.
+    loaded_.size = size != 0 ? size : data.size();
+    loaded_.crc32 = size != 0 ? crc32 : esp_rom_crc32_le(0, data.data(), data.size());
+}
+
 } // namespace data_model_manager
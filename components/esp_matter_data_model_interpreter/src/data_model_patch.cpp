@@ -0,0 +1,226 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "data_model_patch.hpp"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include <algorithm>
+#include <cinttypes>
+
+static const char *TAG = "DataModelPatcher";
+
+namespace data_model_manager {
+
+namespace {
+
+constexpr uint8_t kPatchMagic[] = {'D', 'M', 'P', 1};
+constexpr uint8_t kOpCopy = 0x00;
+constexpr uint8_t kOpInsert = 0x01;
+// A uint32_t needs at most 5 varint bytes.
+constexpr uint8_t kMaxVarintBytes = 5;
+
+} // namespace
+
+DataModelPatcher::DataModelPatcher(DataModelManager &manager)
+    : manager_(manager), state_(State::Idle),
+      source_(manager.policy(), allocator_policy::Usage::Binary), value_(0), value_bytes_(0), source_size_(0), source_crc32_(0),
+      target_size_(0), target_crc32_(0), copy_offset_(0), remaining_(0), update_started_(false)
+{
+}
+
+DataModelPatcher::~DataModelPatcher()
+{
+    abort();
+}
+
+esp_err_t DataModelPatcher::begin()
+{
+    if (state_ != State::Idle) {
+        ESP_LOGE(TAG, "A patch is already being applied");
+        return ESP_ERR_INVALID_STATE;
+    }
+    state_ = State::Magic;
+    value_ = 0;
+    value_bytes_ = 0;
+    return ESP_OK;
+}
+
+esp_err_t DataModelPatcher::write(const uint8_t *data, size_t length)
+{
+    if (state_ == State::Idle) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!data && length) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_OK;
+    size_t i = 0;
+    while (i < length && err == ESP_OK) {
+        uint8_t byte = data[i];
+        switch (state_) {
+        case State::Magic:
+            if (byte != kPatchMagic[value_bytes_]) {
+                ESP_LOGE(TAG, "Unsupported patch header");
+                err = ESP_ERR_INVALID_VERSION;
+                break;
+            }
+            if (++value_bytes_ == sizeof(kPatchMagic)) {
+                value_bytes_ = 0;
+                state_ = State::SourceSize;
+            }
+            i++;
+            break;
+        case State::SourceCrc:
+        case State::TargetCrc:
+            value_ |= static_cast<uint32_t>(byte) << (8 * value_bytes_);
+            if (++value_bytes_ == sizeof(uint32_t)) {
+                err = on_value(value_);
+            }
+            i++;
+            break;
+        case State::Op:
+            if (byte == kOpCopy) {
+                state_ = State::CopyOffset;
+            } else if (byte == kOpInsert) {
+                state_ = State::InsertLength;
+            } else {
+                ESP_LOGE(TAG, "Unknown patch op 0x%02x", byte);
+                err = ESP_ERR_INVALID_ARG;
+            }
+            i++;
+            break;
+        case State::InsertData: {
+            size_t chunk = std::min<size_t>(remaining_, length - i);
+            err = manager_.write_update(data + i, chunk);
+            remaining_ -= chunk;
+            i += chunk;
+            if (remaining_ == 0) {
+                state_ = State::Op;
+            }
+            break;
+        }
+        default:
+            // Varint fields. The last byte holds the top 4 bits of a uint32 and ends the varint.
+            if (value_bytes_ == kMaxVarintBytes - 1 && byte > 0x0F) {
+                ESP_LOGE(TAG, "Malformed varint in patch");
+                err = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+            value_ |= static_cast<uint32_t>(byte & 0x7F) << (7 * value_bytes_++);
+            if (!(byte & 0x80)) {
+                err = on_value(value_);
+            }
+            i++;
+            break;
+        }
+    }
+
+    if (err != ESP_OK) {
+        abort();
+    }
+    return err;
+}
+
+esp_err_t DataModelPatcher::on_value(uint32_t value)
+{
+    esp_err_t err = ESP_OK;
+    value_ = 0;
+    value_bytes_ = 0;
+
+    switch (state_) {
+    case State::SourceSize:
+        source_size_ = value;
+        state_ = State::SourceCrc;
+        break;
+    case State::SourceCrc:
+        source_crc32_ = value;
+        state_ = State::TargetSize;
+        break;
+    case State::TargetSize:
+        target_size_ = value;
+        state_ = State::TargetCrc;
+        break;
+    case State::TargetCrc:
+        target_crc32_ = value;
+        err = on_header_complete();
+        state_ = State::Op;
+        break;
+    case State::CopyOffset:
+        copy_offset_ = value;
+        state_ = State::CopyLength;
+        break;
+    case State::CopyLength:
+        if (static_cast<uint64_t>(copy_offset_) + value > source_.size()) {
+            ESP_LOGE(TAG, "Patch copies [%" PRIu32 ", +%" PRIu32 ") outside of the source", copy_offset_, value);
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        err = manager_.write_update(source_.data() + copy_offset_, value);
+        state_ = State::Op;
+        break;
+    case State::InsertLength:
+        remaining_ = value;
+        state_ = remaining_ ? State::InsertData : State::Op;
+        break;
+    default:
+        err = ESP_ERR_INVALID_STATE;
+        break;
+    }
+    return err;
+}
+
+esp_err_t DataModelPatcher::on_header_complete()
+{
+    // Verify the source before writing anything, the patch only applies to one exact binary.
+    esp_err_t err = manager_.get_active_data_model(source_);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read the active data model (%d)", err);
+        return err;
+    }
+    uint32_t crc32 = esp_rom_crc32_le(0, source_.data(), source_.size());
+    if (source_.size() != source_size_ || crc32 != source_crc32_) {
+        ESP_LOGE(TAG, "Patch does not apply to the active data model (size %zu, crc 0x%08" PRIx32 ")",
+                 source_.size(), crc32);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    err = manager_.begin_update(target_size_, target_crc32_);
+    if (err != ESP_OK) {
+        return err;
+    }
+    update_started_ = true;
+    return ESP_OK;
+}
+
+esp_err_t DataModelPatcher::end()
+{
+    if (state_ != State::Op || !update_started_) {
+        ESP_LOGE(TAG, "Patch is incomplete");
+        abort();
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // end_update() verifies the size and CRC-32 of the patched binary.
+    esp_err_t err = manager_.end_update();
+    update_started_ = false;
+    abort();
+    return err;
+}
+
+void DataModelPatcher::abort()
+{
+    if (update_started_) {
+        manager_.abort_update();
+        update_started_ = false;
+    }
+    source_.release();
+    state_ = State::Idle;
+    value_ = 0;
+    value_bytes_ = 0;
+    remaining_ = 0;
+}
+
+} // namespace data_model_manager
@@ -1,69 +1,450 @@
 /*
  * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
- * SPDX-License-Identifier: BSD-2-Clause AND Apache-2.0
- * SPDX-FileContributor: Dave Benson and the protobuf-c authors (for scan_length_prefixed_data)
+ *
+ * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <inttypes.h>
+#include <vector>
 
 #include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#endif
 
+#include "attribute_index.hpp"
 #include "cmd_c_routines.h"
+#include "decode_arena.hpp"
+#include "message_framing.hpp"
+#include "message_validation.hpp"
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+#include "spsc_ring.hpp"
+#endif
 
 #include "esp_matter_data_model_interpreter.hpp"
+#include "heap_accounting.hpp"
+#include "payload_source.hpp"
 #include "esp_matter_data_model_api_messages.pb-c.h"
 
 static const char *TAG = "Interpreter";
 
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+static const char *DECODE_MODE = "pipelined";
+#else
+static const char *DECODE_MODE = "sequential";
+#endif
+
 namespace esp_matter_data_model_interpreter {
 
 class Interpreter::Impl {
 public:
-    Impl() : current_endpoint(nullptr), current_cluster(nullptr), raw_node(nullptr) {}
+    explicit Impl(allocator_policy::Policy &policy)
+        : current_endpoint(nullptr), current_cluster(nullptr), raw_node(nullptr), applying_delta(false),
+          policy(policy), decode_arena(policy), attribute_created_cb(nullptr), attribute_created_arg(nullptr),
+          endpoint_removed_cb(nullptr), endpoint_removed_arg(nullptr), value_pool_data(policy, allocator_policy::Usage::Payload)
+    {
+        pipeline_allocator = {&alloc_decoded, &free_decoded, &policy};
+    }
 
-    ~Impl() {}
+    ~Impl()
+    {
+        if (!deferred_payloads.empty()) {
+            // read_deferred() may run on the Matter task until the attributes are unregistered.
+            esp_matter::lock::ScopedChipStackLock lock(portMAX_DELAY);
+            clear_deferred_payloads();
+        }
+    }
 
     esp_matter::endpoint_t *current_endpoint;
     esp_matter::cluster_t *current_cluster;
     esp_matter::node_t *raw_node;
 
-    /* Taken from protobuf-c.c, but it was static there, so it had to be copied */
-    size_t scan_length_prefixed_data(size_t len, const uint8_t *data, size_t *prefix_len_out)
+    bool applying_delta;
+    // Endpoints created by the delta being applied, enabled once the whole delta is applied.
+    std::vector<esp_matter::endpoint_t *> delta_endpoints;
+
+    // Placement of the decode scratch and of the payloads kept by the interpreter.
+    allocator_policy::Policy &policy;
+    // Memory of the message being handled, kept across messages and across runs of this instance.
+    DecodeArena decode_arena;
+    // Messages decoded by the decode task are freed one by one, see alloc_decoded().
+    ProtobufCAllocator pipeline_allocator;
+
+    // protobuf-c frees without a size, so the size of the block is kept in front of it.
+    static constexpr size_t kDecodedHeader = alignof(std::max_align_t);
+
+    static void *alloc_decoded(void *allocator_data, size_t size)
     {
-        unsigned hdr_max = len < 5 ? len : 5;
-        unsigned hdr_len;
-        size_t val = 0;
-        unsigned i;
-        unsigned shift = 0;
+        allocator_policy::Policy *policy = static_cast<allocator_policy::Policy *>(allocator_data);
+        size_t total = size + kDecodedHeader;
+        uint8_t *block = static_cast<uint8_t *>(policy->allocate(allocator_policy::Usage::DecodeScratch, total));
+        if (!block) {
+            return nullptr;
+        }
+        memcpy(block, &total, sizeof(total));
+        return block + kDecodedHeader;
+    }
 
-        for (i = 0; i < hdr_max; i++) {
-            val |= ((size_t)data[i] & 0x7f) << shift;
-            shift += 7;
-            if ((data[i] & 0x80) == 0) {
-                break;
+    static void free_decoded(void *allocator_data, void *ptr)
+    {
+        if (!ptr) {
+            return;
+        }
+        allocator_policy::Policy *policy = static_cast<allocator_policy::Policy *>(allocator_data);
+        uint8_t *block = static_cast<uint8_t *>(ptr) - kDecodedHeader;
+        size_t total;
+        memcpy(&total, block, sizeof(total));
+        policy->deallocate(allocator_policy::Usage::DecodeScratch, block, total);
+    }
+
+    AttributeCreatedCallback attribute_created_cb;
+    void *attribute_created_arg;
+    EndpointRemovedCallback endpoint_removed_cb;
+    void *endpoint_removed_arg;
+
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+    // Handles of the attributes created by this instance, for get_attribute().
+    AttributeIndex attribute_index;
+    bool attribute_index_full = false;
+#endif
+
+    void index_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                         esp_matter::attribute_t *attribute)
+    {
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+        if (attribute_index_full) {
+            return;
+        }
+        if (attribute_index.add(endpoint_id, cluster_id, attribute_id, attribute) != ESP_OK) {
+            // Attributes missing from the index are looked up in esp_matter, the node does not depend on it.
+            ESP_LOGW(TAG, "Not enough memory to index attribute_id: %" PRIu32 ", the next ones are not indexed",
+                     attribute_id);
+            attribute_index_full = true;
+        }
+#endif
+    }
+
+    void unindex_endpoint(uint16_t endpoint_id)
+    {
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+        attribute_index.remove_endpoint(endpoint_id);
+#endif
+        if (endpoint_removed_cb) {
+            endpoint_removed_cb(endpoint_id, endpoint_removed_arg);
+        }
+    }
+
+    void clear_attribute_index()
+    {
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+        attribute_index.clear();
+        attribute_index_full = false;
+#endif
+    }
+
+    void log_attribute_index()
+    {
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+        ESP_LOGI(TAG, "Attribute index: %zu attributes in %zu bytes", attribute_index.size(),
+                 attribute_index.memory_bytes());
+#endif
+    }
+
+    esp_matter::attribute_t *get_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+    {
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+        esp_matter::attribute_t *attribute = attribute_index.find(endpoint_id, cluster_id, attribute_id);
+        if (attribute) {
+            return attribute;
+        }
+#endif
+        // Not created by this instance, or the index is disabled.
+        return esp_matter::attribute::get(endpoint_id, cluster_id, attribute_id);
+    }
+
+    IPayloadSource *payload_source = nullptr;
+
+    // Payload section at the end of the binary being interpreted, see DeclarePayloadsParams.
+    const uint8_t *payload_section = nullptr;
+    size_t payload_section_offset = 0;
+    size_t payload_section_size = 0;
+
+    /* An attribute created without its out-of-line payload, read from the payload source on the first access. */
+    struct DeferredPayload {
+        uint32_t cluster_id;
+        uint32_t attribute_id;
+        uint16_t endpoint_id;
+        uint16_t size;
+        uint16_t count;              // elements of an array
+        esp_matter_val_type_t type;
+        uint32_t offset;             // in the binary
+        uint32_t crc32;
+        uint8_t *data;               // nullptr until read
+    };
+
+    std::vector<DeferredPayload> deferred_payloads;
+    uint32_t deferred_failures = 0;
+
+    // Instances with deferred payloads, for read_deferred(), as override callbacks only get the priv_data
+    // of the endpoint: the owner of an attribute is the instance that created it in the node the callback
+    // runs for. esp_matter has one node, guarded by the Matter stack lock. The Linux stand-in has one node
+    // per thread, built and read by that thread, so the list is per thread there, like the node.
+#if CONFIG_IDF_TARGET_LINUX
+    static inline thread_local std::vector<Impl *> deferred_owners;
+#else
+    static inline std::vector<Impl *> deferred_owners;
+#endif
+
+    void add_deferred(const DeferredPayload &deferred)
+    {
+        if (deferred_payloads.empty()) {
+            deferred_owners.push_back(this);
+        }
+        deferred_payloads.push_back(deferred);
+    }
+
+    void remove_deferred_owner()
+    {
+        deferred_owners.erase(std::remove(deferred_owners.begin(), deferred_owners.end(), this), deferred_owners.end());
+    }
+
+    static esp_matter_attr_val_t payload_attr_val(esp_matter_val_type_t type, uint8_t *data, uint16_t size, uint16_t count)
+    {
+        switch (type) {
+        case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+            return esp_matter_char_str(reinterpret_cast<char *>(data), size);
+        case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+            return esp_matter_long_char_str(reinterpret_cast<char *>(data), size);
+        case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+            return esp_matter_octet_str(data, size);
+        case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+            return esp_matter_long_octet_str(data, size);
+        default:
+            return esp_matter_array(data, size, count);
+        }
+    }
+
+    /*
+     * The value of an attribute whose payload is in the payload section: the payload itself, or, with a
+     * payload source, an empty value and the entry to read the payload on the first access.
+     */
+    esp_err_t get_out_of_line_val(const Datamodel__CreateAttributeParams *params, esp_matter_attr_val_t &val,
+                                  DeferredPayload &deferred, bool &defer)
+    {
+        if (!has_data_pointer(val.type) || !params->has_payload_offset || !params->has_payload_crc32 ||
+            params->payload_size == 0 || params->payload_size > UINT16_MAX ||
+            params->payload_offset > payload_section_size ||
+            params->payload_size > payload_section_size - params->payload_offset) {
+            ESP_LOGE(TAG, "create_attribute: Invalid payload reference for attribute_id: %" PRIu32, params->attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        uint16_t size = params->payload_size;
+        uint16_t count = val.type == ESP_MATTER_VAL_TYPE_ARRAY ? val.val.a.n : size;
+        defer = payload_source != nullptr;
+        if (!defer) {
+            // The binary is held until the end of interpret_data(), and esp_matter copies the payload. Its
+            // storage checks it as a whole, the CRC only guards the later reads of a payload source.
+            uint8_t *data = const_cast<uint8_t *>(payload_section) + params->payload_offset;
+            val = payload_attr_val(val.type, data, size, count);
+            return ESP_OK;
+        }
+        deferred = {params->cluster_id, params->attribute_id, 0, size, count, val.type,
+                    static_cast<uint32_t>(payload_section_offset + params->payload_offset), params->payload_crc32, nullptr};
+        val = payload_attr_val(val.type, nullptr, 0, 0);
+        return ESP_OK;
+    }
+
+    DeferredPayload *find_deferred(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+    {
+        // A handful of label lists and long strings per node, a linear search is enough.
+        for (DeferredPayload &entry : deferred_payloads) {
+            if (entry.attribute_id == attribute_id && entry.cluster_id == cluster_id && entry.endpoint_id == endpoint_id) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    esp_err_t read_payload(DeferredPayload &entry)
+    {
+        uint8_t *data = static_cast<uint8_t *>(policy.allocate(allocator_policy::Usage::Payload, entry.size));
+        esp_err_t err = data ? payload_source->read(entry.offset, data, entry.size) : ESP_ERR_NO_MEM;
+        if (err == ESP_OK && esp_rom_crc32_le(0, data, entry.size) != entry.crc32) {
+            err = ESP_ERR_INVALID_CRC;
+        }
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to read the payload of attribute_id: %" PRIu32 " in cluster id: %" PRIu32
+                     " on endpoint id: %u, error: %d", entry.attribute_id, entry.cluster_id, entry.endpoint_id, err);
+            policy.deallocate(allocator_policy::Usage::Payload, data, entry.size);
+            deferred_failures++;
+            return err;
+        }
+        entry.data = data;
+        return ESP_OK;
+    }
+
+    void release_payload(DeferredPayload &entry)
+    {
+        // An updated empty value takes one byte, as a null data means a payload not read yet.
+        policy.deallocate(allocator_policy::Usage::Payload, entry.data, entry.size ? entry.size : 1);
+        entry.data = nullptr;
+    }
+
+    /*
+     * Update an attribute with a deferred payload. esp_matter only holds an empty value for it and
+     * read_deferred() serves the entry, so the new value replaces the payload of the entry.
+     */
+    esp_err_t update_deferred(DeferredPayload &entry, esp_matter_attr_val_t &val)
+    {
+        if (!has_data_pointer(val.type) || (val.val.a.s && !val.val.a.b)) {
+            ESP_LOGE(TAG, "update_attribute: Invalid value for the payload of attribute_id: %" PRIu32, entry.attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        uint16_t size = val.val.a.s;
+        uint8_t *data = static_cast<uint8_t *>(policy.allocate(allocator_policy::Usage::Payload, size ? size : 1));
+        if (!data) {
+            return ESP_ERR_NO_MEM;
+        }
+        if (size) {
+            memcpy(data, val.val.a.b, size);
+        }
+        release_payload(entry);
+        entry.data = data;
+        entry.size = size;
+        entry.count = val.type == ESP_MATTER_VAL_TYPE_ARRAY ? val.val.a.n : size;
+        entry.type = val.type;
+        return esp_matter::attribute::report(entry.endpoint_id, entry.cluster_id, entry.attribute_id, &val);
+    }
+
+    esp_err_t load_deferred(DeferredPayload &entry, esp_matter_attr_val_t &val)
+    {
+        if (!entry.data) {
+            if (!payload_source) {
+                return ESP_ERR_INVALID_STATE;
+            }
+            // Read all the payloads not read yet in one batch, so that a source loading the whole binary
+            // loads it once.
+            esp_err_t err = payload_source->begin_reads();
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to read the out-of-line payloads, error: %d", err);
+                deferred_failures++;
+                return err;
+            }
+            for (DeferredPayload &pending : deferred_payloads) {
+                if (!pending.data) {
+                    esp_err_t read_err = read_payload(pending);
+                    if (&pending == &entry) {
+                        err = read_err;
+                    }
+                }
+            }
+            payload_source->end_reads();
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        val = payload_attr_val(entry.type, entry.data, entry.size, entry.count);
+        return ESP_OK;
+    }
+
+    /* Override callback of the attributes with a deferred payload, called with the Matter stack lock held. */
+    static esp_err_t read_deferred(esp_matter::attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                   uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data)
+    {
+        if (type != esp_matter::attribute::READ) {
+            // Only the payloads of attributes that are not writable are moved out of line.
+            return type == esp_matter::attribute::WRITE ? ESP_ERR_NOT_SUPPORTED : ESP_OK;
+        }
+        esp_matter::node_t *node = esp_matter::node::get();
+        for (Impl *owner : deferred_owners) {
+            DeferredPayload *entry = owner->raw_node == node ? owner->find_deferred(endpoint_id, cluster_id, attribute_id)
+                                                             : nullptr;
+            if (entry) {
+                return owner->load_deferred(*entry, *val);
+            }
+        }
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    void forget_deferred_payloads(uint16_t endpoint_id)
+    {
+        auto kept = std::remove_if(deferred_payloads.begin(), deferred_payloads.end(), [&](DeferredPayload &entry) {
+            if (entry.endpoint_id != endpoint_id) {
+                return false;
+            }
+            release_payload(entry);
+            return true;
+        });
+        if (kept != deferred_payloads.end()) {
+            deferred_payloads.erase(kept, deferred_payloads.end());
+            if (deferred_payloads.empty()) {
+                remove_deferred_owner();
             }
         }
-        if (i == hdr_max) {
-            ESP_LOGE(TAG, "error parsing length for length-prefixed data");
-            return 0;
+    }
+
+    void clear_deferred_payloads()
+    {
+        for (DeferredPayload &entry : deferred_payloads) {
+            release_payload(entry);
         }
-        hdr_len = i + 1;
-        *prefix_len_out = hdr_len;
-        if (val > INT_MAX) {
-            // Protobuf messages should always be less than 2 GiB in size.
-            // We also want to return early here so that hdr_len + val does
-            // not overflow on 32-bit systems.
-            ESP_LOGE(TAG, "length prefix of %lu is too large",
-                     (unsigned long int)val);
-            return 0;
+        if (!deferred_payloads.empty()) {
+            remove_deferred_owner();
         }
-        if (hdr_len + val > len) {
-            ESP_LOGE(TAG, "data too short after length-prefix of %lu",
-                     (unsigned long int)val);
-            return 0;
+        std::vector<DeferredPayload>().swap(deferred_payloads);
+        deferred_failures = 0;
+    }
+
+    void log_deferred_payloads()
+    {
+        if (!deferred_payloads.empty()) {
+            size_t bytes = 0;
+            for (const DeferredPayload &entry : deferred_payloads) {
+                bytes += entry.size;
+            }
+            ESP_LOGI(TAG, "Out-of-line payloads: %zu attributes (%zu bytes) read on first access",
+                     deferred_payloads.size(), bytes);
         }
-        return hdr_len + val;
     }
 
+    /* Values shared by several attributes of one binary, added with DEFINE_VALUE and referenced by index. */
+    struct PooledValue {
+        Datamodel__EspMatterVal val;  // scalars, payload pointers are set when the value is resolved
+        uint32_t data_offset;         // payload in value_pool_data, char strings include the terminator
+        uint32_t data_size;
+        uint32_t array_count;
+    };
+
+    /* A pooled value in the form of a decoded message, valid until the pool changes. */
+    struct ResolvedValue {
+        Datamodel__EspMatterVal val;
+        Datamodel__EspMatterArray array;
+    };
+
+    /* The value and bounds of an attribute, either from the message itself or from the pool. */
+    struct AttributeValues {
+        const Datamodel__EspMatterAttrVal *val;
+        const Datamodel__EspMatterVal *bounds_min;
+        const Datamodel__EspMatterVal *bounds_max;
+        Datamodel__EspMatterAttrVal pooled_attr_val;
+        ResolvedValue pooled_val;
+        ResolvedValue pooled_bounds_min;
+        ResolvedValue pooled_bounds_max;
+    };
+
+    std::vector<PooledValue> value_pool;
+    allocator_policy::Buffer value_pool_data;
+    size_t value_pool_refs = 0;
+
     esp_err_t handle_function_call(const Datamodel__FunctionCall *message)
     {
         esp_err_t err = ESP_OK;
@@ -87,6 +468,22 @@ public:
         case DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS:
             err = endpoint_add_device_type(message->endpoint_add_device_type_params);
             break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_REMOVE_ENDPOINT_PARAMS:
+            err = remove_endpoint(message->remove_endpoint_params);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_UPDATE_ATTRIBUTE_PARAMS:
+            err = update_attribute(message->update_attribute_params);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DEFINE_VALUE_PARAMS:
+            err = define_value(message->define_value_params);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DECLARE_PAYLOADS_PARAMS:
+            // The section was split off by interpret_data(), a delta has none.
+            if (applying_delta) {
+                ESP_LOGE(TAG, "declare_payloads: Only allowed in a data model binary");
+                err = ESP_ERR_INVALID_ARG;
+            }
+            break;
         default:
             ESP_LOGE(TAG, "Unknown params");
             err = ESP_ERR_INVALID_ARG;
@@ -98,19 +495,46 @@ public:
 
     esp_err_t create_endpoint(const Datamodel__CreateEndpointParams *params)
     {
+        // Non-root endpoints are created destroyable so that a delta can remove them later.
+        uint8_t flags = params->flags;
+        if (params->endpoint_id != 0) {
+            flags |= esp_matter::ENDPOINT_FLAG_DESTROYABLE;
+        }
+
+        heap_accounting::begin_span(params->endpoint_id, heap_accounting::kEndpointOverhead);
         current_endpoint = nullptr;
-        current_endpoint = esp_matter::endpoint::create(raw_node, params->flags, nullptr);
+        if (applying_delta) {
+            // The node already has endpoints, so the endpoint id from the delta has to be honoured. esp_matter
+            // only hands out the next unused id, and only resumes ids it has handed out before.
+            uint16_t next_id = esp_matter::endpoint::get_next_id();
+            if (params->endpoint_id > next_id) {
+                ESP_LOGE(TAG, "create_endpoint: endpoint_id: %" PRIu32 " is past the next unused id: %" PRIu16,
+                         params->endpoint_id, next_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (params->endpoint_id == next_id) {
+                current_endpoint = esp_matter::endpoint::create(raw_node, flags, nullptr);
+            } else {
+                current_endpoint = esp_matter::endpoint::resume(raw_node, flags, params->endpoint_id, nullptr);
+            }
+        } else {
+            current_endpoint = esp_matter::endpoint::create(raw_node, flags, nullptr);
+        }
         if (current_endpoint == nullptr) {
             ESP_LOGE(TAG, "create_endpoint: Failed to create endpoint with endpoint_id: %" PRIu32, params->endpoint_id);
             return ESP_FAIL;
         } else {
             ESP_LOGD(TAG, "create_endpoint: Created endpoint with id: %" PRIu32, params->endpoint_id);
+            if (applying_delta) {
+                delta_endpoints.push_back(current_endpoint);
+            }
             return ESP_OK;
         }
     }
 
     esp_err_t create_cluster(const Datamodel__CreateClusterParams *params)
     {
+        heap_accounting::begin_span(params->endpoint_id, params->cluster_id);
         current_cluster = nullptr;
         current_cluster = esp_matter::cluster::create(current_endpoint, params->cluster_id, params->flags);
         if (current_cluster == nullptr) {
@@ -118,300 +542,384 @@ public:
             return ESP_FAIL;
         } else {
             ESP_LOGD(TAG, "create_cluster: Created cluster with id: %" PRIu32 " on endpoint", params->cluster_id);
+            // Fails for clusters without a plugin, e.g. vendor clusters, which work without one.
             esp_err_t err = cluster_plugin_init(current_cluster, params->cluster_id);
             if (err != ESP_OK) {
-                ESP_LOGE(TAG, "cmd_c_routines: cluster_plugin_init failed for cluster id: %" PRIu32 ", error: %d", params->cluster_id, err);
-                return err;
+                ESP_LOGW(TAG, "cmd_c_routines: No plugin for cluster id: %" PRIu32 ", error: %d", params->cluster_id, err);
             }
             return ESP_OK;
         }
     }
 
-    esp_err_t create_attribute(const Datamodel__CreateAttributeParams *params)
+    /* Convert a serialized attribute value into an esp_matter value, using the type default if no value is set. */
+    esp_err_t get_attr_val(const Datamodel__EspMatterAttrVal *attr_val, bool is_nullable, esp_matter_attr_val_t &out)
     {
-        if (!params) {
-            return ESP_ERR_INVALID_ARG;
-        }
-
-        bool is_nullable = params->flags & esp_matter::ATTRIBUTE_FLAG_NULLABLE;
-
-        Datamodel__EspMatterValType value_type = params->val ? params->val->type : DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INVALID;
-        bool value_is_set = params->val && params->val->val && params->val->val->value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
-
-        esp_matter::attribute_t *created_attribute = nullptr;
+        Datamodel__EspMatterValType value_type = attr_val ? attr_val->type : DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INVALID;
+        bool value_is_set = attr_val && attr_val->val && attr_val->val->value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
+        const Datamodel__EspMatterVal *val = value_is_set ? attr_val->val : nullptr;
 
         switch (value_type) {
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BOOLEAN:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_bool(params->val->val->b)
-                                                                              : esp_matter_bool(params->val->val->b))
-                                                              : (is_nullable ? esp_matter_nullable_bool(nullable<bool>())
-                                                                 : esp_matter_bool(false)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_bool(val->b) : esp_matter_bool(val->b))
+                  : (is_nullable ? esp_matter_nullable_bool(nullable<bool>()) : esp_matter_bool(false));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT8:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_int8(params->val->val->i8)
-                                                                              : esp_matter_int8(params->val->val->i8))
-                                                              : (is_nullable ? esp_matter_nullable_int8(nullable<int8_t>())
-                                                                 : esp_matter_int8(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_int8(val->i8) : esp_matter_int8(val->i8))
+                  : (is_nullable ? esp_matter_nullable_int8(nullable<int8_t>()) : esp_matter_int8(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT8:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_uint8(params->val->val->u8)
-                                                                              : esp_matter_uint8(params->val->val->u8))
-                                                              : (is_nullable ? esp_matter_nullable_uint8(nullable<uint8_t>())
-                                                                 : esp_matter_uint8(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_uint8(val->u8) : esp_matter_uint8(val->u8))
+                  : (is_nullable ? esp_matter_nullable_uint8(nullable<uint8_t>()) : esp_matter_uint8(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT16:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_int16(params->val->val->i16)
-                                                                              : esp_matter_int16(params->val->val->i16))
-                                                              : (is_nullable ? esp_matter_nullable_int16(nullable<int16_t>())
-                                                                 : esp_matter_int16(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_int16(val->i16) : esp_matter_int16(val->i16))
+                  : (is_nullable ? esp_matter_nullable_int16(nullable<int16_t>()) : esp_matter_int16(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT16:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_uint16(params->val->val->u16)
-                                                                              : esp_matter_uint16(params->val->val->u16))
-                                                              : (is_nullable ? esp_matter_nullable_uint16(nullable<uint16_t>())
-                                                                 : esp_matter_uint16(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_uint16(val->u16) : esp_matter_uint16(val->u16))
+                  : (is_nullable ? esp_matter_nullable_uint16(nullable<uint16_t>()) : esp_matter_uint16(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT32:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_int32(params->val->val->i32)
-                                                                              : esp_matter_int32(params->val->val->i32))
-                                                              : (is_nullable ? esp_matter_nullable_int32(nullable<int32_t>())
-                                                                 : esp_matter_int32(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_int32(val->i32) : esp_matter_int32(val->i32))
+                  : (is_nullable ? esp_matter_nullable_int32(nullable<int32_t>()) : esp_matter_int32(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT32:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_uint32(params->val->val->u32)
-                                                                              : esp_matter_uint32(params->val->val->u32))
-                                                              : (is_nullable ? esp_matter_nullable_uint32(nullable<uint32_t>())
-                                                                 : esp_matter_uint32(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_uint32(val->u32) : esp_matter_uint32(val->u32))
+                  : (is_nullable ? esp_matter_nullable_uint32(nullable<uint32_t>()) : esp_matter_uint32(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT64:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_int64(params->val->val->i64)
-                                                                              : esp_matter_int64(params->val->val->i64))
-                                                              : (is_nullable ? esp_matter_nullable_int64(nullable<int64_t>())
-                                                                 : esp_matter_int64(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_int64(val->i64) : esp_matter_int64(val->i64))
+                  : (is_nullable ? esp_matter_nullable_int64(nullable<int64_t>()) : esp_matter_int64(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT64:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_uint64(params->val->val->u64)
-                                                                              : esp_matter_uint64(params->val->val->u64))
-                                                              : (is_nullable ? esp_matter_nullable_uint64(nullable<uint64_t>())
-                                                                 : esp_matter_uint64(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_uint64(val->u64) : esp_matter_uint64(val->u64))
+                  : (is_nullable ? esp_matter_nullable_uint64(nullable<uint64_t>()) : esp_matter_uint64(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_FLOAT:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_float(params->val->val->f)
-                                                                              : esp_matter_float(params->val->val->f))
-                                                              : (is_nullable ? esp_matter_nullable_float(nullable<float>())
-                                                                 : esp_matter_float(0.0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_float(val->f) : esp_matter_float(val->f))
+                  : (is_nullable ? esp_matter_nullable_float(nullable<float>()) : esp_matter_float(0.0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_CHAR_STRING:
-            if (params->has_max_val_size) {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_char_str(params->val->val->char_string, strlen(params->val->val->char_string))
-                                                                  : (is_nullable ? esp_matter_char_str(nullptr, 0)
-                                                                     : esp_matter_char_str(nullptr, 0)),
-                                                                  params->max_val_size);
-            } else {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_char_str(params->val->val->char_string, strlen(params->val->val->char_string))
-                                                                  : (is_nullable ? esp_matter_char_str(nullptr, 0)
-                                                                     : esp_matter_char_str(nullptr, 0)));
-            }
+            out = value_is_set ? esp_matter_char_str(val->char_string, strlen(val->char_string)) : esp_matter_char_str(nullptr, 0);
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
-            if (params->has_max_val_size) {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_long_char_str(params->val->val->char_string, strlen(params->val->val->char_string))
-                                                                  : (is_nullable ? esp_matter_long_char_str(nullptr, 0)
-                                                                     : esp_matter_long_char_str(nullptr, 0)),
-                                                                  params->max_val_size);
-            } else {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_long_char_str(params->val->val->char_string, strlen(params->val->val->char_string))
-                                                                  : (is_nullable ? esp_matter_long_char_str(nullptr, 0)
-                                                                     : esp_matter_long_char_str(nullptr, 0)));
-            }
+            out = value_is_set ? esp_matter_long_char_str(val->char_string, strlen(val->char_string))
+                  : esp_matter_long_char_str(nullptr, 0);
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_OCTET_STRING:
-            if (params->has_max_val_size) {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_octet_str(params->val->val->octet_string.data, params->val->val->octet_string.len)
-                                                                  : (is_nullable ? esp_matter_octet_str(nullptr, 0)
-                                                                     : esp_matter_octet_str(nullptr, 0)),
-                                                                  params->max_val_size);
-            } else {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_octet_str(params->val->val->octet_string.data, params->val->val->octet_string.len)
-                                                                  : (is_nullable ? esp_matter_octet_str(nullptr, 0)
-                                                                     : esp_matter_octet_str(nullptr, 0)));
-            }
+            out = value_is_set ? esp_matter_octet_str(val->octet_string.data, val->octet_string.len)
+                  : esp_matter_octet_str(nullptr, 0);
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
-            if (params->has_max_val_size) {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_long_octet_str(params->val->val->octet_string.data, params->val->val->octet_string.len)
-                                                                  : (is_nullable ? esp_matter_long_octet_str(nullptr, 0)
-                                                                     : esp_matter_long_octet_str(nullptr, 0)),
-                                                                  params->max_val_size);
-            } else {
-                created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                                  value_is_set ? esp_matter_long_octet_str(params->val->val->octet_string.data, params->val->val->octet_string.len)
-                                                                  : (is_nullable ? esp_matter_long_octet_str(nullptr, 0)
-                                                                     : esp_matter_long_octet_str(nullptr, 0)));
-            }
+            out = value_is_set ? esp_matter_long_octet_str(val->octet_string.data, val->octet_string.len)
+                  : esp_matter_long_octet_str(nullptr, 0);
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP8:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_bitmap8(params->val->val->u8)
-                                                                              : esp_matter_bitmap8(params->val->val->u8))
-                                                              : (is_nullable ? esp_matter_nullable_bitmap8(nullable<uint8_t>())
-                                                                 : esp_matter_bitmap8(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_bitmap8(val->u8) : esp_matter_bitmap8(val->u8))
+                  : (is_nullable ? esp_matter_nullable_bitmap8(nullable<uint8_t>()) : esp_matter_bitmap8(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP16:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_bitmap16(params->val->val->u16)
-                                                                              : esp_matter_bitmap16(params->val->val->u16))
-                                                              : (is_nullable ? esp_matter_nullable_bitmap16(nullable<uint16_t>())
-                                                                 : esp_matter_bitmap16(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_bitmap16(val->u16) : esp_matter_bitmap16(val->u16))
+                  : (is_nullable ? esp_matter_nullable_bitmap16(nullable<uint16_t>()) : esp_matter_bitmap16(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP32:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_bitmap32(params->val->val->u32)
-                                                                              : esp_matter_bitmap32(params->val->val->u32))
-                                                              : (is_nullable ? esp_matter_nullable_bitmap32(nullable<uint32_t>())
-                                                                 : esp_matter_bitmap32(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_bitmap32(val->u32) : esp_matter_bitmap32(val->u32))
+                  : (is_nullable ? esp_matter_nullable_bitmap32(nullable<uint32_t>()) : esp_matter_bitmap32(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ARRAY:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? esp_matter_array(params->val->val->a->elements.data, params->val->val->a->elements.len, params->val->val->a->n)
-                                                              : esp_matter_array(nullptr, 0, 0));
+            out = value_is_set ? esp_matter_array(val->a->elements.data, val->a->elements.len, val->a->n)
+                  : esp_matter_array(nullptr, 0, 0);
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM8:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_enum8(params->val->val->u8)
-                                                                              : esp_matter_enum8(params->val->val->u8))
-                                                              : (is_nullable ? esp_matter_nullable_enum8(nullable<uint8_t>())
-                                                                 : esp_matter_enum8(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_enum8(val->u8) : esp_matter_enum8(val->u8))
+                  : (is_nullable ? esp_matter_nullable_enum8(nullable<uint8_t>()) : esp_matter_enum8(0));
             break;
         case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM16:
-            created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id, params->flags,
-                                                              value_is_set ? (is_nullable ? esp_matter_nullable_enum16(params->val->val->u16)
-                                                                              : esp_matter_enum16(params->val->val->u16))
-                                                              : (is_nullable ? esp_matter_nullable_enum16(nullable<uint16_t>())
-                                                                 : esp_matter_enum16(0)));
+            out = value_is_set ? (is_nullable ? esp_matter_nullable_enum16(val->u16) : esp_matter_enum16(val->u16))
+                  : (is_nullable ? esp_matter_nullable_enum16(nullable<uint16_t>()) : esp_matter_enum16(0));
             break;
         default:
-            ESP_LOGE(TAG, "create_attribute: Unknown type");
             return ESP_ERR_INVALID_ARG;
         }
+        return ESP_OK;
+    }
 
-        if (!created_attribute) {
-            ESP_LOGE(TAG, "create_attribute: Failed to create attribute_id: %" PRIu32, params->attribute_id);
-            return ESP_ERR_NO_MEM;
+    /* Convert a serialized bound of an attribute of the given type into an esp_matter value. */
+    esp_err_t get_bounds_val(Datamodel__EspMatterValType value_type, bool is_nullable, const Datamodel__EspMatterVal *bound,
+                             esp_matter_attr_val_t &out)
+    {
+        switch (value_type) {
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT8:
+            out = is_nullable ? esp_matter_nullable_int8(bound->i8) : esp_matter_int8(bound->i8);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT8:
+            out = is_nullable ? esp_matter_nullable_uint8(bound->u8) : esp_matter_uint8(bound->u8);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT16:
+            out = is_nullable ? esp_matter_nullable_int16(bound->i16) : esp_matter_int16(bound->i16);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT16:
+            out = is_nullable ? esp_matter_nullable_uint16(bound->u16) : esp_matter_uint16(bound->u16);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT32:
+            out = is_nullable ? esp_matter_nullable_int32(bound->i32) : esp_matter_int32(bound->i32);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT32:
+            out = is_nullable ? esp_matter_nullable_uint32(bound->u32) : esp_matter_uint32(bound->u32);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT64:
+            out = is_nullable ? esp_matter_nullable_int64(bound->i64) : esp_matter_int64(bound->i64);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT64:
+            out = is_nullable ? esp_matter_nullable_uint64(bound->u64) : esp_matter_uint64(bound->u64);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM8:
+            out = is_nullable ? esp_matter_nullable_enum8(bound->u8) : esp_matter_enum8(bound->u8);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM16:
+            out = is_nullable ? esp_matter_nullable_enum16(bound->u16) : esp_matter_enum16(bound->u16);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP8:
+            out = is_nullable ? esp_matter_nullable_bitmap8(bound->u8) : esp_matter_bitmap8(bound->u8);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP16:
+            out = is_nullable ? esp_matter_nullable_bitmap16(bound->u16) : esp_matter_bitmap16(bound->u16);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP32:
+            out = is_nullable ? esp_matter_nullable_bitmap32(bound->u32) : esp_matter_bitmap32(bound->u32);
+            break;
+        default:
+            return ESP_ERR_INVALID_ARG;
         }
+        return ESP_OK;
+    }
 
-        if (created_attribute && value_is_set && params->bounds_min && params->bounds_max) {
-            esp_matter_attr_val_t min_val, max_val;
-            switch (value_type) {
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT8:
-                min_val = is_nullable ? esp_matter_nullable_int8(params->bounds_min->i8) : esp_matter_int8(params->bounds_min->i8);
-                max_val = is_nullable ? esp_matter_nullable_int8(params->bounds_max->i8) : esp_matter_int8(params->bounds_max->i8);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT8:
-                min_val = is_nullable ? esp_matter_nullable_uint8(params->bounds_min->u8) : esp_matter_uint8(params->bounds_min->u8);
-                max_val = is_nullable ? esp_matter_nullable_uint8(params->bounds_max->u8) : esp_matter_uint8(params->bounds_max->u8);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT16:
-                min_val = is_nullable ? esp_matter_nullable_int16(params->bounds_min->i16) : esp_matter_int16(params->bounds_min->i16);
-                max_val = is_nullable ? esp_matter_nullable_int16(params->bounds_max->i16) : esp_matter_int16(params->bounds_max->i16);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT16:
-                min_val = is_nullable ? esp_matter_nullable_uint16(params->bounds_min->u16) : esp_matter_uint16(params->bounds_min->u16);
-                max_val = is_nullable ? esp_matter_nullable_uint16(params->bounds_max->u16) : esp_matter_uint16(params->bounds_max->u16);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT32:
-                min_val = is_nullable ? esp_matter_nullable_int32(params->bounds_min->i32) : esp_matter_int32(params->bounds_min->i32);
-                max_val = is_nullable ? esp_matter_nullable_int32(params->bounds_max->i32) : esp_matter_int32(params->bounds_max->i32);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT32:
-                min_val = is_nullable ? esp_matter_nullable_uint32(params->bounds_min->u32) : esp_matter_uint32(params->bounds_min->u32);
-                max_val = is_nullable ? esp_matter_nullable_uint32(params->bounds_max->u32) : esp_matter_uint32(params->bounds_max->u32);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT64:
-                min_val = is_nullable ? esp_matter_nullable_int64(params->bounds_min->i64) : esp_matter_int64(params->bounds_min->i64);
-                max_val = is_nullable ? esp_matter_nullable_int64(params->bounds_max->i64) : esp_matter_int64(params->bounds_max->i64);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT64:
-                min_val = is_nullable ? esp_matter_nullable_uint64(params->bounds_min->u64) : esp_matter_uint64(params->bounds_min->u64);
-                max_val = is_nullable ? esp_matter_nullable_uint64(params->bounds_max->u64) : esp_matter_uint64(params->bounds_max->u64);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM8:
-                min_val = is_nullable ? esp_matter_nullable_enum8(params->bounds_min->u8) : esp_matter_enum8(params->bounds_min->u8);
-                max_val = is_nullable ? esp_matter_nullable_enum8(params->bounds_max->u8) : esp_matter_enum8(params->bounds_max->u8);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM16:
-                min_val = is_nullable ? esp_matter_nullable_enum16(params->bounds_min->u16) : esp_matter_enum16(params->bounds_min->u16);
-                max_val = is_nullable ? esp_matter_nullable_enum16(params->bounds_max->u16) : esp_matter_enum16(params->bounds_max->u16);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP8:
-                min_val = is_nullable ? esp_matter_nullable_bitmap8(params->bounds_min->u8) : esp_matter_bitmap8(params->bounds_min->u8);
-                max_val = is_nullable ? esp_matter_nullable_bitmap8(params->bounds_max->u8) : esp_matter_bitmap8(params->bounds_max->u8);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP16:
-                min_val = is_nullable ? esp_matter_nullable_bitmap16(params->bounds_min->u16) : esp_matter_bitmap16(params->bounds_min->u16);
-                max_val = is_nullable ? esp_matter_nullable_bitmap16(params->bounds_max->u16) : esp_matter_bitmap16(params->bounds_max->u16);
-                break;
-            case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP32:
-                min_val = is_nullable ? esp_matter_nullable_bitmap32(params->bounds_min->u32) : esp_matter_bitmap32(params->bounds_min->u32);
-                max_val = is_nullable ? esp_matter_nullable_bitmap32(params->bounds_max->u32) : esp_matter_bitmap32(params->bounds_max->u32);
-                break;
-            default:
-                ESP_LOGE(TAG, "create_bounds: Unknown bounds type");
-                return ESP_ERR_INVALID_ARG;
-            }
+    static bool is_string_type(Datamodel__EspMatterValType value_type)
+    {
+        return value_type == DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+               value_type == DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+               value_type == DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+               value_type == DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING;
+    }
 
-            esp_err_t bounds_result = esp_matter::attribute::add_bounds(created_attribute, min_val, max_val);
-            if (bounds_result != ESP_OK) {
-                ESP_LOGE(TAG, "create_attribute: Failed to add bounds for attribute_id: %" PRIu32, params->attribute_id);
-                return bounds_result;
-            }
+    esp_err_t define_value(const Datamodel__DefineValueParams *params)
+    {
+        // Indexes are dense and in order, so the pool is a plain vector.
+        if (params->index != value_pool.size() || !params->val) {
+            ESP_LOGE(TAG, "define_value: Expected value index %zu, got %" PRIu32, value_pool.size(), params->index);
+            return ESP_ERR_INVALID_ARG;
         }
 
+        PooledValue pooled = {};
+        pooled.val = *params->val;
+        pooled.data_offset = value_pool_data.size();
+        const uint8_t *data = nullptr;
+        switch (params->val->value_case) {
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING:
+            data = reinterpret_cast<const uint8_t *>(params->val->char_string);
+            pooled.data_size = strlen(params->val->char_string) + 1;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING:
+            data = params->val->octet_string.data;
+            pooled.data_size = params->val->octet_string.len;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_A:
+            data = params->val->a->elements.data;
+            pooled.data_size = params->val->a->elements.len;
+            pooled.array_count = params->val->a->n;
+            break;
+        default:
+            break;
+        }
+        if (data && pooled.data_size && value_pool_data.append(data, pooled.data_size) != ESP_OK) {
+            ESP_LOGE(TAG, "define_value: Failed to keep the %" PRIu32 " bytes of value %" PRIu32, pooled.data_size,
+                     params->index);
+            return ESP_ERR_NO_MEM;
+        }
+        value_pool.push_back(pooled);
         return ESP_OK;
     }
 
-    esp_err_t create_command(const Datamodel__CreateCommandParams *params)
+    esp_err_t resolve_pooled_value(uint32_t index, ResolvedValue &out)
     {
-        esp_err_t err = register_command_cb(current_cluster, params->cluster_id, params->command_id, params->flags);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "create_command: register_command_cb failed for cluster id: %" PRIu32 ", command id: %" PRIu32 ", error: %d",
-                     params->cluster_id, params->command_id, err);
+        if (index >= value_pool.size()) {
+            ESP_LOGE(TAG, "Value index %" PRIu32 " is not defined", index);
+            return ESP_ERR_INVALID_ARG;
         }
-        return err;
+
+        const PooledValue &pooled = value_pool[index];
+        uint8_t *data = value_pool_data.data() + pooled.data_offset;
+        out.val = pooled.val;
+        switch (pooled.val.value_case) {
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING:
+            out.val.char_string = reinterpret_cast<char *>(data);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING:
+            out.val.octet_string.data = data;
+            out.val.octet_string.len = pooled.data_size;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_A:
+            out.array = DATAMODEL__ESP_MATTER_ARRAY__INIT;
+            out.array.has_elements = true;
+            out.array.elements.data = data;
+            out.array.elements.len = pooled.data_size;
+            out.array.has_n = true;
+            out.array.n = pooled.array_count;
+            out.val.a = &out.array;
+            break;
+        default:
+            break;
+        }
+        value_pool_refs++;
+        return ESP_OK;
     }
 
-    esp_err_t create_event(const Datamodel__CreateEventParams *params)
+    esp_err_t get_attribute_values(const Datamodel__CreateAttributeParams *params, AttributeValues &out)
     {
-        if (esp_matter::event::create(current_cluster, params->event_id) == nullptr) {
-            ESP_LOGE(TAG, "create_event: Failed to create event with id: %" PRIu32, params->event_id);
-            return ESP_FAIL;
-        } else {
-            ESP_LOGD(TAG, "create_event: Created event with id: %" PRIu32 " on cluster", params->event_id);
-            return ESP_OK;
+        out.val = params->val;
+        out.bounds_min = params->bounds_min;
+        out.bounds_max = params->bounds_max;
+
+        if (params->has_val_ref) {
+            if (!params->val || resolve_pooled_value(params->val_ref, out.pooled_val) != ESP_OK) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            out.pooled_attr_val = *params->val;
+            out.pooled_attr_val.val = &out.pooled_val.val;
+            out.val = &out.pooled_attr_val;
+        }
+        if (params->has_bounds_min_ref) {
+            if (resolve_pooled_value(params->bounds_min_ref, out.pooled_bounds_min) != ESP_OK) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            out.bounds_min = &out.pooled_bounds_min.val;
+        }
+        if (params->has_bounds_max_ref) {
+            if (resolve_pooled_value(params->bounds_max_ref, out.pooled_bounds_max) != ESP_OK) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            out.bounds_max = &out.pooled_bounds_max.val;
         }
+        return ESP_OK;
     }
 
-    esp_err_t endpoint_add_device_type(const Datamodel__EndpointAddDeviceTypeParams *params)
+    void release_value_pool()
     {
-        if (esp_matter::endpoint::add_device_type(current_endpoint, params->device_type_id, params->device_type_version) != ESP_OK) {
-            ESP_LOGE(TAG, "endpoint_add_device_type: Failed to add device type to endpoint");
+        if (!value_pool.empty()) {
+            ESP_LOGI(TAG, "Value pool: %zu values (%zu payload bytes) referenced %zu times", value_pool.size(),
+                     value_pool_data.size(), value_pool_refs);
+        }
+        std::vector<PooledValue>().swap(value_pool);
+        value_pool_data.release();
+        value_pool_refs = 0;
+    }
+
+    esp_err_t create_attribute(const Datamodel__CreateAttributeParams *params)
+    {
+        if (!params) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        AttributeValues values;
+        if (get_attribute_values(params, values) != ESP_OK) {
+            ESP_LOGE(TAG, "create_attribute: Invalid value reference for attribute_id: %" PRIu32, params->attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        bool is_nullable = params->flags & esp_matter::ATTRIBUTE_FLAG_NULLABLE;
+
+        Datamodel__EspMatterValType value_type = values.val ? values.val->type : DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INVALID;
+        bool value_is_set = values.val && values.val->val && values.val->val->value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
+
+        esp_matter_attr_val_t val;
+        esp_err_t err = get_attr_val(values.val, is_nullable, val);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "create_attribute: Unknown type");
+            return err;
+        }
+
+        uint16_t flags = params->flags;
+        DeferredPayload deferred;
+        bool defer = false;
+        if (params->has_payload_size) {
+            if ((err = get_out_of_line_val(params, val, deferred, defer)) != ESP_OK) {
+                return err;
+            }
+            if (defer) {
+                flags |= esp_matter::ATTRIBUTE_FLAG_OVERRIDE;
+            }
+        }
+
+        // The maximum size only applies to string attributes.
+        uint16_t max_val_size = (is_string_type(value_type) && params->has_max_val_size) ? params->max_val_size : 0;
+        esp_matter::attribute_t *created_attribute = esp_matter::attribute::create(current_cluster, params->attribute_id,
+                                                                                   flags, val, max_val_size);
+        if (!created_attribute) {
+            ESP_LOGE(TAG, "create_attribute: Failed to create attribute_id: %" PRIu32, params->attribute_id);
+            return ESP_ERR_NO_MEM;
+        }
+
+        if (defer) {
+            err = esp_matter::attribute::set_override_callback(created_attribute, read_deferred);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "create_attribute: Failed to defer the payload of attribute_id: %" PRIu32, params->attribute_id);
+                return err;
+            }
+            deferred.endpoint_id = esp_matter::endpoint::get_id(current_endpoint);
+            add_deferred(deferred);
+        }
+
+        if (value_is_set && values.bounds_min && values.bounds_max) {
+            esp_matter_attr_val_t min_val, max_val;
+            if (get_bounds_val(value_type, is_nullable, values.bounds_min, min_val) != ESP_OK ||
+                get_bounds_val(value_type, is_nullable, values.bounds_max, max_val) != ESP_OK) {
+                ESP_LOGE(TAG, "create_bounds: Unknown bounds type");
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            esp_err_t bounds_result = esp_matter::attribute::add_bounds(created_attribute, min_val, max_val);
+            if (bounds_result != ESP_OK) {
+                ESP_LOGE(TAG, "create_attribute: Failed to add bounds for attribute_id: %" PRIu32, params->attribute_id);
+                return bounds_result;
+            }
+        }
+
+        index_attribute(esp_matter::endpoint::get_id(current_endpoint), params->cluster_id, params->attribute_id,
+                        created_attribute);
+        if (attribute_created_cb) {
+            attribute_created_cb(esp_matter::endpoint::get_id(current_endpoint), params->cluster_id, params->attribute_id,
+                                 attribute_created_arg);
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t create_command(const Datamodel__CreateCommandParams *params)
+    {
+        // Fails for the accepted commands of clusters without callbacks, e.g. vendor clusters. The command is
+        // left out, as before, but does not fail the data model.
+        esp_err_t err = register_command_cb(current_cluster, params->cluster_id, params->command_id, params->flags);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "create_command: No callback for cluster id: %" PRIu32 ", command id: %" PRIu32 ", error: %d",
+                     params->cluster_id, params->command_id, err);
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t create_event(const Datamodel__CreateEventParams *params)
+    {
+        if (esp_matter::event::create(current_cluster, params->event_id) == nullptr) {
+            ESP_LOGE(TAG, "create_event: Failed to create event with id: %" PRIu32, params->event_id);
+            return ESP_FAIL;
+        } else {
+            ESP_LOGD(TAG, "create_event: Created event with id: %" PRIu32 " on cluster", params->event_id);
+            return ESP_OK;
+        }
+    }
+
+    esp_err_t endpoint_add_device_type(const Datamodel__EndpointAddDeviceTypeParams *params)
+    {
+        if (esp_matter::endpoint::add_device_type(current_endpoint, params->device_type_id, params->device_type_version) != ESP_OK) {
+            ESP_LOGE(TAG, "endpoint_add_device_type: Failed to add device type to endpoint");
             return ESP_FAIL;
         } else {
             ESP_LOGD(TAG, "endpoint_add_device_type: Added device type id: %" PRIu32 " to endpoint", params->device_type_id);
@@ -419,7 +927,631 @@ public:
         }
     }
 
-    esp_matter::node_t* interpret_data(const uint8_t *data, size_t length)
+    esp_err_t remove_endpoint(const Datamodel__RemoveEndpointParams *params)
+    {
+        esp_matter::endpoint_t *endpoint = esp_matter::endpoint::get(raw_node, params->endpoint_id);
+        if (endpoint == nullptr) {
+            ESP_LOGE(TAG, "remove_endpoint: Endpoint with id: %" PRIu32 " not found", params->endpoint_id);
+            return ESP_ERR_NOT_FOUND;
+        }
+        if (endpoint == current_endpoint) {
+            current_endpoint = nullptr;
+            current_cluster = nullptr;
+        }
+        unindex_endpoint(params->endpoint_id);
+        forget_deferred_payloads(params->endpoint_id);
+        esp_err_t err = esp_matter::endpoint::destroy(raw_node, endpoint);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "remove_endpoint: Failed to remove endpoint with id: %" PRIu32 ", error: %d", params->endpoint_id, err);
+        } else {
+            ESP_LOGD(TAG, "remove_endpoint: Removed endpoint with id: %" PRIu32, params->endpoint_id);
+        }
+        return err;
+    }
+
+    esp_err_t update_attribute(const Datamodel__UpdateAttributeParams *params)
+    {
+        if (!params->val) {
+            ESP_LOGE(TAG, "update_attribute: Missing value type for attribute_id: %" PRIu32, params->attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        esp_matter::attribute_t *attribute = get_attribute(params->endpoint_id, params->cluster_id, params->attribute_id);
+        if (attribute == nullptr) {
+            ESP_LOGE(TAG, "update_attribute: Attribute_id: %" PRIu32 " not found in cluster id: %" PRIu32 " on endpoint id: %" PRIu32,
+                     params->attribute_id, params->cluster_id, params->endpoint_id);
+            return ESP_ERR_NOT_FOUND;
+        }
+
+        bool is_nullable = params->flags & esp_matter::ATTRIBUTE_FLAG_NULLABLE;
+        esp_err_t err = ESP_OK;
+
+        // Bounds first, so that the new value is checked against the new bounds.
+        if (params->bounds_min && params->bounds_max) {
+            esp_matter_attr_val_t min_val, max_val;
+            if (get_bounds_val(params->val->type, is_nullable, params->bounds_min, min_val) != ESP_OK ||
+                get_bounds_val(params->val->type, is_nullable, params->bounds_max, max_val) != ESP_OK) {
+                ESP_LOGE(TAG, "update_attribute: Unknown bounds type");
+                return ESP_ERR_INVALID_ARG;
+            }
+            err = esp_matter::attribute::add_bounds(attribute, min_val, max_val);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "update_attribute: Failed to update bounds for attribute_id: %" PRIu32, params->attribute_id);
+                return err;
+            }
+        }
+
+        if (params->val->val && params->val->val->value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET) {
+            esp_matter_attr_val_t val;
+            err = get_attr_val(params->val, is_nullable, val);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "update_attribute: Unknown type");
+                return err;
+            }
+            DeferredPayload *deferred = find_deferred(params->endpoint_id, params->cluster_id, params->attribute_id);
+            if (deferred) {
+                err = update_deferred(*deferred, val);
+            } else {
+                err = esp_matter::attribute::update(params->endpoint_id, params->cluster_id, params->attribute_id, &val);
+            }
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "update_attribute: Failed to update attribute_id: %" PRIu32 ", error: %d", params->attribute_id, err);
+            }
+        }
+        return err;
+    }
+
+    /* What the messages validated so far would have created. */
+    struct Validation {
+        bool delta;
+        bool has_endpoint;
+        bool has_cluster;
+        uint32_t endpoint_id;
+        uint32_t cluster_id;
+        size_t endpoints;
+        std::vector<uint8_t> pool_cases;  // value field of each pooled value
+        size_t payload_section_size;
+        size_t messages;
+    };
+
+    static esp_err_t validate_value(const char *what, uint32_t attribute_id, Datamodel__EspMatterValType type,
+                                    Datamodel__EspMatterVal__ValueCase value_case)
+    {
+        Datamodel__EspMatterVal__ValueCase expected = value_case_for_type(type);
+        if (expected == DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET) {
+            ESP_LOGE(TAG, "%s: Unknown type %d for attribute_id: %" PRIu32, what, type, attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET && value_case != expected) {
+            ESP_LOGE(TAG, "%s: Value field %d does not match type %d for attribute_id: %" PRIu32, what, value_case, type,
+                     attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        return ESP_OK;
+    }
+
+    static esp_err_t validate_endpoint(const char *what, uint32_t endpoint_id, const Validation &state)
+    {
+        if (!state.has_endpoint || endpoint_id != state.endpoint_id) {
+            ESP_LOGE(TAG, "%s: Endpoint id: %" PRIu32 " is not the endpoint being created", what, endpoint_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        return ESP_OK;
+    }
+
+    static esp_err_t validate_cluster(const char *what, uint32_t endpoint_id, uint32_t cluster_id, const Validation &state)
+    {
+        esp_err_t err = validate_endpoint(what, endpoint_id, state);
+        if (err == ESP_OK && (!state.has_cluster || cluster_id != state.cluster_id)) {
+            ESP_LOGE(TAG, "%s: Cluster id: %" PRIu32 " is not the cluster being created", what, cluster_id);
+            err = ESP_ERR_INVALID_ARG;
+        }
+        return err;
+    }
+
+    static esp_err_t validate_ref(uint32_t attribute_id, uint32_t ref, const Validation &state)
+    {
+        if (ref >= state.pool_cases.size()) {
+            ESP_LOGE(TAG, "create_attribute: Value index %" PRIu32 " is not defined for attribute_id: %" PRIu32, ref,
+                     attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t validate_attribute(const Datamodel__CreateAttributeParams *params, const Validation &state)
+    {
+        esp_err_t err = validate_cluster("create_attribute", params->endpoint_id, params->cluster_id, state);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (!params->val) {
+            ESP_LOGE(TAG, "create_attribute: Missing value type for attribute_id: %" PRIu32, params->attribute_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        Datamodel__EspMatterVal__ValueCase value_case =
+            params->val->val ? params->val->val->value_case : DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
+        if (params->has_val_ref) {
+            if ((err = validate_ref(params->attribute_id, params->val_ref, state)) != ESP_OK) {
+                return err;
+            }
+            value_case = static_cast<Datamodel__EspMatterVal__ValueCase>(state.pool_cases[params->val_ref]);
+        }
+        if ((params->has_bounds_min_ref && (err = validate_ref(params->attribute_id, params->bounds_min_ref, state)) != ESP_OK) ||
+            (params->has_bounds_max_ref && (err = validate_ref(params->attribute_id, params->bounds_max_ref, state)) != ESP_OK)) {
+            return err;
+        }
+        if ((err = validate_value("create_attribute", params->attribute_id, params->val->type, value_case)) != ESP_OK) {
+            return err;
+        }
+        if (params->has_payload_size) {
+            // Strings have no value and arrays only their count, the payload is in the payload section.
+            Datamodel__EspMatterVal__ValueCase payload_case = value_case_for_type(params->val->type);
+            // value_case may come from the pool, the elements are only checked in the message itself.
+            const Datamodel__EspMatterVal *inline_val = params->val->val;
+            bool has_elements = inline_val && inline_val->value_case == DATAMODEL__ESP_MATTER_VAL__VALUE_A &&
+                                inline_val->a->has_elements;
+            if ((payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING &&
+                 payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING && payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_A) ||
+                (value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET && value_case != DATAMODEL__ESP_MATTER_VAL__VALUE_A) ||
+                has_elements || params->has_val_ref) {
+                ESP_LOGE(TAG, "create_attribute: Payload reference with a value for attribute_id: %" PRIu32, params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (!params->has_payload_offset || !params->has_payload_crc32 || params->payload_size == 0 ||
+                params->payload_size > UINT16_MAX || params->payload_offset > state.payload_section_size ||
+                params->payload_size > state.payload_section_size - params->payload_offset) {
+                ESP_LOGE(TAG, "create_attribute: Payload reference outside of the payload section for attribute_id: %" PRIu32,
+                         params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+
+        // Bounds are only added to attributes with a value, and only exist for numeric types.
+        bool has_bounds = (params->bounds_min || params->has_bounds_min_ref) && (params->bounds_max || params->has_bounds_max_ref);
+        if (value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET && has_bounds) {
+            Datamodel__EspMatterVal bound = DATAMODEL__ESP_MATTER_VAL__INIT;
+            esp_matter_attr_val_t unused;
+            if (get_bounds_val(params->val->type, false, &bound, unused) != ESP_OK) {
+                ESP_LOGE(TAG, "create_attribute: Bounds on type %d for attribute_id: %" PRIu32, params->val->type,
+                         params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t validate_message(const Datamodel__FunctionCall *message, Validation &state)
+    {
+        esp_err_t err = ESP_OK;
+
+        switch (message->params_case) {
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DEFINE_VALUE_PARAMS: {
+            const Datamodel__DefineValueParams *params = message->define_value_params;
+            if (params->index != state.pool_cases.size() || !params->val) {
+                ESP_LOGE(TAG, "define_value: Expected value index %zu, got %" PRIu32, state.pool_cases.size(), params->index);
+                return ESP_ERR_INVALID_ARG;
+            }
+            state.pool_cases.push_back(static_cast<uint8_t>(params->val->value_case));
+            break;
+        }
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DECLARE_PAYLOADS_PARAMS:
+            if (state.delta || state.messages != 0) {
+                ESP_LOGE(TAG, "declare_payloads: Only allowed as the first message of a data model binary");
+                return ESP_ERR_INVALID_ARG;
+            }
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ENDPOINT_PARAMS:
+            state.has_endpoint = true;
+            state.has_cluster = false;
+            state.endpoint_id = message->create_endpoint_params->endpoint_id;
+            state.endpoints++;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS:
+            err = validate_endpoint("endpoint_add_device_type", message->endpoint_add_device_type_params->endpoint_id, state);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_CLUSTER_PARAMS:
+            err = validate_endpoint("create_cluster", message->create_cluster_params->endpoint_id, state);
+            state.has_cluster = err == ESP_OK;
+            state.cluster_id = message->create_cluster_params->cluster_id;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ATTRIBUTE_PARAMS:
+            err = validate_attribute(message->create_attribute_params, state);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_COMMAND_PARAMS:
+            err = validate_cluster("create_command", message->create_command_params->endpoint_id,
+                                   message->create_command_params->cluster_id, state);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_EVENT_PARAMS:
+            err = validate_cluster("create_event", message->create_event_params->endpoint_id,
+                                   message->create_event_params->cluster_id, state);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_REMOVE_ENDPOINT_PARAMS:
+            if (!state.delta) {
+                ESP_LOGE(TAG, "remove_endpoint: Only allowed in a delta");
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (state.has_endpoint && state.endpoint_id == message->remove_endpoint_params->endpoint_id) {
+                state.has_endpoint = false;
+                state.has_cluster = false;
+            }
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_UPDATE_ATTRIBUTE_PARAMS: {
+            const Datamodel__UpdateAttributeParams *params = message->update_attribute_params;
+            if (!state.delta) {
+                ESP_LOGE(TAG, "update_attribute: Only allowed in a delta");
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (!params->val) {
+                ESP_LOGE(TAG, "update_attribute: Missing value type for attribute_id: %" PRIu32, params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+            err = validate_value("update_attribute", params->attribute_id, params->val->type,
+                                 params->val->val ? params->val->val->value_case : DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET);
+            break;
+        }
+        default:
+            ESP_LOGE(TAG, "Unknown params");
+            err = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        return err;
+    }
+
+    /* Check the message against the ones checked before it, then count it. */
+    esp_err_t check_message(const Datamodel__FunctionCall *message, Validation &state)
+    {
+        esp_err_t err = validate_message(message, state);
+        state.messages++;
+        return err;
+    }
+
+    esp_err_t check_complete(const Validation &state)
+    {
+        if (!state.delta && state.endpoints == 0) {
+            ESP_LOGE(TAG, "The data model has no endpoint");
+            return ESP_ERR_INVALID_ARG;
+        }
+        return ESP_OK;
+    }
+
+    /*
+     * Decode and check every message of a delta before anything is changed: the framing, the order
+     * of the messages, the endpoint, cluster and value references and the value fields of each type.
+     * A data model binary is checked while it is interpreted instead, see interpret_data().
+     */
+    esp_err_t validate_delta(const uint8_t *data, size_t length)
+    {
+        Validation state = {true, false, false, 0, 0, 0, {}, 0, 0};
+        esp_err_t err = process_messages(data, length, true, [this, &state](const Datamodel__FunctionCall *message) {
+            return check_message(message, state);
+        });
+        return err == ESP_OK ? check_complete(state) : err;
+    }
+
+    /* Tear down the node after a failure, so that another data model can be interpreted. */
+    void destroy_node()
+    {
+        esp_err_t err = esp_matter::node::destroy();
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to destroy the partly created node, error: %d", err);
+        }
+        clear_attribute_index();
+        clear_deferred_payloads();
+        raw_node = nullptr;
+        current_endpoint = nullptr;
+        current_cluster = nullptr;
+    }
+
+    /*
+     * Decode the length-prefixed message at offset and advance offset past it.
+     * The message is allocated with allocator, or from the heap if it is nullptr.
+     */
+    esp_err_t decode_message(const uint8_t *data, size_t length, size_t &offset, size_t message_index,
+                             Datamodel__FunctionCall *&message, ProtobufCAllocator *allocator = nullptr)
+    {
+        size_t prefix_len = 0;
+        size_t msg_len = 0;
+        FramingError framing_err = scan_length_prefixed_data(length - offset, &data[offset], prefix_len, msg_len);
+        if (framing_err != FramingError::None) {
+            ESP_LOGE(TAG, "Failed to read length-prefixed data at index %zu: %s", message_index,
+                     framing_error_str(framing_err));
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        message = datamodel__function_call__unpack(allocator, msg_len, &data[offset + prefix_len]);
+        if (!message) {
+            ESP_LOGE(TAG, "Failed to unpack message at index %zu", message_index);
+            return ESP_ERR_INVALID_ARG;
+        }
+        offset += prefix_len + msg_len;
+        return ESP_OK;
+    }
+
+    /*
+     * Decode the length-prefixed messages in data and pass them to handler in order.
+     * Returns an error if the framing is broken, or on the first failing message if stop_on_error is set.
+     */
+    template <typename Handler>
+    esp_err_t process_messages(const uint8_t *data, size_t length, bool stop_on_error, Handler handler)
+    {
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+        esp_err_t pipelined_err = ESP_OK;
+        if (process_messages_pipelined(data, length, stop_on_error, handler, pipelined_err)) {
+            return pipelined_err;
+        }
+#endif
+        size_t offset = 0;
+        size_t message_index = 0;
+        while (offset < length) {
+            // Messages are handled one at a time, so they are all decoded into the same arena.
+            Datamodel__FunctionCall *message = nullptr;
+            esp_err_t err = decode_message(data, length, offset, message_index, message, decode_arena.allocator());
+            if (err != ESP_OK) {
+                decode_arena.reset();
+                return err;
+            }
+
+            err = handler(message);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to handle function call for message at index %zu, error: %d", message_index, err);
+            }
+
+            decode_arena.reset();
+            if (err != ESP_OK && stop_on_error) {
+                return err;
+            }
+            message_index++;
+        }
+        return ESP_OK;
+    }
+
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+    /* State shared by the decode task and the task applying the messages. A null message ends the stream. */
+    struct DecodePipeline {
+        Impl *impl;
+        const uint8_t *data;
+        size_t length;
+        SpscRing<Datamodel__FunctionCall *, CONFIG_DM_INTERPRETER_DECODE_RING_SIZE> ring;
+        SemaphoreHandle_t message_ready;
+        SemaphoreHandle_t space_ready;
+        SemaphoreHandle_t decoder_done;
+        std::atomic<bool> cancel{false};
+        esp_err_t decode_err = ESP_OK;
+    };
+
+    static void decode_task(void *arg)
+    {
+        DecodePipeline *pipeline = static_cast<DecodePipeline *>(arg);
+        size_t offset = 0;
+        size_t message_index = 0;
+        esp_err_t err = ESP_OK;
+        Datamodel__FunctionCall *message = nullptr;
+
+        while (offset < pipeline->length && !pipeline->cancel.load(std::memory_order_relaxed)) {
+            err = pipeline->impl->decode_message(pipeline->data, pipeline->length, offset, message_index, message,
+                                                 &pipeline->impl->pipeline_allocator);
+            if (err != ESP_OK) {
+                break;
+            }
+            while (!pipeline->ring.push(message)) {
+                xSemaphoreTake(pipeline->space_ready, portMAX_DELAY);
+            }
+            xSemaphoreGive(pipeline->message_ready);
+            message_index++;
+        }
+
+        // Published by the release in push(), before the end of the stream is seen.
+        pipeline->decode_err = err;
+        while (!pipeline->ring.push(nullptr)) {
+            xSemaphoreTake(pipeline->space_ready, portMAX_DELAY);
+        }
+        xSemaphoreGive(pipeline->message_ready);
+
+        // The pipeline belongs to the applying task, do not touch it after this.
+        xSemaphoreGive(pipeline->decoder_done);
+        vTaskDelete(nullptr);
+    }
+
+    /*
+     * Decode on the other core while handler runs in the calling task.
+     * Returns false, without having processed anything, if the decode task cannot be started.
+     */
+    template <typename Handler>
+    bool process_messages_pipelined(const uint8_t *data, size_t length, bool stop_on_error, Handler handler, esp_err_t &result)
+    {
+        DecodePipeline pipeline;
+        pipeline.impl = this;
+        pipeline.data = data;
+        pipeline.length = length;
+        pipeline.message_ready = xSemaphoreCreateBinary();
+        pipeline.space_ready = xSemaphoreCreateBinary();
+        pipeline.decoder_done = xSemaphoreCreateBinary();
+
+        bool started = pipeline.message_ready && pipeline.space_ready && pipeline.decoder_done &&
+                       xTaskCreatePinnedToCore(decode_task, "dm_decode", CONFIG_DM_INTERPRETER_DECODE_TASK_STACK_SIZE, &pipeline,
+                                               uxTaskPriorityGet(nullptr), nullptr, xPortGetCoreID() == 0 ? 1 : 0) == pdPASS;
+        if (!started) {
+            ESP_LOGW(TAG, "Failed to start the decode task, decoding on the calling task");
+        } else {
+            result = ESP_OK;
+            size_t message_index = 0;
+            Datamodel__FunctionCall *message = nullptr;
+            while (true) {
+                while (!pipeline.ring.pop(message)) {
+                    xSemaphoreTake(pipeline.message_ready, portMAX_DELAY);
+                }
+                xSemaphoreGive(pipeline.space_ready);
+                if (message == nullptr) {
+                    break;
+                }
+
+                // After a stop, the remaining messages are only freed.
+                if (result == ESP_OK) {
+                    esp_err_t err = handler(message);
+                    if (err != ESP_OK) {
+                        ESP_LOGE(TAG, "Failed to handle function call for message at index %zu, error: %d", message_index, err);
+                        if (stop_on_error) {
+                            result = err;
+                            pipeline.cancel.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                }
+                datamodel__function_call__free_unpacked(message, &pipeline_allocator);
+                message_index++;
+            }
+            xSemaphoreTake(pipeline.decoder_done, portMAX_DELAY);
+            if (result == ESP_OK) {
+                result = pipeline.decode_err;
+            }
+        }
+
+        if (pipeline.message_ready) {
+            vSemaphoreDelete(pipeline.message_ready);
+        }
+        if (pipeline.space_ready) {
+            vSemaphoreDelete(pipeline.space_ready);
+        }
+        if (pipeline.decoder_done) {
+            vSemaphoreDelete(pipeline.decoder_done);
+        }
+        return started;
+    }
+#endif // CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+
+    /* A value from the static tables in the form of a decoded message. */
+    static void get_static_val(const static_model::Value &value, ResolvedValue &out)
+    {
+        out.val = DATAMODEL__ESP_MATTER_VAL__INIT;
+        out.val.value_case = static_cast<Datamodel__EspMatterVal__ValueCase>(value.field);
+        switch (out.val.value_case) {
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_B:
+            out.val.b = value.bits != 0;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_F: {
+            uint32_t bits = static_cast<uint32_t>(value.bits);
+            memcpy(&out.val.f, &bits, sizeof(out.val.f));
+            break;
+        }
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_I64:
+            out.val.i64 = static_cast<int64_t>(value.bits);
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_U64:
+            out.val.u64 = value.bits;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING:
+            out.val.char_string = static_cast<char *>(const_cast<void *>(value.data));
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING:
+            out.val.octet_string.data = static_cast<uint8_t *>(const_cast<void *>(value.data));
+            out.val.octet_string.len = value.size;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE_A:
+            out.array = DATAMODEL__ESP_MATTER_ARRAY__INIT;
+            out.array.has_elements = true;
+            out.array.elements.data = static_cast<uint8_t *>(const_cast<void *>(value.data));
+            out.array.elements.len = value.size;
+            out.array.has_n = true;
+            out.array.n = value.count;
+            out.val.a = &out.array;
+            break;
+        case DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET:
+            break;
+        default:
+            // All the other fields are 32-bit integers sharing the same storage.
+            out.val.u32 = static_cast<uint32_t>(value.bits);
+            break;
+        }
+    }
+
+    esp_err_t create_static_attribute(uint16_t endpoint_id, uint32_t cluster_id, const static_model::Attribute &attribute)
+    {
+        ResolvedValue val, bounds_min, bounds_max;
+        Datamodel__EspMatterAttrVal attr_val = DATAMODEL__ESP_MATTER_ATTR_VAL__INIT;
+        attr_val.has_type = true;
+        attr_val.type = static_cast<Datamodel__EspMatterValType>(attribute.type);
+        if (attribute.val) {
+            get_static_val(*attribute.val, val);
+            attr_val.val = &val.val;
+        }
+
+        Datamodel__CreateAttributeParams params = DATAMODEL__CREATE_ATTRIBUTE_PARAMS__INIT;
+        params.endpoint_id = endpoint_id;
+        params.cluster_id = cluster_id;
+        params.attribute_id = attribute.id;
+        params.flags = attribute.flags;
+        params.val = &attr_val;
+        params.has_max_val_size = attribute.max_val_size != 0;
+        params.max_val_size = attribute.max_val_size;
+        if (attribute.bounds_min && attribute.bounds_max) {
+            get_static_val(*attribute.bounds_min, bounds_min);
+            get_static_val(*attribute.bounds_max, bounds_max);
+            params.bounds_min = &bounds_min.val;
+            params.bounds_max = &bounds_max.val;
+        }
+        return create_attribute(&params);
+    }
+
+    /* Create the endpoint from the static tables through the same handlers as the messages of a binary. */
+    esp_err_t create_static_endpoint(const static_model::Endpoint &endpoint)
+    {
+        Datamodel__CreateEndpointParams endpoint_params = DATAMODEL__CREATE_ENDPOINT_PARAMS__INIT;
+        endpoint_params.endpoint_id = endpoint.id;
+        endpoint_params.flags = endpoint.flags;
+        esp_err_t err = create_endpoint(&endpoint_params);
+        if (err != ESP_OK) {
+            return err;
+        }
+
+        for (uint16_t i = 0; i < endpoint.device_type_count; i++) {
+            Datamodel__EndpointAddDeviceTypeParams params = DATAMODEL__ENDPOINT_ADD_DEVICE_TYPE_PARAMS__INIT;
+            params.endpoint_id = endpoint.id;
+            params.device_type_id = endpoint.device_types[i].id;
+            params.device_type_version = endpoint.device_types[i].version;
+            if ((err = endpoint_add_device_type(&params)) != ESP_OK) {
+                return err;
+            }
+        }
+
+        for (uint16_t i = 0; i < endpoint.cluster_count; i++) {
+            const static_model::Cluster &cluster = endpoint.clusters[i];
+            Datamodel__CreateClusterParams cluster_params = DATAMODEL__CREATE_CLUSTER_PARAMS__INIT;
+            cluster_params.endpoint_id = endpoint.id;
+            cluster_params.cluster_id = cluster.id;
+            cluster_params.flags = cluster.flags;
+            if ((err = create_cluster(&cluster_params)) != ESP_OK) {
+                return err;
+            }
+
+            for (uint16_t j = 0; j < cluster.attribute_count; j++) {
+                if ((err = create_static_attribute(endpoint.id, cluster.id, cluster.attributes[j])) != ESP_OK) {
+                    return err;
+                }
+            }
+            for (uint16_t j = 0; j < cluster.command_count; j++) {
+                Datamodel__CreateCommandParams params = DATAMODEL__CREATE_COMMAND_PARAMS__INIT;
+                params.endpoint_id = endpoint.id;
+                params.cluster_id = cluster.id;
+                params.command_id = cluster.commands[j].id;
+                params.flags = cluster.commands[j].flags;
+                if ((err = create_command(&params)) != ESP_OK) {
+                    return err;
+                }
+            }
+            for (uint16_t j = 0; j < cluster.event_count; j++) {
+                Datamodel__CreateEventParams params = DATAMODEL__CREATE_EVENT_PARAMS__INIT;
+                params.endpoint_id = endpoint.id;
+                params.cluster_id = cluster.id;
+                params.event_id = cluster.events[j];
+                if ((err = create_event(&params)) != ESP_OK) {
+                    return err;
+                }
+            }
+        }
+        return ESP_OK;
+    }
+
+    esp_matter::node_t* interpret_static(const static_model::Model &model)
     {
         raw_node = esp_matter::node::create_raw();
         if (raw_node == nullptr) {
@@ -427,40 +1559,411 @@ public:
             return nullptr;
         }
 
-        size_t offset = 0;
-        size_t message_index = 0;
-        while (offset < length) {
-            size_t prefix_len = 0;
-            size_t total_len = scan_length_prefixed_data(length - offset, &data[offset], &prefix_len);
+        int64_t start_time = esp_timer_get_time();
+        clear_attribute_index();
+        heap_accounting::start();
+        esp_err_t err = ESP_OK;
+        for (uint16_t i = 0; i < model.endpoint_count && err == ESP_OK; i++) {
+            // Like interpret_data(), the first failure discards the whole node.
+            err = create_static_endpoint(model.endpoints[i]);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to create endpoint with id: %u from the static model, error: %d", model.endpoints[i].id, err);
+            }
+        }
+        heap_accounting::finish();
+        if (err != ESP_OK) {
+            destroy_node();
+            return nullptr;
+        }
+        ESP_LOGI(TAG, "Created %u endpoints from the static model in %" PRId64 " us", model.endpoint_count,
+                 esp_timer_get_time() - start_time);
+        log_attribute_index();
+        return raw_node;
+    }
+
+    esp_matter::node_t* interpret_data(const uint8_t *data, size_t length)
+    {
+        current_endpoint = nullptr;
+        current_cluster = nullptr;
 
-            if (total_len == 0 || prefix_len == 0) {
-                ESP_LOGE(TAG, "Failed to read length-prefixed data");
+        int64_t start_time = esp_timer_get_time();
+        // The messages are followed by the payload section, if the first message declares one.
+        size_t messages_size = length;
+        bool has_valid_section = messages_length(data, length, messages_size, decode_arena.allocator());
+        decode_arena.reset();
+        if (!has_valid_section) {
+            ESP_LOGE(TAG, "The payload section is larger than the data model binary, no node created");
+            return nullptr;
+        }
+        if (payload_source && messages_size < length) {
+            // The payloads are read later from this binary, even once another one is active.
+            esp_err_t pin_err = payload_source->pin(data, length);
+            if (pin_err != ESP_OK) {
+                ESP_LOGE(TAG, "The payload source cannot read this data model binary (error: %d), no node created",
+                         pin_err);
                 return nullptr;
             }
+        }
 
-            size_t msg_len = total_len - prefix_len;
-            if (offset + total_len > length) {
-                ESP_LOGE(TAG, "Message length exceeds buffer");
-                return nullptr;
+        raw_node = esp_matter::node::create_raw();
+        if (raw_node == nullptr) {
+            ESP_LOGE(TAG, "Failed to create raw node");
+            return nullptr;
+        }
+
+        clear_attribute_index();
+        clear_deferred_payloads();
+        payload_section = data + messages_size;
+        payload_section_offset = messages_size;
+        payload_section_size = length - messages_size;
+        heap_accounting::start();
+#if CONFIG_DM_INTERPRETER_VALIDATE
+        // Each message is checked before it is applied, in the same decode pass; the first invalid
+        // message fails the interpretation and the node is destroyed below.
+        Validation state = {false, false, false, 0, 0, 0, {}, payload_section_size, 0};
+        esp_err_t err = process_messages(data, messages_size, true, [this, &state](const Datamodel__FunctionCall *message) {
+            esp_err_t check_err = check_message(message, state);
+            return check_err == ESP_OK ? handle_function_call(message) : check_err;
+        });
+        if (err == ESP_OK) {
+            err = check_complete(state);
+        }
+#else
+        esp_err_t err = process_messages(data, messages_size, true, [this](const Datamodel__FunctionCall *message) {
+            return handle_function_call(message);
+        });
+#endif
+        heap_accounting::finish();
+        release_value_pool();
+        payload_section = nullptr;
+        payload_section_offset = 0;
+        payload_section_size = 0;
+        if (err != ESP_OK) {
+            // Nothing of a failed data model is kept, the caller can fall back to another one.
+            ESP_LOGE(TAG, "Failed to interpret the data model (error: %d), node destroyed", err);
+            destroy_node();
+            return nullptr;
+        }
+        // Compare with CONFIG_DM_INTERPRETER_PIPELINED_DECODE enabled and disabled to measure the boot time gained.
+        ESP_LOGI(TAG, "Interpreted %zu bytes in %" PRId64 " us (%s decode)", length, esp_timer_get_time() - start_time,
+                 DECODE_MODE);
+        log_attribute_index();
+        log_deferred_payloads();
+        return raw_node;
+    }
+
+    esp_err_t apply_delta(const uint8_t *data, size_t length)
+    {
+        if (raw_node == nullptr) {
+            ESP_LOGE(TAG, "apply_delta: No node, interpret_data() has to be called first");
+            return ESP_ERR_INVALID_STATE;
+        }
+#if CONFIG_DM_INTERPRETER_VALIDATE
+        // A malformed delta is rejected before it touches the node.
+        esp_err_t validate_err = validate_delta(data, length);
+        if (validate_err != ESP_OK) {
+            ESP_LOGE(TAG, "apply_delta: Invalid delta, the node is unchanged");
+            return validate_err;
+        }
+#endif
+
+        // Hold the stack lock for the whole delta, so that controllers see one consistent change.
+        esp_matter::lock::ScopedChipStackLock lock(portMAX_DELAY);
+
+        applying_delta = true;
+        current_endpoint = nullptr;
+        current_cluster = nullptr;
+        delta_endpoints.clear();
+
+        esp_err_t err = process_messages(data, length, true, [this](const Datamodel__FunctionCall *message) {
+            return handle_function_call(message);
+        });
+        applying_delta = false;
+        release_value_pool();
+
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "apply_delta: Failed, the node is partially updated (error: %d)", err);
+        } else if (esp_matter::is_started()) {
+            // Endpoints created after the stack has started are only exposed once they are complete.
+            for (esp_matter::endpoint_t *endpoint : delta_endpoints) {
+                err = esp_matter::endpoint::enable(endpoint);
+                if (err != ESP_OK) {
+                    ESP_LOGE(TAG, "apply_delta: Failed to enable endpoint with id: %u", esp_matter::endpoint::get_id(endpoint));
+                    break;
+                }
             }
+        }
+        delta_endpoints.clear();
+        return err;
+    }
 
-            Datamodel__FunctionCall *message = datamodel__function_call__unpack(nullptr, msg_len, &data[offset + prefix_len]);
-            if (!message) {
-                ESP_LOGE(TAG, "Failed to unpack message at index %zu", message_index);
-                return nullptr;
+    /* Decoded form of an endpoint shape, instantiated without touching protobuf again. */
+    enum class ShapeRecordType : uint8_t {
+        DeviceType,
+        Cluster,
+        Attribute,
+        Command,
+        Event,
+    };
+
+    struct ShapeRecord {
+        ShapeRecordType type;
+        uint16_t flags;
+        uint32_t id;
+        uint32_t arg;          // device type version, or max_val_size for attributes
+        uint32_t value_index;  // index into EndpointShape::values for attributes
+    };
+
+    struct ShapeValue {
+        esp_matter_attr_val_t val;
+        esp_matter_attr_val_t min_val;
+        esp_matter_attr_val_t max_val;
+        bool has_bounds;
+        bool has_data;         // val points into EndpointShape::data
+        uint32_t data_offset;
+    };
+
+    struct EndpointShape {
+        uint8_t endpoint_flags;
+        std::vector<ShapeRecord> records;
+        std::vector<ShapeValue> values;
+        allocator_policy::Buffer data;  // string and array payloads
+    };
+
+    std::vector<EndpointShape> shapes;
+
+    static bool has_data_pointer(esp_matter_val_type_t type)
+    {
+        return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+               type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+               type == ESP_MATTER_VAL_TYPE_ARRAY;
+    }
+
+    esp_err_t record_shape_message(EndpointShape &shape, bool &has_endpoint, const Datamodel__FunctionCall *message)
+    {
+        ShapeRecord record = {};
+
+        switch (message->params_case) {
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DEFINE_VALUE_PARAMS:
+            return define_value(message->define_value_params);
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ENDPOINT_PARAMS:
+            if (has_endpoint) {
+                ESP_LOGE(TAG, "register_shape: A shape describes a single endpoint");
+                return ESP_ERR_INVALID_ARG;
             }
+            has_endpoint = true;
+            shape.endpoint_flags = message->create_endpoint_params->flags;
+            return ESP_OK;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS:
+            record.type = ShapeRecordType::DeviceType;
+            record.id = message->endpoint_add_device_type_params->device_type_id;
+            record.arg = message->endpoint_add_device_type_params->device_type_version;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_CLUSTER_PARAMS:
+            record.type = ShapeRecordType::Cluster;
+            record.id = message->create_cluster_params->cluster_id;
+            record.flags = message->create_cluster_params->flags;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_COMMAND_PARAMS:
+            record.type = ShapeRecordType::Command;
+            record.id = message->create_command_params->command_id;
+            record.flags = message->create_command_params->flags;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_EVENT_PARAMS:
+            record.type = ShapeRecordType::Event;
+            record.id = message->create_event_params->event_id;
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ATTRIBUTE_PARAMS: {
+            const Datamodel__CreateAttributeParams *params = message->create_attribute_params;
+            if (params->has_payload_size) {
+                ESP_LOGE(TAG, "register_shape: Out-of-line payloads are not supported in shapes");
+                return ESP_ERR_INVALID_ARG;
+            }
+            AttributeValues values;
+            if (get_attribute_values(params, values) != ESP_OK) {
+                ESP_LOGE(TAG, "register_shape: Invalid value reference for attribute_id: %" PRIu32, params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+            bool is_nullable = params->flags & esp_matter::ATTRIBUTE_FLAG_NULLABLE;
+            Datamodel__EspMatterValType value_type = values.val ? values.val->type : DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INVALID;
+            bool value_is_set = values.val && values.val->val && values.val->val->value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
 
-            esp_err_t err = handle_function_call(message);
+            ShapeValue value = {};
+            if (get_attr_val(values.val, is_nullable, value.val) != ESP_OK) {
+                ESP_LOGE(TAG, "register_shape: Unknown type for attribute_id: %" PRIu32, params->attribute_id);
+                return ESP_ERR_INVALID_ARG;
+            }
+            // The message is freed after this call, so keep a copy of any payload the value points to.
+            if (has_data_pointer(value.val.type) && value.val.val.a.b && value.val.val.a.s) {
+                value.has_data = true;
+                value.data_offset = shape.data.size();
+                if (shape.data.append(value.val.val.a.b, value.val.val.a.s) != ESP_OK) {
+                    ESP_LOGE(TAG, "register_shape: Failed to keep the value of attribute_id: %" PRIu32, params->attribute_id);
+                    return ESP_ERR_NO_MEM;
+                }
+            }
+            if (value_is_set && values.bounds_min && values.bounds_max) {
+                if (get_bounds_val(value_type, is_nullable, values.bounds_min, value.min_val) != ESP_OK ||
+                    get_bounds_val(value_type, is_nullable, values.bounds_max, value.max_val) != ESP_OK) {
+                    ESP_LOGE(TAG, "register_shape: Unknown bounds type");
+                    return ESP_ERR_INVALID_ARG;
+                }
+                value.has_bounds = true;
+            }
+
+            record.type = ShapeRecordType::Attribute;
+            record.id = params->attribute_id;
+            record.flags = params->flags;
+            record.arg = (is_string_type(value_type) && params->has_max_val_size) ? params->max_val_size : 0;
+            record.value_index = shape.values.size();
+            shape.values.push_back(value);
+            break;
+        }
+        default:
+            ESP_LOGE(TAG, "register_shape: Unsupported message in shape");
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        if (!has_endpoint) {
+            ESP_LOGE(TAG, "register_shape: A shape has to start with the endpoint");
+            return ESP_ERR_INVALID_ARG;
+        }
+        shape.records.push_back(record);
+        return ESP_OK;
+    }
+
+    esp_err_t register_shape(const uint8_t *data, size_t length, uint16_t &shape_id)
+    {
+        EndpointShape shape = {};
+        shape.data = allocator_policy::Buffer(policy, allocator_policy::Usage::Payload);
+        bool has_endpoint = false;
+        esp_err_t err = process_messages(data, length, true, [&](const Datamodel__FunctionCall *message) {
+            return record_shape_message(shape, has_endpoint, message);
+        });
+        release_value_pool();
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (!has_endpoint) {
+            ESP_LOGE(TAG, "register_shape: No endpoint in shape");
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        shape.records.shrink_to_fit();
+        shape.values.shrink_to_fit();
+        shape.data.shrink_to_fit();
+        shape_id = shapes.size();
+        shapes.push_back(std::move(shape));
+        ESP_LOGD(TAG, "register_shape: Registered shape %u with %zu records", shape_id, shapes.back().records.size());
+        return ESP_OK;
+    }
+
+    esp_err_t instantiate_shape(const EndpointShape &shape, esp_matter::endpoint_t *&endpoint)
+    {
+        endpoint = esp_matter::endpoint::create(raw_node, shape.endpoint_flags | esp_matter::ENDPOINT_FLAG_DESTROYABLE, nullptr);
+        if (endpoint == nullptr) {
+            ESP_LOGE(TAG, "instantiate: Failed to create endpoint");
+            return ESP_FAIL;
+        }
+
+        esp_matter::cluster_t *cluster = nullptr;
+        uint32_t cluster_id = 0;
+        for (const ShapeRecord &record : shape.records) {
+            esp_err_t err = ESP_OK;
+            switch (record.type) {
+            case ShapeRecordType::DeviceType:
+                err = esp_matter::endpoint::add_device_type(endpoint, record.id, record.arg);
+                break;
+            case ShapeRecordType::Cluster:
+                cluster = esp_matter::cluster::create(endpoint, record.id, record.flags);
+                cluster_id = record.id;
+                if (!cluster) {
+                    err = ESP_FAIL;
+                } else if (cluster_plugin_init(cluster, record.id) != ESP_OK) {
+                    // Like create_cluster(), a cluster without a plugin works without one.
+                    ESP_LOGW(TAG, "instantiate: No plugin for cluster id: %" PRIu32, record.id);
+                }
+                break;
+            case ShapeRecordType::Attribute: {
+                const ShapeValue &value = shape.values[record.value_index];
+                esp_matter_attr_val_t val = value.val;
+                if (value.has_data) {
+                    val.val.a.b = const_cast<uint8_t *>(shape.data.data()) + value.data_offset;
+                }
+                esp_matter::attribute_t *attribute = esp_matter::attribute::create(cluster, record.id, record.flags, val, record.arg);
+                if (!attribute) {
+                    err = ESP_ERR_NO_MEM;
+                } else if (value.has_bounds) {
+                    err = esp_matter::attribute::add_bounds(attribute, value.min_val, value.max_val);
+                }
+                if (err == ESP_OK) {
+                    index_attribute(esp_matter::endpoint::get_id(endpoint), cluster_id, record.id, attribute);
+                }
+                if (err == ESP_OK && attribute_created_cb) {
+                    attribute_created_cb(esp_matter::endpoint::get_id(endpoint), cluster_id, record.id,
+                                         attribute_created_arg);
+                }
+                break;
+            }
+            case ShapeRecordType::Command:
+                // Like create_command(), a command without a callback is left out.
+                if (register_command_cb(cluster, cluster_id, record.id, record.flags) != ESP_OK) {
+                    ESP_LOGW(TAG, "instantiate: No callback for cluster id: %" PRIu32 ", command id: %" PRIu32, cluster_id,
+                             record.id);
+                }
+                break;
+            case ShapeRecordType::Event:
+                err = esp_matter::event::create(cluster, record.id) ? ESP_OK : ESP_FAIL;
+                break;
+            }
             if (err != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to handle function call for message at index %zu, error: %d", message_index, err);
+                ESP_LOGE(TAG, "instantiate: Failed to create id: %" PRIu32 " on endpoint id: %u, error: %d", record.id,
+                         esp_matter::endpoint::get_id(endpoint), err);
+                return err;
             }
+        }
+        return ESP_OK;
+    }
 
-            datamodel__function_call__free_unpacked(message, nullptr);
-            offset += total_len;
-            message_index++;
+    esp_err_t instantiate(uint16_t shape_id, size_t count, std::vector<uint16_t> *endpoint_ids)
+    {
+        if (raw_node == nullptr) {
+            ESP_LOGE(TAG, "instantiate: No node, interpret_data() has to be called first");
+            return ESP_ERR_INVALID_STATE;
+        }
+        if (shape_id >= shapes.size()) {
+            ESP_LOGE(TAG, "instantiate: Unknown shape %u", shape_id);
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (endpoint_ids) {
+            endpoint_ids->reserve(endpoint_ids->size() + count);
         }
 
-        return raw_node;
+        // Create the whole batch under one stack lock, like a delta.
+        esp_matter::lock::ScopedChipStackLock lock(portMAX_DELAY);
+
+        const EndpointShape &shape = shapes[shape_id];
+        bool started = esp_matter::is_started();
+        for (size_t i = 0; i < count; i++) {
+            esp_matter::endpoint_t *endpoint = nullptr;
+            esp_err_t err = instantiate_shape(shape, endpoint);
+            if (err == ESP_OK && started) {
+                err = esp_matter::endpoint::enable(endpoint);
+            }
+            if (err != ESP_OK) {
+                // Do not leave a half-built endpoint behind.
+                if (endpoint) {
+                    unindex_endpoint(esp_matter::endpoint::get_id(endpoint));
+                    esp_matter::endpoint::destroy(raw_node, endpoint);
+                }
+                ESP_LOGE(TAG, "instantiate: Created %zu of %zu endpoints", i, count);
+                return err;
+            }
+            if (endpoint_ids) {
+                endpoint_ids->push_back(esp_matter::endpoint::get_id(endpoint));
+            }
+        }
+        return ESP_OK;
     }
 };
 
@@ -468,7 +1971,9 @@ public:
 // Public Interface API //
 //////////////////////////
 
-Interpreter::Interpreter() : pimpl_(std::make_unique<Impl>()) {}
+Interpreter::Interpreter() : pimpl_(std::make_unique<Impl>(allocator_policy::default_policy())) {}
+
+Interpreter::Interpreter(allocator_policy::Policy &policy) : pimpl_(std::make_unique<Impl>(policy)) {}
 
 Interpreter::~Interpreter() = default;
 
@@ -477,4 +1982,75 @@ esp_matter::node_t* Interpreter::interpret_data(const uint8_t *data, size_t leng
     return pimpl_->interpret_data(data, length);
 }
 
+esp_matter::node_t* Interpreter::interpret_static(const static_model::Model &model)
+{
+    return pimpl_->interpret_static(model);
+}
+
+esp_err_t Interpreter::apply_delta(const uint8_t *data, size_t length)
+{
+    return pimpl_->apply_delta(data, length);
+}
+
+esp_err_t Interpreter::register_shape(const uint8_t *data, size_t length, uint16_t &shape_id)
+{
+    return pimpl_->register_shape(data, length, shape_id);
+}
+
+esp_err_t Interpreter::instantiate(uint16_t shape_id, size_t count, std::vector<uint16_t> *endpoint_ids)
+{
+    return pimpl_->instantiate(shape_id, count, endpoint_ids);
+}
+
+void Interpreter::set_attribute_created_callback(AttributeCreatedCallback callback, void *arg)
+{
+    pimpl_->attribute_created_cb = callback;
+    pimpl_->attribute_created_arg = arg;
+}
+
+void Interpreter::set_endpoint_removed_callback(EndpointRemovedCallback callback, void *arg)
+{
+    pimpl_->endpoint_removed_cb = callback;
+    pimpl_->endpoint_removed_arg = arg;
+}
+
+esp_matter::attribute_t *Interpreter::get_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+{
+    return pimpl_->get_attribute(endpoint_id, cluster_id, attribute_id);
+}
+
+Interpreter::AttributeIndexStats Interpreter::attribute_index_stats() const
+{
+#if CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX
+    return {pimpl_->attribute_index.size(), pimpl_->attribute_index.capacity(), pimpl_->attribute_index.memory_bytes()};
+#else
+    return {0, 0, 0};
+#endif
+}
+
+void Interpreter::forget_endpoint(uint16_t endpoint_id)
+{
+    pimpl_->unindex_endpoint(endpoint_id);
+    pimpl_->forget_deferred_payloads(endpoint_id);
+}
+
+void Interpreter::set_payload_source(IPayloadSource *source)
+{
+    pimpl_->payload_source = source;
+}
+
+Interpreter::DeferredPayloadStats Interpreter::deferred_payload_stats() const
+{
+    DeferredPayloadStats stats = {pimpl_->deferred_payloads.size(), 0, 0, 0, pimpl_->deferred_failures};
+    for (const Impl::DeferredPayload &entry : pimpl_->deferred_payloads) {
+        if (entry.data) {
+            stats.loaded++;
+            stats.loaded_bytes += entry.size;
+        } else {
+            stats.deferred_bytes += entry.size;
+        }
+    }
+    return stats;
+}
+
 } // namespace esp_matter_data_model_interpreter
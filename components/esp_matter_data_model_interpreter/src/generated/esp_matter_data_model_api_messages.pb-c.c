@@ -412,6 +412,186 @@ void   datamodel__endpoint_add_device_type_params__free_unpacked
   assert(message->base.descriptor == &datamodel__endpoint_add_device_type_params__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   datamodel__remove_endpoint_params__init
+                     (Datamodel__RemoveEndpointParams         *message)
+{
+  static const Datamodel__RemoveEndpointParams init_value = DATAMODEL__REMOVE_ENDPOINT_PARAMS__INIT;
+  *message = init_value;
+}
+size_t datamodel__remove_endpoint_params__get_packed_size
+                     (const Datamodel__RemoveEndpointParams *message)
+{
+  assert(message->base.descriptor == &datamodel__remove_endpoint_params__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t datamodel__remove_endpoint_params__pack
+                     (const Datamodel__RemoveEndpointParams *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &datamodel__remove_endpoint_params__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t datamodel__remove_endpoint_params__pack_to_buffer
+                     (const Datamodel__RemoveEndpointParams *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &datamodel__remove_endpoint_params__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Datamodel__RemoveEndpointParams *
+       datamodel__remove_endpoint_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Datamodel__RemoveEndpointParams *)
+     protobuf_c_message_unpack (&datamodel__remove_endpoint_params__descriptor,
+                                allocator, len, data);
+}
+void   datamodel__remove_endpoint_params__free_unpacked
+                     (Datamodel__RemoveEndpointParams *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &datamodel__remove_endpoint_params__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   datamodel__update_attribute_params__init
+                     (Datamodel__UpdateAttributeParams         *message)
+{
+  static const Datamodel__UpdateAttributeParams init_value = DATAMODEL__UPDATE_ATTRIBUTE_PARAMS__INIT;
+  *message = init_value;
+}
+size_t datamodel__update_attribute_params__get_packed_size
+                     (const Datamodel__UpdateAttributeParams *message)
+{
+  assert(message->base.descriptor == &datamodel__update_attribute_params__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t datamodel__update_attribute_params__pack
+                     (const Datamodel__UpdateAttributeParams *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &datamodel__update_attribute_params__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t datamodel__update_attribute_params__pack_to_buffer
+                     (const Datamodel__UpdateAttributeParams *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &datamodel__update_attribute_params__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Datamodel__UpdateAttributeParams *
+       datamodel__update_attribute_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Datamodel__UpdateAttributeParams *)
+     protobuf_c_message_unpack (&datamodel__update_attribute_params__descriptor,
+                                allocator, len, data);
+}
+void   datamodel__update_attribute_params__free_unpacked
+                     (Datamodel__UpdateAttributeParams *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &datamodel__update_attribute_params__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   datamodel__define_value_params__init
+                     (Datamodel__DefineValueParams         *message)
+{
+  static const Datamodel__DefineValueParams init_value = DATAMODEL__DEFINE_VALUE_PARAMS__INIT;
+  *message = init_value;
+}
+size_t datamodel__define_value_params__get_packed_size
+                     (const Datamodel__DefineValueParams *message)
+{
+  assert(message->base.descriptor == &datamodel__define_value_params__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t datamodel__define_value_params__pack
+                     (const Datamodel__DefineValueParams *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &datamodel__define_value_params__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t datamodel__define_value_params__pack_to_buffer
+                     (const Datamodel__DefineValueParams *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &datamodel__define_value_params__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Datamodel__DefineValueParams *
+       datamodel__define_value_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Datamodel__DefineValueParams *)
+     protobuf_c_message_unpack (&datamodel__define_value_params__descriptor,
+                                allocator, len, data);
+}
+void   datamodel__define_value_params__free_unpacked
+                     (Datamodel__DefineValueParams *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &datamodel__define_value_params__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   datamodel__declare_payloads_params__init
+                     (Datamodel__DeclarePayloadsParams         *message)
+{
+  static const Datamodel__DeclarePayloadsParams init_value = DATAMODEL__DECLARE_PAYLOADS_PARAMS__INIT;
+  *message = init_value;
+}
+size_t datamodel__declare_payloads_params__get_packed_size
+                     (const Datamodel__DeclarePayloadsParams *message)
+{
+  assert(message->base.descriptor == &datamodel__declare_payloads_params__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t datamodel__declare_payloads_params__pack
+                     (const Datamodel__DeclarePayloadsParams *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &datamodel__declare_payloads_params__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t datamodel__declare_payloads_params__pack_to_buffer
+                     (const Datamodel__DeclarePayloadsParams *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &datamodel__declare_payloads_params__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+Datamodel__DeclarePayloadsParams *
+       datamodel__declare_payloads_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (Datamodel__DeclarePayloadsParams *)
+     protobuf_c_message_unpack (&datamodel__declare_payloads_params__descriptor,
+                                allocator, len, data);
+}
+void   datamodel__declare_payloads_params__free_unpacked
+                     (Datamodel__DeclarePayloadsParams *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &datamodel__declare_payloads_params__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 void   datamodel__function_call__init
                      (Datamodel__FunctionCall         *message)
 {
@@ -792,7 +972,7 @@ const ProtobufCMessageDescriptor datamodel__esp_matter_attr_val__descriptor =
   (ProtobufCMessageInit) datamodel__esp_matter_attr_val__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor datamodel__create_attribute_params__field_descriptors[8] =
+static const ProtobufCFieldDescriptor datamodel__create_attribute_params__field_descriptors[14] =
 {
   {
     "endpoint_id",
@@ -890,21 +1070,99 @@ static const ProtobufCFieldDescriptor datamodel__create_attribute_params__field_
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "val_ref",
+    9,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_val_ref),
+    offsetof(Datamodel__CreateAttributeParams, val_ref),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds_min_ref",
+    10,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_bounds_min_ref),
+    offsetof(Datamodel__CreateAttributeParams, bounds_min_ref),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds_max_ref",
+    11,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_bounds_max_ref),
+    offsetof(Datamodel__CreateAttributeParams, bounds_max_ref),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "payload_offset",
+    12,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_payload_offset),
+    offsetof(Datamodel__CreateAttributeParams, payload_offset),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "payload_size",
+    13,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_payload_size),
+    offsetof(Datamodel__CreateAttributeParams, payload_size),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "payload_crc32",
+    14,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__CreateAttributeParams, has_payload_crc32),
+    offsetof(Datamodel__CreateAttributeParams, payload_crc32),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned datamodel__create_attribute_params__field_indices_by_name[] = {
   2,   /* field[2] = attribute_id */
   7,   /* field[7] = bounds_max */
+  10,   /* field[10] = bounds_max_ref */
   6,   /* field[6] = bounds_min */
+  9,   /* field[9] = bounds_min_ref */
   1,   /* field[1] = cluster_id */
   0,   /* field[0] = endpoint_id */
   3,   /* field[3] = flags */
   5,   /* field[5] = max_val_size */
+  13,   /* field[13] = payload_crc32 */
+  11,   /* field[11] = payload_offset */
+  12,   /* field[12] = payload_size */
   4,   /* field[4] = val */
+  8,   /* field[8] = val_ref */
 };
 static const ProtobufCIntRange datamodel__create_attribute_params__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 8 }
+  { 0, 14 }
 };
 const ProtobufCMessageDescriptor datamodel__create_attribute_params__descriptor =
 {
@@ -914,7 +1172,7 @@ const ProtobufCMessageDescriptor datamodel__create_attribute_params__descriptor
   "Datamodel__CreateAttributeParams",
   "datamodel",
   sizeof(Datamodel__CreateAttributeParams),
-  8,
+  14,
   datamodel__create_attribute_params__field_descriptors,
   datamodel__create_attribute_params__field_indices_by_name,
   1,  datamodel__create_attribute_params__number_ranges,
@@ -1241,7 +1499,250 @@ const ProtobufCMessageDescriptor datamodel__endpoint_add_device_type_params__des
   (ProtobufCMessageInit) datamodel__endpoint_add_device_type_params__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCEnumValue datamodel__function_call__function_type__enum_values_by_number[6] =
+static const ProtobufCFieldDescriptor datamodel__remove_endpoint_params__field_descriptors[1] =
+{
+  {
+    "endpoint_id",
+    1,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__RemoveEndpointParams, has_endpoint_id),
+    offsetof(Datamodel__RemoveEndpointParams, endpoint_id),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned datamodel__remove_endpoint_params__field_indices_by_name[] = {
+  0,   /* field[0] = endpoint_id */
+};
+static const ProtobufCIntRange datamodel__remove_endpoint_params__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor datamodel__remove_endpoint_params__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "datamodel.RemoveEndpointParams",
+  "RemoveEndpointParams",
+  "Datamodel__RemoveEndpointParams",
+  "datamodel",
+  sizeof(Datamodel__RemoveEndpointParams),
+  1,
+  datamodel__remove_endpoint_params__field_descriptors,
+  datamodel__remove_endpoint_params__field_indices_by_name,
+  1,  datamodel__remove_endpoint_params__number_ranges,
+  (ProtobufCMessageInit) datamodel__remove_endpoint_params__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor datamodel__update_attribute_params__field_descriptors[7] =
+{
+  {
+    "endpoint_id",
+    1,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__UpdateAttributeParams, has_endpoint_id),
+    offsetof(Datamodel__UpdateAttributeParams, endpoint_id),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "cluster_id",
+    2,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__UpdateAttributeParams, has_cluster_id),
+    offsetof(Datamodel__UpdateAttributeParams, cluster_id),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "attribute_id",
+    3,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__UpdateAttributeParams, has_attribute_id),
+    offsetof(Datamodel__UpdateAttributeParams, attribute_id),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "flags",
+    4,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__UpdateAttributeParams, has_flags),
+    offsetof(Datamodel__UpdateAttributeParams, flags),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "val",
+    5,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    0,   /* quantifier_offset */
+    offsetof(Datamodel__UpdateAttributeParams, val),
+    &datamodel__esp_matter_attr_val__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds_min",
+    6,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    0,   /* quantifier_offset */
+    offsetof(Datamodel__UpdateAttributeParams, bounds_min),
+    &datamodel__esp_matter_val__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "bounds_max",
+    7,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    0,   /* quantifier_offset */
+    offsetof(Datamodel__UpdateAttributeParams, bounds_max),
+    &datamodel__esp_matter_val__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned datamodel__update_attribute_params__field_indices_by_name[] = {
+  2,   /* field[2] = attribute_id */
+  6,   /* field[6] = bounds_max */
+  5,   /* field[5] = bounds_min */
+  1,   /* field[1] = cluster_id */
+  0,   /* field[0] = endpoint_id */
+  3,   /* field[3] = flags */
+  4,   /* field[4] = val */
+};
+static const ProtobufCIntRange datamodel__update_attribute_params__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 7 }
+};
+const ProtobufCMessageDescriptor datamodel__update_attribute_params__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "datamodel.UpdateAttributeParams",
+  "UpdateAttributeParams",
+  "Datamodel__UpdateAttributeParams",
+  "datamodel",
+  sizeof(Datamodel__UpdateAttributeParams),
+  7,
+  datamodel__update_attribute_params__field_descriptors,
+  datamodel__update_attribute_params__field_indices_by_name,
+  1,  datamodel__update_attribute_params__number_ranges,
+  (ProtobufCMessageInit) datamodel__update_attribute_params__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor datamodel__define_value_params__field_descriptors[2] =
+{
+  {
+    "index",
+    1,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__DefineValueParams, has_index),
+    offsetof(Datamodel__DefineValueParams, index),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "val",
+    2,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    0,   /* quantifier_offset */
+    offsetof(Datamodel__DefineValueParams, val),
+    &datamodel__esp_matter_val__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned datamodel__define_value_params__field_indices_by_name[] = {
+  0,   /* field[0] = index */
+  1,   /* field[1] = val */
+};
+static const ProtobufCIntRange datamodel__define_value_params__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 2 }
+};
+const ProtobufCMessageDescriptor datamodel__define_value_params__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "datamodel.DefineValueParams",
+  "DefineValueParams",
+  "Datamodel__DefineValueParams",
+  "datamodel",
+  sizeof(Datamodel__DefineValueParams),
+  2,
+  datamodel__define_value_params__field_descriptors,
+  datamodel__define_value_params__field_indices_by_name,
+  1,  datamodel__define_value_params__number_ranges,
+  (ProtobufCMessageInit) datamodel__define_value_params__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor datamodel__declare_payloads_params__field_descriptors[1] =
+{
+  {
+    "size",
+    1,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_UINT32,
+    offsetof(Datamodel__DeclarePayloadsParams, has_size),
+    offsetof(Datamodel__DeclarePayloadsParams, size),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned datamodel__declare_payloads_params__field_indices_by_name[] = {
+  0,   /* field[0] = size */
+};
+static const ProtobufCIntRange datamodel__declare_payloads_params__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor datamodel__declare_payloads_params__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "datamodel.DeclarePayloadsParams",
+  "DeclarePayloadsParams",
+  "Datamodel__DeclarePayloadsParams",
+  "datamodel",
+  sizeof(Datamodel__DeclarePayloadsParams),
+  1,
+  datamodel__declare_payloads_params__field_descriptors,
+  datamodel__declare_payloads_params__field_indices_by_name,
+  1,  datamodel__declare_payloads_params__number_ranges,
+  (ProtobufCMessageInit) datamodel__declare_payloads_params__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCEnumValue datamodel__function_call__function_type__enum_values_by_number[10] =
 {
   { "CREATE_ATTRIBUTE", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_ATTRIBUTE", 1 },
   { "CREATE_COMMAND", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_COMMAND", 2 },
@@ -1249,18 +1750,26 @@ static const ProtobufCEnumValue datamodel__function_call__function_type__enum_va
   { "CREATE_CLUSTER", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_CLUSTER", 4 },
   { "CREATE_ENDPOINT", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_ENDPOINT", 5 },
   { "ENDPOINT_ADD_DEVICE_TYPE", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__ENDPOINT_ADD_DEVICE_TYPE", 6 },
+  { "REMOVE_ENDPOINT", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__REMOVE_ENDPOINT", 7 },
+  { "UPDATE_ATTRIBUTE", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__UPDATE_ATTRIBUTE", 8 },
+  { "DEFINE_VALUE", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__DEFINE_VALUE", 9 },
+  { "DECLARE_PAYLOADS", "DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__DECLARE_PAYLOADS", 10 },
 };
 static const ProtobufCIntRange datamodel__function_call__function_type__value_ranges[] = {
-{1, 0},{0, 6}
+{1, 0},{0, 10}
 };
-static const ProtobufCEnumValueIndex datamodel__function_call__function_type__enum_values_by_name[6] =
+static const ProtobufCEnumValueIndex datamodel__function_call__function_type__enum_values_by_name[10] =
 {
   { "CREATE_ATTRIBUTE", 0 },
   { "CREATE_CLUSTER", 3 },
   { "CREATE_COMMAND", 1 },
   { "CREATE_ENDPOINT", 4 },
   { "CREATE_EVENT", 2 },
+  { "DECLARE_PAYLOADS", 9 },
+  { "DEFINE_VALUE", 8 },
   { "ENDPOINT_ADD_DEVICE_TYPE", 5 },
+  { "REMOVE_ENDPOINT", 6 },
+  { "UPDATE_ATTRIBUTE", 7 },
 };
 const ProtobufCEnumDescriptor datamodel__function_call__function_type__descriptor =
 {
@@ -1269,15 +1778,15 @@ const ProtobufCEnumDescriptor datamodel__function_call__function_type__descripto
   "FunctionType",
   "Datamodel__FunctionCall__FunctionType",
   "datamodel",
-  6,
+  10,
   datamodel__function_call__function_type__enum_values_by_number,
-  6,
+  10,
   datamodel__function_call__function_type__enum_values_by_name,
   1,
   datamodel__function_call__function_type__value_ranges,
   NULL,NULL,NULL,NULL   /* reserved[1234] */
 };
-static const ProtobufCFieldDescriptor datamodel__function_call__field_descriptors[7] =
+static const ProtobufCFieldDescriptor datamodel__function_call__field_descriptors[11] =
 {
   {
     "function",
@@ -1363,6 +1872,54 @@ static const ProtobufCFieldDescriptor datamodel__function_call__field_descriptor
     PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "remove_endpoint_params",
+    8,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Datamodel__FunctionCall, params_case),
+    offsetof(Datamodel__FunctionCall, remove_endpoint_params),
+    &datamodel__remove_endpoint_params__descriptor,
+    NULL,
+    PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "update_attribute_params",
+    9,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Datamodel__FunctionCall, params_case),
+    offsetof(Datamodel__FunctionCall, update_attribute_params),
+    &datamodel__update_attribute_params__descriptor,
+    NULL,
+    PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "define_value_params",
+    10,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Datamodel__FunctionCall, params_case),
+    offsetof(Datamodel__FunctionCall, define_value_params),
+    &datamodel__define_value_params__descriptor,
+    NULL,
+    PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "declare_payloads_params",
+    11,
+    PROTOBUF_C_LABEL_OPTIONAL,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Datamodel__FunctionCall, params_case),
+    offsetof(Datamodel__FunctionCall, declare_payloads_params),
+    &datamodel__declare_payloads_params__descriptor,
+    NULL,
+    PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned datamodel__function_call__field_indices_by_name[] = {
   1,   /* field[1] = create_attribute_params */
@@ -1370,13 +1927,17 @@ static const unsigned datamodel__function_call__field_indices_by_name[] = {
   2,   /* field[2] = create_command_params */
   5,   /* field[5] = create_endpoint_params */
   3,   /* field[3] = create_event_params */
+  10,   /* field[10] = declare_payloads_params */
+  9,   /* field[9] = define_value_params */
   6,   /* field[6] = endpoint_add_device_type_params */
   0,   /* field[0] = function */
+  7,   /* field[7] = remove_endpoint_params */
+  8,   /* field[8] = update_attribute_params */
 };
 static const ProtobufCIntRange datamodel__function_call__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 7 }
+  { 0, 11 }
 };
 const ProtobufCMessageDescriptor datamodel__function_call__descriptor =
 {
@@ -1386,7 +1947,7 @@ const ProtobufCMessageDescriptor datamodel__function_call__descriptor =
   "Datamodel__FunctionCall",
   "datamodel",
   sizeof(Datamodel__FunctionCall),
-  7,
+  11,
   datamodel__function_call__field_descriptors,
   datamodel__function_call__field_indices_by_name,
   1,  datamodel__function_call__number_ranges,
@@ -24,6 +24,10 @@ typedef struct Datamodel__CreateEventParams Datamodel__CreateEventParams;
 typedef struct Datamodel__CreateClusterParams Datamodel__CreateClusterParams;
 typedef struct Datamodel__CreateEndpointParams Datamodel__CreateEndpointParams;
 typedef struct Datamodel__EndpointAddDeviceTypeParams Datamodel__EndpointAddDeviceTypeParams;
+typedef struct Datamodel__RemoveEndpointParams Datamodel__RemoveEndpointParams;
+typedef struct Datamodel__UpdateAttributeParams Datamodel__UpdateAttributeParams;
+typedef struct Datamodel__DefineValueParams Datamodel__DefineValueParams;
+typedef struct Datamodel__DeclarePayloadsParams Datamodel__DeclarePayloadsParams;
 typedef struct Datamodel__FunctionCall Datamodel__FunctionCall;
 
 
@@ -35,7 +39,11 @@ typedef enum _Datamodel__FunctionCall__FunctionType {
   DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_EVENT = 3,
   DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_CLUSTER = 4,
   DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__CREATE_ENDPOINT = 5,
-  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__ENDPOINT_ADD_DEVICE_TYPE = 6
+  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__ENDPOINT_ADD_DEVICE_TYPE = 6,
+  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__REMOVE_ENDPOINT = 7,
+  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__UPDATE_ATTRIBUTE = 8,
+  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__DEFINE_VALUE = 9,
+  DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE__DECLARE_PAYLOADS = 10
     PROTOBUF_C__FORCE_ENUM_TO_BE_INT_SIZE(DATAMODEL__FUNCTION_CALL__FUNCTION_TYPE)
 } Datamodel__FunctionCall__FunctionType;
 /*
@@ -185,11 +193,30 @@ struct  Datamodel__CreateAttributeParams
   protobuf_c_boolean has_max_val_size;
   uint32_t max_val_size;
   Datamodel__EspMatterVal *bounds_min;
+  /*
+   * Indexes into the value pool (see DefineValueParams), used instead of val.val, bounds_min and bounds_max
+   */
   Datamodel__EspMatterVal *bounds_max;
+  protobuf_c_boolean has_val_ref;
+  uint32_t val_ref;
+  protobuf_c_boolean has_bounds_min_ref;
+  uint32_t bounds_min_ref;
+  /*
+   * Value payload in the payload section (see DeclarePayloadsParams), used instead of the payload of val.val.
+   * The offset is from the start of the section, the CRC-32 is the one of zlib.crc32.
+   */
+  protobuf_c_boolean has_bounds_max_ref;
+  uint32_t bounds_max_ref;
+  protobuf_c_boolean has_payload_offset;
+  uint32_t payload_offset;
+  protobuf_c_boolean has_payload_size;
+  uint32_t payload_size;
+  protobuf_c_boolean has_payload_crc32;
+  uint32_t payload_crc32;
 };
 #define DATAMODEL__CREATE_ATTRIBUTE_PARAMS__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&datamodel__create_attribute_params__descriptor) \
-, 0, 0, 0, 0, 0, 0, 0, 0, NULL, 0, 0, NULL, NULL }
+, 0, 0, 0, 0, 0, 0, 0, 0, NULL, 0, 0, NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
 
 
 struct  Datamodel__CreateCommandParams
@@ -276,6 +303,70 @@ struct  Datamodel__EndpointAddDeviceTypeParams
 , 0, 0, 0, 0, 0, 0 }
 
 
+struct  Datamodel__RemoveEndpointParams
+{
+  ProtobufCMessage base;
+  protobuf_c_boolean has_endpoint_id;
+  uint32_t endpoint_id;
+};
+#define DATAMODEL__REMOVE_ENDPOINT_PARAMS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&datamodel__remove_endpoint_params__descriptor) \
+, 0, 0 }
+
+
+/*
+ * Changes the value and/or bounds of an existing attribute
+ */
+struct  Datamodel__UpdateAttributeParams
+{
+  ProtobufCMessage base;
+  protobuf_c_boolean has_endpoint_id;
+  uint32_t endpoint_id;
+  protobuf_c_boolean has_cluster_id;
+  uint32_t cluster_id;
+  protobuf_c_boolean has_attribute_id;
+  uint32_t attribute_id;
+  protobuf_c_boolean has_flags;
+  uint32_t flags;
+  Datamodel__EspMatterAttrVal *val;
+  Datamodel__EspMatterVal *bounds_min;
+  Datamodel__EspMatterVal *bounds_max;
+};
+#define DATAMODEL__UPDATE_ATTRIBUTE_PARAMS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&datamodel__update_attribute_params__descriptor) \
+, 0, 0, 0, 0, 0, 0, 0, 0, NULL, NULL, NULL }
+
+
+/*
+ * Adds a value to the pool, so that values repeated in the data model are only stored once
+ */
+struct  Datamodel__DefineValueParams
+{
+  ProtobufCMessage base;
+  protobuf_c_boolean has_index;
+  uint32_t index;
+  Datamodel__EspMatterVal *val;
+};
+#define DATAMODEL__DEFINE_VALUE_PARAMS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&datamodel__define_value_params__descriptor) \
+, 0, 0, NULL }
+
+
+/*
+ * Declares the payload section: the last size bytes of the binary hold attribute payloads, not messages.
+ * Only allowed as the first message of a data model binary.
+ */
+struct  Datamodel__DeclarePayloadsParams
+{
+  ProtobufCMessage base;
+  protobuf_c_boolean has_size;
+  uint32_t size;
+};
+#define DATAMODEL__DECLARE_PAYLOADS_PARAMS__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&datamodel__declare_payloads_params__descriptor) \
+, 0, 0 }
+
+
 typedef enum {
   DATAMODEL__FUNCTION_CALL__PARAMS__NOT_SET = 0,
   DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ATTRIBUTE_PARAMS = 2,
@@ -283,7 +374,11 @@ typedef enum {
   DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_EVENT_PARAMS = 4,
   DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_CLUSTER_PARAMS = 5,
   DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ENDPOINT_PARAMS = 6,
-  DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS = 7
+  DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS = 7,
+  DATAMODEL__FUNCTION_CALL__PARAMS_REMOVE_ENDPOINT_PARAMS = 8,
+  DATAMODEL__FUNCTION_CALL__PARAMS_UPDATE_ATTRIBUTE_PARAMS = 9,
+  DATAMODEL__FUNCTION_CALL__PARAMS_DEFINE_VALUE_PARAMS = 10,
+  DATAMODEL__FUNCTION_CALL__PARAMS_DECLARE_PAYLOADS_PARAMS = 11
     PROTOBUF_C__FORCE_ENUM_TO_BE_INT_SIZE(DATAMODEL__FUNCTION_CALL__PARAMS__CASE)
 } Datamodel__FunctionCall__ParamsCase;
 
@@ -303,6 +398,10 @@ struct  Datamodel__FunctionCall
     Datamodel__CreateClusterParams *create_cluster_params;
     Datamodel__CreateEndpointParams *create_endpoint_params;
     Datamodel__EndpointAddDeviceTypeParams *endpoint_add_device_type_params;
+    Datamodel__RemoveEndpointParams *remove_endpoint_params;
+    Datamodel__UpdateAttributeParams *update_attribute_params;
+    Datamodel__DefineValueParams *define_value_params;
+    Datamodel__DeclarePayloadsParams *declare_payloads_params;
   };
 };
 #define DATAMODEL__FUNCTION_CALL__INIT \
@@ -481,6 +580,82 @@ Datamodel__EndpointAddDeviceTypeParams *
 void   datamodel__endpoint_add_device_type_params__free_unpacked
                      (Datamodel__EndpointAddDeviceTypeParams *message,
                       ProtobufCAllocator *allocator);
+/* Datamodel__RemoveEndpointParams methods */
+void   datamodel__remove_endpoint_params__init
+                     (Datamodel__RemoveEndpointParams         *message);
+size_t datamodel__remove_endpoint_params__get_packed_size
+                     (const Datamodel__RemoveEndpointParams   *message);
+size_t datamodel__remove_endpoint_params__pack
+                     (const Datamodel__RemoveEndpointParams   *message,
+                      uint8_t             *out);
+size_t datamodel__remove_endpoint_params__pack_to_buffer
+                     (const Datamodel__RemoveEndpointParams   *message,
+                      ProtobufCBuffer     *buffer);
+Datamodel__RemoveEndpointParams *
+       datamodel__remove_endpoint_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   datamodel__remove_endpoint_params__free_unpacked
+                     (Datamodel__RemoveEndpointParams *message,
+                      ProtobufCAllocator *allocator);
+/* Datamodel__UpdateAttributeParams methods */
+void   datamodel__update_attribute_params__init
+                     (Datamodel__UpdateAttributeParams         *message);
+size_t datamodel__update_attribute_params__get_packed_size
+                     (const Datamodel__UpdateAttributeParams   *message);
+size_t datamodel__update_attribute_params__pack
+                     (const Datamodel__UpdateAttributeParams   *message,
+                      uint8_t             *out);
+size_t datamodel__update_attribute_params__pack_to_buffer
+                     (const Datamodel__UpdateAttributeParams   *message,
+                      ProtobufCBuffer     *buffer);
+Datamodel__UpdateAttributeParams *
+       datamodel__update_attribute_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   datamodel__update_attribute_params__free_unpacked
+                     (Datamodel__UpdateAttributeParams *message,
+                      ProtobufCAllocator *allocator);
+/* Datamodel__DefineValueParams methods */
+void   datamodel__define_value_params__init
+                     (Datamodel__DefineValueParams         *message);
+size_t datamodel__define_value_params__get_packed_size
+                     (const Datamodel__DefineValueParams   *message);
+size_t datamodel__define_value_params__pack
+                     (const Datamodel__DefineValueParams   *message,
+                      uint8_t             *out);
+size_t datamodel__define_value_params__pack_to_buffer
+                     (const Datamodel__DefineValueParams   *message,
+                      ProtobufCBuffer     *buffer);
+Datamodel__DefineValueParams *
+       datamodel__define_value_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   datamodel__define_value_params__free_unpacked
+                     (Datamodel__DefineValueParams *message,
+                      ProtobufCAllocator *allocator);
+/* Datamodel__DeclarePayloadsParams methods */
+void   datamodel__declare_payloads_params__init
+                     (Datamodel__DeclarePayloadsParams         *message);
+size_t datamodel__declare_payloads_params__get_packed_size
+                     (const Datamodel__DeclarePayloadsParams   *message);
+size_t datamodel__declare_payloads_params__pack
+                     (const Datamodel__DeclarePayloadsParams   *message,
+                      uint8_t             *out);
+size_t datamodel__declare_payloads_params__pack_to_buffer
+                     (const Datamodel__DeclarePayloadsParams   *message,
+                      ProtobufCBuffer     *buffer);
+Datamodel__DeclarePayloadsParams *
+       datamodel__declare_payloads_params__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   datamodel__declare_payloads_params__free_unpacked
+                     (Datamodel__DeclarePayloadsParams *message,
+                      ProtobufCAllocator *allocator);
 /* Datamodel__FunctionCall methods */
 void   datamodel__function_call__init
                      (Datamodel__FunctionCall         *message);
@@ -529,6 +704,18 @@ typedef void (*Datamodel__CreateEndpointParams_Closure)
 typedef void (*Datamodel__EndpointAddDeviceTypeParams_Closure)
                  (const Datamodel__EndpointAddDeviceTypeParams *message,
                   void *closure_data);
+typedef void (*Datamodel__RemoveEndpointParams_Closure)
+                 (const Datamodel__RemoveEndpointParams *message,
+                  void *closure_data);
+typedef void (*Datamodel__UpdateAttributeParams_Closure)
+                 (const Datamodel__UpdateAttributeParams *message,
+                  void *closure_data);
+typedef void (*Datamodel__DefineValueParams_Closure)
+                 (const Datamodel__DefineValueParams *message,
+                  void *closure_data);
+typedef void (*Datamodel__DeclarePayloadsParams_Closure)
+                 (const Datamodel__DeclarePayloadsParams *message,
+                  void *closure_data);
 typedef void (*Datamodel__FunctionCall_Closure)
                  (const Datamodel__FunctionCall *message,
                   void *closure_data);
@@ -548,6 +735,10 @@ extern const ProtobufCMessageDescriptor datamodel__create_event_params__descript
 extern const ProtobufCMessageDescriptor datamodel__create_cluster_params__descriptor;
 extern const ProtobufCMessageDescriptor datamodel__create_endpoint_params__descriptor;
 extern const ProtobufCMessageDescriptor datamodel__endpoint_add_device_type_params__descriptor;
+extern const ProtobufCMessageDescriptor datamodel__remove_endpoint_params__descriptor;
+extern const ProtobufCMessageDescriptor datamodel__update_attribute_params__descriptor;
+extern const ProtobufCMessageDescriptor datamodel__define_value_params__descriptor;
+extern const ProtobufCMessageDescriptor datamodel__declare_payloads_params__descriptor;
 extern const ProtobufCMessageDescriptor datamodel__function_call__descriptor;
 extern const ProtobufCEnumDescriptor    datamodel__function_call__function_type__descriptor;
 
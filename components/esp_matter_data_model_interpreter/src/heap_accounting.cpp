@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "heap_accounting.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "sdkconfig.h"
+#if CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING
+#include "esp_heap_caps.h"
+#endif
+
+namespace heap_accounting {
+
+#if CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING
+
+namespace {
+
+constexpr size_t kTopConsumers = CONFIG_DM_INTERPRETER_HEAP_TOP_CONSUMERS;
+// Distinct cluster ids reserved up front, so that the report does not allocate inside a span.
+constexpr size_t kReservedClusters = 64;
+
+Report report;
+bool has_report = false;
+bool collecting = false;
+
+bool span_open = false;
+Consumer span;
+size_t span_free;
+
+size_t free_size()
+{
+    return heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+void add_to_top(const Consumer &consumer)
+{
+    std::vector<Consumer> &top = report.top;
+    if (top.size() == kTopConsumers && consumer.bytes <= top.back().bytes) {
+        return;
+    }
+    auto it = std::upper_bound(top.begin(), top.end(), consumer,
+                               [](const Consumer &a, const Consumer &b) { return a.bytes > b.bytes; });
+    top.insert(it, consumer);
+    if (top.size() > kTopConsumers) {
+        top.pop_back();
+    }
+}
+
+void add_to_cluster(const Consumer &consumer)
+{
+    for (ClusterTotal &total : report.clusters) {
+        if (total.cluster_id == consumer.cluster_id) {
+            total.instances++;
+            total.bytes += consumer.bytes;
+            return;
+        }
+    }
+    report.clusters.push_back({consumer.cluster_id, 1, consumer.bytes});
+}
+
+void close_span()
+{
+    if (!span_open) {
+        return;
+    }
+    span.bytes = static_cast<int32_t>(span_free - free_size());
+    span_open = false;
+    report.total_bytes += span.bytes;
+    add_to_top(span);
+    if (span.cluster_id != kEndpointOverhead) {
+        add_to_cluster(span);
+    }
+}
+
+const char *cluster_label(uint32_t cluster_id, char *buf, size_t size)
+{
+    if (cluster_id == kEndpointOverhead) {
+        return "endpoint";
+    }
+    snprintf(buf, size, "0x%04" PRIx32, cluster_id);
+    return buf;
+}
+
+} // namespace
+
+void start()
+{
+    report.top.clear();
+    report.clusters.clear();
+    report.top.reserve(kTopConsumers + 1);
+    report.clusters.reserve(kReservedClusters);
+    report.total_bytes = 0;
+    report.free_before = free_size();
+    report.largest_block_before = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+    span_open = false;
+    collecting = true;
+}
+
+void begin_span(uint16_t endpoint_id, uint32_t cluster_id)
+{
+    if (!collecting) {
+        return;
+    }
+    close_span();
+    span = {endpoint_id, cluster_id, 0};
+    span_open = true;
+    span_free = free_size();
+}
+
+void finish()
+{
+    if (!collecting) {
+        return;
+    }
+    close_span();
+    collecting = false;
+    std::sort(report.clusters.begin(), report.clusters.end(),
+              [](const ClusterTotal &a, const ClusterTotal &b) { return a.bytes > b.bytes; });
+    report.free_after = free_size();
+    report.largest_block_after = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+    report.minimum_free = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    has_report = true;
+}
+
+const Report *last_report()
+{
+    return has_report ? &report : nullptr;
+}
+
+void print_report()
+{
+    if (!has_report) {
+        printf("No data model interpreted yet\n");
+        return;
+    }
+    char label[16];
+    printf("Data model heap: %" PRId32 " bytes\n", report.total_bytes);
+    printf("  free before %zu, after %zu, minimum %zu\n", report.free_before, report.free_after, report.minimum_free);
+    printf("  largest free block before %zu (%u%% fragmentation), after %zu (%u%% fragmentation)\n",
+           report.largest_block_before, Report::fragmentation(report.free_before, report.largest_block_before),
+           report.largest_block_after, Report::fragmentation(report.free_after, report.largest_block_after));
+
+    printf("Top consumers:\n  %-8s %-10s %10s\n", "endpoint", "cluster", "bytes");
+    for (const Consumer &consumer : report.top) {
+        printf("  %-8u %-10s %10" PRId32 "\n", consumer.endpoint_id,
+               cluster_label(consumer.cluster_id, label, sizeof(label)), consumer.bytes);
+    }
+    printf("Clusters over all endpoints:\n  %-10s %9s %10s\n", "cluster", "instances", "bytes");
+    for (const ClusterTotal &total : report.clusters) {
+        printf("  %-10s %9u %10" PRId32 "\n", cluster_label(total.cluster_id, label, sizeof(label)), total.instances,
+               total.bytes);
+    }
+}
+
+#else // CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING
+
+void start() {}
+
+void begin_span(uint16_t endpoint_id, uint32_t cluster_id) {}
+
+void finish() {}
+
+const Report *last_report()
+{
+    return nullptr;
+}
+
+void print_report()
+{
+    printf("Heap accounting disabled, enable CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING\n");
+}
+
+#endif // CONFIG_DM_INTERPRETER_HEAP_ACCOUNTING
+
+} // namespace heap_accounting
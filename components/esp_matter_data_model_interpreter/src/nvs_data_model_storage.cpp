@@ -26,7 +26,7 @@ NVSDataModelStorage::~NVSDataModelStorage()
     // No explicit cleanup needed.
 }
 
-esp_err_t NVSDataModelStorage::get_data_model(std::string_view key, std::vector<uint8_t> &data)
+esp_err_t NVSDataModelStorage::get_data_model(std::string_view key, allocator_policy::Buffer &data)
 {
     esp_err_t err;
     // Open the NVS "em_data_model" namespace from the "esp_matter_dm" partition.
@@ -46,8 +46,11 @@ esp_err_t NVSDataModelStorage::get_data_model(std::string_view key, std::vector<
         return err;
     }
 
-    // Resize vector and read blob.
-    data.resize(size);
+    // Resize the buffer, in the memory of its policy, and read the blob.
+    if (data.resize(size) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to allocate %zu bytes for '%.*s'", size, static_cast<int>(key.size()), key.data());
+        return ESP_ERR_NO_MEM;
+    }
     err = handle->get_blob(key.data(), data.data(), size);
     if (err != ESP_OK) {
         data.clear();
@@ -56,7 +59,7 @@ esp_err_t NVSDataModelStorage::get_data_model(std::string_view key, std::vector<
     return ESP_OK;
 }
 
-esp_err_t NVSDataModelStorage::set_data_model(std::string_view key, const std::vector<uint8_t> &data)
+esp_err_t NVSDataModelStorage::set_data_model(std::string_view key, const allocator_policy::Buffer &data)
 {
     esp_err_t err;
     std::unique_ptr<nvs::NVSHandle> handle = nvs::open_nvs_handle_from_partition(nvs_partition_name, nvs_namespace, NVS_READWRITE, &err);
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "payload_source.hpp"
+
+#include <cstring>
+
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+static const char *TAG = "PayloadSource";
+
+namespace esp_matter_data_model_interpreter {
+
+namespace {
+
+esp_err_t copy_payload(const allocator_policy::Buffer &data, size_t offset, uint8_t *out, size_t size)
+{
+    if (offset > data.size() || size > data.size() - offset) {
+        ESP_LOGE(TAG, "Payload at %zu (%zu bytes) is past the end of the data model (%zu bytes)", offset, size,
+                 data.size());
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(out, data.data() + offset, size);
+    return ESP_OK;
+}
+
+} // namespace
+
+ActiveDataModelPayloadSource::ActiveDataModelPayloadSource(data_model_manager::DataModelManager &manager)
+    : manager_(manager), blob_(), binary_(manager.policy(), allocator_policy::Usage::Binary)
+{
+}
+
+esp_err_t ActiveDataModelPayloadSource::pin(const uint8_t *binary, size_t length)
+{
+    data_model_manager::DataModelManager::BlobRef blob;
+    if (manager_.get_loaded_blob(blob) != ESP_OK || blob.size != length ||
+        blob.crc32 != esp_rom_crc32_le(0, binary, length)) {
+        ESP_LOGE(TAG, "The data model binary was not returned by the data model manager");
+        blob_ = {};
+        return ESP_ERR_INVALID_STATE;
+    }
+    blob_ = blob;
+    ESP_LOGD(TAG, "Payloads pinned to '%s'", blob_.key);
+    return ESP_OK;
+}
+
+esp_err_t ActiveDataModelPayloadSource::begin_reads()
+{
+    esp_err_t err = manager_.read_blob(blob_, binary_);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read the data model '%s' (%d)", blob_.key, err);
+        binary_.release();
+    }
+    return err;
+}
+
+void ActiveDataModelPayloadSource::end_reads()
+{
+    binary_.release();
+}
+
+esp_err_t ActiveDataModelPayloadSource::read(size_t offset, uint8_t *out, size_t size)
+{
+    if (!binary_.empty()) {
+        return copy_payload(binary_, offset, out, size);
+    }
+    esp_err_t err = begin_reads();
+    if (err == ESP_OK) {
+        err = copy_payload(binary_, offset, out, size);
+        end_reads();
+    }
+    return err;
+}
+
+} // namespace esp_matter_data_model_interpreter
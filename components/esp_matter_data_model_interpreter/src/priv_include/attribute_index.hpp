@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ATTRIBUTE_INDEX_HPP
+#define ATTRIBUTE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "esp_matter.h"
+
+#include "attribute_path_table.hpp"
+
+namespace esp_matter_data_model_interpreter {
+
+/**
+ * @brief Handles of the attributes created by the interpreter, by (endpoint, cluster, attribute).
+ *
+ * An AttributePathTable, like the AttributeDispatcher. An entry is 16 bytes on 32-bit targets and
+ * the table is kept at most 3/4 full, so a lookup reads one or two cache lines instead of walking
+ * the endpoint, cluster and attribute lists of esp_matter.
+ */
+class AttributeIndex {
+public:
+    /* Add or replace the handle of an attribute. Returns ESP_ERR_NO_MEM if the table cannot grow. */
+    esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter::attribute_t *attribute)
+    {
+        esp_matter::attribute_t **slot = table_.insert(endpoint_id, cluster_id, attribute_id);
+        if (!slot) {
+            return ESP_ERR_NO_MEM;
+        }
+        *slot = attribute;
+        return ESP_OK;
+    }
+
+    /* The handle of an attribute, or nullptr if it is not in the index. */
+    esp_matter::attribute_t *find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) const
+    {
+        esp_matter::attribute_t *const *slot = table_.find(endpoint_id, cluster_id, attribute_id);
+        return slot ? *slot : nullptr;
+    }
+
+    /* Remove the attributes of an endpoint, before it is destroyed. */
+    void remove_endpoint(uint16_t endpoint_id) { table_.remove_endpoint(endpoint_id); }
+
+    /* Remove all attributes and release the table. */
+    void clear() { table_.clear(); }
+
+    size_t size() const { return table_.size(); }
+    size_t capacity() const { return table_.capacity(); }
+    size_t memory_bytes() const { return table_.memory_bytes(); }
+
+private:
+    AttributePathTable<esp_matter::attribute_t *> table_;
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // ATTRIBUTE_INDEX_HPP
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef DECODE_ARENA_HPP
+#define DECODE_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <protobuf-c/protobuf-c.h>
+
+#include "allocator_policy.hpp"
+
+namespace esp_matter_data_model_interpreter {
+
+/**
+ * @brief Bump allocator for protobuf-c, holding one decoded message at a time.
+ *
+ * Unpacking a message with allocator() takes its memory from a buffer owned by the arena instead of
+ * the heap, and reset() releases the whole message at once. Allocations that do not fit in the
+ * buffer fall back to the heap, and the next reset() grows the buffer to the size the message
+ * needed, so the buffer settles at the largest message and is reused by every following message
+ * and every following run of the same Interpreter. The buffer and the overflow are allocated with
+ * the DecodeScratch usage of the policy.
+ */
+class DecodeArena {
+public:
+    explicit DecodeArena(allocator_policy::Policy &policy)
+        : allocator_{&DecodeArena::alloc, &DecodeArena::free, this}, policy_(policy)
+    {
+    }
+
+    DecodeArena(const DecodeArena &) = delete;
+    DecodeArena &operator=(const DecodeArena &) = delete;
+
+    ~DecodeArena() { shrink(); }
+
+    ProtobufCAllocator *allocator() { return &allocator_; }
+
+    /* Release the message unpacked with allocator(); its pointers are invalid afterwards. */
+    void reset()
+    {
+        if (!overflow_.empty()) {
+            size_t needed = used_ + overflow_bytes_;
+            release_overflow();
+            release_buffer();
+            buffer_ = static_cast<uint8_t *>(policy_.allocate(kUsage, needed));
+            capacity_ = buffer_ ? needed : 0;
+        }
+        used_ = 0;
+    }
+
+    /* Free the buffer, e.g. once the data model has been interpreted. */
+    void shrink()
+    {
+        release_overflow();
+        release_buffer();
+        used_ = 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    static constexpr allocator_policy::Usage kUsage = allocator_policy::Usage::DecodeScratch;
+
+    static void *alloc(void *allocator_data, size_t size)
+    {
+        DecodeArena *arena = static_cast<DecodeArena *>(allocator_data);
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (arena->capacity_ - arena->used_ >= size) {
+            void *ptr = &arena->buffer_[arena->used_];
+            arena->used_ += size;
+            return ptr;
+        }
+        void *ptr = arena->policy_.allocate(kUsage, size);
+        if (ptr) {
+            arena->overflow_.emplace_back(ptr, size);
+            arena->overflow_bytes_ += size;
+        }
+        return ptr;
+    }
+
+    // Memory is released by reset().
+    static void free(void *allocator_data, void *ptr) {}
+
+    void release_overflow()
+    {
+        for (const std::pair<void *, size_t> &allocation : overflow_) {
+            policy_.deallocate(kUsage, allocation.first, allocation.second);
+        }
+        overflow_.clear();
+        overflow_bytes_ = 0;
+    }
+
+    void release_buffer()
+    {
+        policy_.deallocate(kUsage, buffer_, capacity_);
+        buffer_ = nullptr;
+        capacity_ = 0;
+    }
+
+    ProtobufCAllocator allocator_;
+    allocator_policy::Policy &policy_;
+    uint8_t *buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    std::vector<std::pair<void *, size_t>> overflow_;
+    size_t overflow_bytes_ = 0;
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // DECODE_ARENA_HPP
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: BSD-2-Clause AND Apache-2.0
+ * SPDX-FileContributor: Dave Benson and the protobuf-c authors (for scan_length_prefixed_data)
+ */
+#ifndef MESSAGE_FRAMING_HPP
+#define MESSAGE_FRAMING_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+namespace esp_matter_data_model_interpreter {
+
+/*
+ * Framing of the data model binary: each message is prefixed with its length as a varint.
+ * Kept free of ESP-IDF dependencies, so that the host tools decode binaries with the same code.
+ */
+enum class FramingError : uint8_t {
+    None,
+    InvalidPrefix,  // no end of the varint in the first 5 bytes
+    TooLarge,       // protobuf messages are always less than 2 GiB
+    Truncated,      // the message does not fit in the remaining data
+};
+
+/*
+ * Scan the length prefix at data. On success, prefix_len and message_len are set and the
+ * message is at data + prefix_len.
+ *
+ * Taken from protobuf-c.c, where it is static.
+ */
+inline FramingError scan_length_prefixed_data(size_t len, const uint8_t *data, size_t &prefix_len, size_t &message_len)
+{
+    unsigned hdr_max = len < 5 ? len : 5;
+    size_t val = 0;
+    unsigned i;
+    unsigned shift = 0;
+
+    for (i = 0; i < hdr_max; i++) {
+        val |= ((size_t)data[i] & 0x7f) << shift;
+        shift += 7;
+        if ((data[i] & 0x80) == 0) {
+            break;
+        }
+    }
+    if (i == hdr_max) {
+        return FramingError::InvalidPrefix;
+    }
+    // Return early so that prefix_len + val does not overflow on 32-bit systems.
+    if (val > INT_MAX) {
+        return FramingError::TooLarge;
+    }
+    if (i + 1 + val > len) {
+        return FramingError::Truncated;
+    }
+    prefix_len = i + 1;
+    message_len = val;
+    return FramingError::None;
+}
+
+inline const char *framing_error_str(FramingError err)
+{
+    switch (err) {
+    case FramingError::None:
+        return "no error";
+    case FramingError::InvalidPrefix:
+        return "invalid length prefix";
+    case FramingError::TooLarge:
+        return "length prefix too large";
+    case FramingError::Truncated:
+        return "data too short after length prefix";
+    }
+    return "unknown error";
+}
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // MESSAGE_FRAMING_HPP
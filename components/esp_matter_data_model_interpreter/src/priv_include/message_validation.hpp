@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MESSAGE_VALIDATION_HPP
+#define MESSAGE_VALIDATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_matter_data_model_api_messages.pb-c.h"
+#include "message_framing.hpp"
+
+namespace esp_matter_data_model_interpreter {
+
+/*
+ * The EspMatterVal field the interpreter reads for each value type, or VALUE__NOT_SET for an unknown type.
+ * A value in another field would be read as the wrong union member, e.g. an integer as a string pointer.
+ * Shared with the host tools, so that "matter_dm_tool validate" accepts what the interpreter accepts.
+ */
+inline Datamodel__EspMatterVal__ValueCase value_case_for_type(Datamodel__EspMatterValType type)
+{
+    switch (type) {
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BOOLEAN:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_B;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_FLOAT:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_F;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT8:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_I8;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT8:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM8:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP8:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_U8;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT16:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_I16;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT16:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ENUM16:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP16:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_U16;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT32:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_I32;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT32:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_BITMAP32:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_U32;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_INT64:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_I64;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_UINT64:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_U64;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING;
+    case DATAMODEL__ESP_MATTER_VAL_TYPE__ESP_MATTER_VAL_TYPE_ARRAY:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE_A;
+    default:
+        return DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
+    }
+}
+
+/*
+ * Length of the messages of a data model binary, i.e. without the payload section declared by a
+ * DECLARE_PAYLOADS first message, or the whole length if there is none. Returns false if the first
+ * message is a declaration that does not fit the binary; other framing errors are left to the caller.
+ * The declaration is decoded with allocator, or on the heap if it is nullptr.
+ */
+inline bool messages_length(const uint8_t *data, size_t length, size_t &out, ProtobufCAllocator *allocator = nullptr)
+{
+    out = length;
+    size_t prefix_len = 0;
+    size_t message_len = 0;
+    if (length == 0 || scan_length_prefixed_data(length, data, prefix_len, message_len) != FramingError::None) {
+        return true;
+    }
+    Datamodel__FunctionCall *call = datamodel__function_call__unpack(allocator, message_len, data + prefix_len);
+    if (!call) {
+        return true;
+    }
+    bool ok = true;
+    if (call->params_case == DATAMODEL__FUNCTION_CALL__PARAMS_DECLARE_PAYLOADS_PARAMS) {
+        size_t section_size = call->declare_payloads_params->size;
+        ok = section_size <= length - prefix_len - message_len;
+        if (ok) {
+            out = length - section_size;
+        }
+    }
+    datamodel__function_call__free_unpacked(call, allocator);
+    return ok;
+}
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // MESSAGE_VALIDATION_HPP
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace esp_matter_data_model_interpreter {
+
+/**
+ * @brief Lock-free ring for exactly one producer and one consumer task.
+ *
+ * push() and pop() never block; the caller decides how to wait when the ring is full or empty.
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "The ring size has to be a power of two");
+
+public:
+    bool push(const T &item)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        items_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        item = items_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items_[N];
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+};
+
+} // namespace esp_matter_data_model_interpreter
+
+#endif // SPSC_RING_HPP
@@ -7,16 +7,185 @@
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
+#include <memory>
+#include <vector>
 
 #include <esp_matter.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include <app_priv.h>
+#include "attribute_coalescer.hpp"
 
 using namespace chip::app::Clusters;
 using namespace esp_matter;
 
 static const char *TAG = "app_driver";
 
+/* Transitions update these attributes every few milliseconds, a light only needs the latest value */
+constexpr uint32_t k_coalescing_window_ms = 50;
+
+/* State of the light driven by one endpoint, replace the log with the calls to the hardware driver. */
+struct app_driver_light {
+    uint16_t endpoint_id;
+    bool on;
+    uint8_t level;
+    uint8_t hue;
+    uint8_t saturation;
+    uint16_t color_temperature;
+};
+
+/* Lights are added and removed from the task applying a delta, updated from the Matter task and read from the
+ * driver task of the coalescer: the list and the fields of the lights are only accessed under s_lights_lock.
+ */
+static std::vector<std::unique_ptr<app_driver_light>> s_lights;
+static StaticSemaphore_t s_lights_lock_buffer;
+static SemaphoreHandle_t s_lights_lock;
+
+/* Called with s_lights_lock held */
+static app_driver_light *app_driver_find_light(uint16_t endpoint_id)
+{
+    for (const std::unique_ptr<app_driver_light> &light : s_lights) {
+        if (light->endpoint_id == endpoint_id) {
+            return light.get();
+        }
+    }
+    return nullptr;
+}
+
+/* The light given as handler context, with s_lights_lock held, or nullptr if its endpoint was removed since */
+static app_driver_light *app_driver_lock_light(void *context, uint16_t endpoint_id)
+{
+    xSemaphoreTake(s_lights_lock, portMAX_DELAY);
+    app_driver_light *light = app_driver_find_light(endpoint_id);
+    if (light != context) {
+        xSemaphoreGive(s_lights_lock);
+        return nullptr;
+    }
+    return light;
+}
+
+static void *app_driver_light_for_endpoint(uint16_t endpoint_id, uint32_t cluster_id, void *arg)
+{
+    xSemaphoreTake(s_lights_lock, portMAX_DELAY);
+    app_driver_light *light = app_driver_find_light(endpoint_id);
+    if (!light) {
+        s_lights.push_back(std::make_unique<app_driver_light>(app_driver_light{endpoint_id, false, 0, 0, 0, 0}));
+        light = s_lights.back().get();
+    }
+    xSemaphoreGive(s_lights_lock);
+    return light;
+}
+
+static esp_err_t app_driver_on_off_update(void *context, uint16_t endpoint_id, uint32_t cluster_id,
+                                          uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (attribute_id != OnOff::Attributes::OnOff::Id) {
+        return ESP_OK;
+    }
+    app_driver_light *light = app_driver_lock_light(context, endpoint_id);
+    if (!light) {
+        return ESP_OK;
+    }
+    light->on = val->val.b;
+    xSemaphoreGive(s_lights_lock);
+    ESP_LOGD(TAG, "Endpoint %" PRIu16 " power: %d", endpoint_id, val->val.b);
+    return ESP_OK;
+}
+
+static esp_err_t app_driver_level_update(void *context, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (attribute_id != LevelControl::Attributes::CurrentLevel::Id) {
+        return ESP_OK;
+    }
+    app_driver_light *light = app_driver_lock_light(context, endpoint_id);
+    if (!light) {
+        return ESP_OK;
+    }
+    light->level = val->val.u8;
+    xSemaphoreGive(s_lights_lock);
+    ESP_LOGD(TAG, "Endpoint %" PRIu16 " level: %" PRIu8, endpoint_id, val->val.u8);
+    return ESP_OK;
+}
+
+static esp_err_t app_driver_color_update(void *context, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (attribute_id != ColorControl::Attributes::CurrentHue::Id &&
+        attribute_id != ColorControl::Attributes::CurrentSaturation::Id &&
+        attribute_id != ColorControl::Attributes::ColorTemperatureMireds::Id) {
+        return ESP_OK;
+    }
+    app_driver_light *light = app_driver_lock_light(context, endpoint_id);
+    if (!light) {
+        return ESP_OK;
+    }
+    switch (attribute_id) {
+    case ColorControl::Attributes::CurrentHue::Id:
+        light->hue = val->val.u8;
+        break;
+    case ColorControl::Attributes::CurrentSaturation::Id:
+        light->saturation = val->val.u8;
+        break;
+    default:
+        light->color_temperature = val->val.u16;
+        break;
+    }
+    app_driver_light state = *light;
+    xSemaphoreGive(s_lights_lock);
+    ESP_LOGD(TAG, "Endpoint %" PRIu16 " hue: %" PRIu8 ", saturation: %" PRIu8 ", temperature: %" PRIu16, endpoint_id,
+             state.hue, state.saturation, state.color_temperature);
+    return ESP_OK;
+}
+
+/* Called on the driver task once the updates of an endpoint are applied to its state */
+static void app_driver_light_write(uint16_t endpoint_id, void *arg)
+{
+    xSemaphoreTake(s_lights_lock, portMAX_DELAY);
+    app_driver_light *light = app_driver_find_light(endpoint_id);
+    if (!light) {
+        xSemaphoreGive(s_lights_lock);
+        return;
+    }
+    app_driver_light state = *light;
+    xSemaphoreGive(s_lights_lock);
+    ESP_LOGD(TAG, "Endpoint %" PRIu16 " write: power %d, level %" PRIu8, endpoint_id, state.on, state.level);
+}
+
+void app_driver_remove_endpoint(uint16_t endpoint_id)
+{
+    xSemaphoreTake(s_lights_lock, portMAX_DELAY);
+    for (auto it = s_lights.begin(); it != s_lights.end(); ++it) {
+        if ((*it)->endpoint_id == endpoint_id) {
+            s_lights.erase(it);
+            break;
+        }
+    }
+    xSemaphoreGive(s_lights_lock);
+}
+
+void app_driver_remove_all_endpoints()
+{
+    xSemaphoreTake(s_lights_lock, portMAX_DELAY);
+    s_lights.clear();
+    xSemaphoreGive(s_lights_lock);
+}
+
+esp_err_t app_driver_register_handlers(esp_matter_data_model_interpreter::AttributeDispatcher &dispatcher)
+{
+    s_lights_lock = xSemaphoreCreateMutexStatic(&s_lights_lock_buffer);
+    dispatcher.set_context_resolver(app_driver_light_for_endpoint, nullptr);
+    esp_err_t err = dispatcher.register_cluster_handler(OnOff::Id, app_driver_on_off_update);
+    if (err == ESP_OK) {
+        err = dispatcher.register_cluster_handler(LevelControl::Id, app_driver_level_update);
+    }
+    if (err == ESP_OK) {
+        err = dispatcher.register_cluster_handler(ColorControl::Id, app_driver_color_update);
+    }
+    return err;
+}
+
 esp_err_t app_driver_attribute_update(app_driver_handle_t driver_handle, uint16_t endpoint_id, uint32_t cluster_id,
                                       uint32_t attribute_id, esp_matter_attr_val_t *val)
 {
@@ -84,3 +253,16 @@ esp_err_t app_driver_attribute_update(app_driver_handle_t driver_handle, uint16_
 
     return err;
 }
+
+esp_err_t app_driver_start_coalescing(esp_matter_data_model_interpreter::AttributeDispatcher &dispatcher)
+{
+    esp_err_t err = attribute_coalescer::set_window(LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id,
+                                                    k_coalescing_window_ms);
+    if (err == ESP_OK) {
+        err = attribute_coalescer::set_window(ColorControl::Id, attribute_coalescer::kAnyAttribute, k_coalescing_window_ms);
+    }
+    if (err == ESP_OK) {
+        err = attribute_coalescer::start(dispatcher, app_driver_light_write, nullptr);
+    }
+    return err;
+}
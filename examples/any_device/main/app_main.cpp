@@ -12,6 +12,7 @@
 #include <nvs_flash.h>
 #include <esp_partition.h>
 #include <esp_ota_ops.h>
+#include <esp_heap_caps.h>
 
 #include <esp_matter.h>
 #include <esp_matter_console.h>
@@ -28,6 +29,11 @@
 #include <app/server/Server.h>
 
 #include "esp_matter_data_model_interpreter.hpp"
+#include "allocator_policy.hpp"
+#include "attribute_coalescer.hpp"
+#include "attribute_dispatcher.hpp"
+#include "boot_profiler.hpp"
+#include "data_model_console.hpp"
 #include "data_model_manager.hpp"
 #include "nvs_data_model_storage.hpp"
 
@@ -40,6 +46,9 @@ using namespace chip::app::Clusters;
 
 constexpr auto k_timeout_seconds = 300;
 
+/* Attributes of the clusters with a driver, filled while the data model is interpreted */
+static esp_matter_data_model_interpreter::AttributeDispatcher s_dispatcher;
+
 #if CONFIG_ENABLE_ENCRYPTED_OTA
 extern const char decryption_key_start[] asm("_binary_esp_image_encryption_key_pem_start");
 extern const char decryption_key_end[] asm("_binary_esp_image_encryption_key_pem_end");
@@ -73,6 +82,7 @@ static void app_event_cb(const ChipDeviceEvent *event, intptr_t arg)
 
     case chip::DeviceLayer::DeviceEventType::kCommissioningWindowOpened:
         ESP_LOGI(TAG, "Commissioning window opened");
+        boot_profiler::mark(boot_profiler::Phase::FirstAdvertisement);
         break;
 
     case chip::DeviceLayer::DeviceEventType::kCommissioningWindowClosed:
@@ -137,20 +147,38 @@ static esp_err_t app_attribute_update_cb(attribute::callback_type_t type, uint16
     esp_err_t err = ESP_OK;
 
     if (type == PRE_UPDATE) {
-        /* Driver update */
-        app_driver_handle_t driver_handle = (app_driver_handle_t)priv_data;
-        err = app_driver_attribute_update(driver_handle, endpoint_id, cluster_id, attribute_id, val);
+        /* Driver update: queued for the driver task if coalesced, else through the handler of the cluster if it has one */
+        err = attribute_coalescer::submit(endpoint_id, cluster_id, attribute_id, val);
+        if (err != ESP_OK) {
+            err = s_dispatcher.dispatch(endpoint_id, cluster_id, attribute_id, val);
+        }
+        if (err == ESP_ERR_NOT_FOUND) {
+            app_driver_handle_t driver_handle = (app_driver_handle_t)priv_data;
+            err = app_driver_attribute_update(driver_handle, endpoint_id, cluster_id, attribute_id, val);
+        }
     }
 
     return err;
 }
 
+/* The dispatcher entries of a removed endpoint go first, so no new update reaches its driver state */
+static void app_endpoint_removed_cb(uint16_t endpoint_id, void *arg)
+{
+    esp_matter_data_model_interpreter::AttributeDispatcher::on_endpoint_removed(endpoint_id, arg);
+    app_driver_remove_endpoint(endpoint_id);
+}
+
 extern "C" void app_main()
 {
     esp_err_t err = ESP_OK;
 
+    /* Record the timing of the boot phases, see "matter esp dm boot" */
+    boot_profiler::init();
+
     /* Initialize the ESP NVS layer */
+    boot_profiler::begin(boot_profiler::Phase::NvsInit);
     err = nvs_flash_init();
+    boot_profiler::end(boot_profiler::Phase::NvsInit);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize default NVS (%d)", err);
         return;
@@ -160,14 +188,23 @@ extern "C" void app_main()
     identification::set_callback(app_identification_cb);
 
     /* Create a concrete NVS storage implementation */
+    boot_profiler::begin(boot_profiler::Phase::StorageOpen);
     NVSDataModelStorage nvs_storage;
+    boot_profiler::end(boot_profiler::Phase::StorageOpen);
+
+#if CONFIG_SPIRAM
+    /* Keep the data model buffers in PSRAM, internal RAM is left to the network stacks */
+    static allocator_policy::HeapCapsPolicy dm_policy(MALLOC_CAP_SPIRAM);
+#else
+    allocator_policy::Policy &dm_policy = allocator_policy::default_policy();
+#endif
 
     /* Create the Data Model Manager with the storage instance */
-    data_model_manager::DataModelManager dm_manager(nvs_storage);
+    data_model_manager::DataModelManager dm_manager(nvs_storage, dm_policy);
 
     /* Get the current data model binary using the manager instance */
     size_t data_model_binary_size = 0;
-    std::vector<uint8_t> data_model_binary = dm_manager.get_data_model_binary(data_model_binary_size);
+    allocator_policy::Buffer data_model_binary = dm_manager.get_data_model_binary(data_model_binary_size);
     if (data_model_binary.empty()) {
         ESP_LOGE(TAG, "Failed to load data model from storage");
         return;
@@ -176,11 +213,53 @@ extern "C" void app_main()
     /* Create an instance of the Interpreter and interpret the data model binary
      * obtained earlier using the Data Model Manager.
      */
-    esp_matter_data_model_interpreter::Interpreter interpreter;
+    esp_matter_data_model_interpreter::Interpreter interpreter(dm_policy);
+    err = app_driver_register_handlers(s_dispatcher);
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to register the driver handlers, err:%d", err));
+    interpreter.set_attribute_created_callback(esp_matter_data_model_interpreter::AttributeDispatcher::on_attribute_created,
+                                               &s_dispatcher);
+    interpreter.set_endpoint_removed_callback(app_endpoint_removed_cb, &s_dispatcher);
+    boot_profiler::begin(boot_profiler::Phase::Interpretation);
     esp_matter::node_t *node = interpreter.interpret_data(data_model_binary.data(), data_model_binary_size);
+    bool confirm_data_model = true;
+    if (node == nullptr) {
+        /* Nothing of the rejected data model is left, retry with the other slot instead of rebooting */
+        ESP_LOGE(TAG, "Failed to interpret the data model, falling back to the last known good one");
+        s_dispatcher.clear();
+        app_driver_remove_all_endpoints();
+        /* Only a failed update is given up for good. A confirmed data model may have failed for a
+         * transient reason (e.g. out of memory), the fallback stays pending so the next boot retries it.
+         */
+        bool failed_pending = false;
+        err = dm_manager.is_data_model_pending(failed_pending);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to read the state of the data model, err:%d", err);
+        }
+        confirm_data_model = failed_pending;
+        err = dm_manager.fall_back_to_last_known_good(data_model_binary);
+        if (err == ESP_OK) {
+            node = interpreter.interpret_data(data_model_binary.data(), data_model_binary.size());
+        }
+    }
+    boot_profiler::end(boot_profiler::Phase::Interpretation);
 
     ABORT_APP_ON_FAILURE(node != nullptr, ESP_LOGE(TAG, "Failed to create Matter node"));
 
+    err = app_driver_start_coalescing(s_dispatcher);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to start the attribute coalescer, updates are applied synchronously, err:%d", err);
+    }
+
+    /* The data model was interpreted successfully, cancel a pending rollback (if any) */
+    if (confirm_data_model) {
+        err = dm_manager.mark_data_model_valid();
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to confirm the data model, err:%d", err);
+        }
+    } else {
+        ESP_LOGW(TAG, "Running the fallback data model unconfirmed, the next boot retries the confirmed one");
+    }
+
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
     /* Set OpenThread platform config */
     esp_openthread_platform_config_t config = {
@@ -192,7 +271,9 @@ extern "C" void app_main()
 #endif
 
     /* Matter start */
+    boot_profiler::begin(boot_profiler::Phase::MatterStart);
     err = esp_matter::start(app_event_cb);
+    boot_profiler::end(boot_profiler::Phase::MatterStart);
     ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
 
 #if CONFIG_ENABLE_ENCRYPTED_OTA
@@ -203,6 +284,7 @@ extern "C" void app_main()
 #if CONFIG_ENABLE_CHIP_SHELL
     esp_matter::console::diagnostics_register_commands();
     esp_matter::console::wifi_register_commands();
+    esp_matter_data_model_interpreter::console::register_commands();
 #if CONFIG_OPENTHREAD_CLI
     esp_matter::console::otcli_register_commands();
 #endif
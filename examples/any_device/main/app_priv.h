@@ -8,6 +8,8 @@
 #include <esp_err.h>
 #include <esp_matter.h>
 
+#include "attribute_dispatcher.hpp"
+
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
 #include "esp_openthread_types.h"
 #endif
@@ -30,6 +32,47 @@ typedef void *app_driver_handle_t;
 esp_err_t app_driver_attribute_update(app_driver_handle_t driver_handle, uint16_t endpoint_id, uint32_t cluster_id,
                                       uint32_t attribute_id, esp_matter_attr_val_t *val);
 
+/** Driver Handlers
+ *
+ * Register the handlers of the clusters driven by this application: On/Off, Level Control and Color Control.
+ * Each endpoint with one of these clusters gets its own driver state as the handler context, created while
+ * the data model is interpreted. Call it before the data model is interpreted.
+ *
+ * @param[in] dispatcher Dispatcher filled by the interpreter and used by `app_attribute_update_cb()`.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_driver_register_handlers(esp_matter_data_model_interpreter::AttributeDispatcher &dispatcher);
+
+/** Driver Endpoint Removal
+ *
+ * Release the driver state of an endpoint the interpreter removed, after its dispatcher entries were removed.
+ * Updates still in flight for the endpoint are dropped.
+ *
+ * @param[in] endpoint_id Endpoint ID of the removed endpoint.
+ */
+void app_driver_remove_endpoint(uint16_t endpoint_id);
+
+/** Driver Reset
+ *
+ * Release the driver state of all endpoints, after the dispatcher was cleared because a failed interpretation
+ * destroyed the node.
+ */
+void app_driver_remove_all_endpoints();
+
+/** Driver Coalescing
+ *
+ * Deliver the Level Control and Color Control updates at most every 50 ms, latest value only, on the driver task
+ * of the attribute coalescer. `app_attribute_update_cb()` then passes the updates to `attribute_coalescer::submit()`.
+ *
+ * @param[in] dispatcher Dispatcher the handlers were registered with.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_driver_start_coalescing(esp_matter_data_model_interpreter::AttributeDispatcher &dispatcher);
+
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
 #define ESP_OPENTHREAD_DEFAULT_RADIO_CONFIG()                                           \
     {                                                                                   \
@@ -0,0 +1,703 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Recording stand-in for esp_matter and the generated cmd_c_routines, to run the interpreter on a host.
+ *
+ * The data model is kept in plain containers with the same ownership as esp_matter: attribute
+ * payloads are copied, endpoints own their clusters, clusters own their attributes. The node, the
+ * stats and the started flag are per thread, each thread acting as one device.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cmd_c_routines.h"
+#include "esp_heap_caps.h"
+#include "esp_matter.h"
+#include "esp_matter_stand_in.hpp"
+#include "esp_memory_utils.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+
+namespace esp_matter_stand_in {
+
+esp_log_level_t log_level = ESP_LOG_ERROR;
+
+namespace {
+
+thread_local int depth = 0;
+
+/* Marks the calling thread as inside the stand-in for the lifetime of the scope. */
+struct Scope {
+    Scope() { depth++; }
+    ~Scope() { depth--; }
+};
+
+// Each thread has its own node, like a separate device, so that models can be built in parallel.
+thread_local Stats current_stats = {};
+thread_local bool started = false;
+
+// Simulated external RAM: its size, and the size of its blocks.
+thread_local size_t external_size = 0;
+thread_local size_t external_used = 0;
+thread_local size_t external_peak = 0;
+thread_local std::map<const void *, size_t> external_blocks;
+
+esp_partition_t app_partition(const std::string &label)
+{
+    esp_partition_t partition = {};
+    partition.type = ESP_PARTITION_TYPE_APP;
+    partition.subtype = ESP_PARTITION_SUBTYPE_ANY;
+    snprintf(partition.label, sizeof(partition.label), "%s", label.c_str());
+    return partition;
+}
+
+// App partitions of the device, and the index of the running one.
+thread_local std::vector<esp_partition_t> app_partitions = {app_partition("ota_0"), app_partition("ota_1")};
+thread_local size_t running_partition = 0;
+
+} // namespace
+
+const Stats &stats()
+{
+    return current_stats;
+}
+
+void set_started(bool value)
+{
+    started = value;
+}
+
+bool in_stand_in()
+{
+    return depth > 0;
+}
+
+void set_external_ram(size_t bytes)
+{
+    external_size = bytes;
+}
+
+size_t external_ram_peak()
+{
+    return external_peak;
+}
+
+void set_app_partitions(const std::vector<std::string> &labels)
+{
+    app_partitions.clear();
+    for (const std::string &label : labels) {
+        app_partitions.push_back(app_partition(label));
+    }
+    running_partition = 0;
+}
+
+void set_running_partition(const char *label)
+{
+    for (size_t i = 0; i < app_partitions.size(); i++) {
+        if (strcmp(app_partitions[i].label, label) == 0) {
+            running_partition = i;
+            return;
+        }
+    }
+    abort();
+}
+
+} // namespace esp_matter_stand_in
+
+using esp_matter_stand_in::current_stats;
+using esp_matter_stand_in::Scope;
+
+namespace esp_matter {
+
+struct attribute_ {
+    uint32_t id;
+    uint16_t flags;
+    esp_matter_attr_val_t val;
+    std::unique_ptr<uint8_t[]> payload;
+    bool has_bounds;
+    esp_matter_attr_val_t min;
+    esp_matter_attr_val_t max;
+    attribute::callback_t override_callback;
+};
+
+struct event_ {
+    uint32_t id;
+};
+
+struct cluster_ {
+    uint32_t id;
+    uint8_t flags;
+    std::vector<std::unique_ptr<attribute_>> attributes;
+    std::vector<std::unique_ptr<event_>> events;
+};
+
+struct endpoint_ {
+    uint16_t id;
+    uint8_t flags;
+    bool enabled;
+    std::vector<std::pair<uint32_t, uint8_t>> device_types;
+    std::vector<std::unique_ptr<cluster_>> clusters;
+};
+
+struct node_ {
+    uint16_t next_endpoint_id;
+    std::vector<std::unique_ptr<endpoint_>> endpoints;
+};
+
+namespace {
+
+thread_local std::unique_ptr<node_> current_node;
+
+bool has_payload(esp_matter_val_type_t type)
+{
+    switch (static_cast<esp_matter_val_type_t>(type & ~ESP_MATTER_VAL_NULLABLE_BASE)) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Copy the value into the attribute, like esp_matter does for strings and arrays. */
+void store_val(attribute_ *attribute, const esp_matter_attr_val_t &val, uint16_t max_val_size)
+{
+    attribute->val = val;
+    attribute->payload.reset();
+    if (!has_payload(val.type)) {
+        return;
+    }
+    size_t size = std::max<size_t>(val.val.a.s, max_val_size);
+    if (size == 0) {
+        return;
+    }
+    attribute->payload.reset(new uint8_t[size]());
+    if (val.val.a.b && val.val.a.s) {
+        memcpy(attribute->payload.get(), val.val.a.b, val.val.a.s);
+    }
+    attribute->val.val.a.b = attribute->payload.get();
+    current_stats.attribute_payload_bytes += size;
+}
+
+} // namespace
+
+bool is_started()
+{
+    return esp_matter_stand_in::started;
+}
+
+namespace node {
+
+node_t *create_raw()
+{
+    Scope scope;
+    if (!current_node) {
+        current_node.reset(new node_{0, {}});
+    }
+    return current_node.get();
+}
+
+node_t *get()
+{
+    return current_node.get();
+}
+
+esp_err_t destroy()
+{
+    Scope scope;
+    // Like esp_matter, the node cannot be destroyed once the stack has started.
+    if (!current_node || esp_matter_stand_in::started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    current_stats.endpoints_destroyed += current_node->endpoints.size();
+    current_node.reset();
+    return ESP_OK;
+}
+
+} // namespace node
+
+namespace endpoint {
+
+namespace {
+
+endpoint_t *add(node_t *node, uint8_t flags, uint16_t endpoint_id)
+{
+    node->endpoints.emplace_back(new endpoint_{endpoint_id, flags, false, {}, {}});
+    current_stats.endpoints_created++;
+    return node->endpoints.back().get();
+}
+
+} // namespace
+
+endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv_data)
+{
+    Scope scope;
+    // Like esp_matter, only an endpoint id that create() has handed out before can be resumed.
+    if (!node || endpoint_id >= node->next_endpoint_id || get(node, endpoint_id)) {
+        return nullptr;
+    }
+    return add(node, flags, endpoint_id);
+}
+
+endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
+{
+    Scope scope;
+    if (!node || get(node, node->next_endpoint_id)) {
+        return nullptr;
+    }
+    return add(node, flags, node->next_endpoint_id++);
+}
+
+uint16_t get_next_id()
+{
+    return current_node ? current_node->next_endpoint_id : 0;
+}
+
+esp_err_t destroy(node_t *node, endpoint_t *endpoint)
+{
+    Scope scope;
+    if (!node || !endpoint) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!(endpoint->flags & ENDPOINT_FLAG_DESTROYABLE)) {
+        return ESP_FAIL;
+    }
+    auto it = std::find_if(node->endpoints.begin(), node->endpoints.end(),
+                           [endpoint](const std::unique_ptr<endpoint_> &entry) { return entry.get() == endpoint; });
+    if (it == node->endpoints.end()) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    node->endpoints.erase(it);
+    current_stats.endpoints_destroyed++;
+    return ESP_OK;
+}
+
+endpoint_t *get(node_t *node, uint16_t endpoint_id)
+{
+    if (!node) {
+        return nullptr;
+    }
+    for (const std::unique_ptr<endpoint_> &endpoint : node->endpoints) {
+        if (endpoint->id == endpoint_id) {
+            return endpoint.get();
+        }
+    }
+    return nullptr;
+}
+
+uint16_t get_id(endpoint_t *endpoint)
+{
+    return endpoint ? endpoint->id : 0xFFFF;
+}
+
+esp_err_t add_device_type(endpoint_t *endpoint, uint32_t device_type_id, uint8_t device_type_version)
+{
+    Scope scope;
+    if (!endpoint) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    endpoint->device_types.emplace_back(device_type_id, device_type_version);
+    current_stats.device_types_added++;
+    return ESP_OK;
+}
+
+esp_err_t enable(endpoint_t *endpoint)
+{
+    if (!endpoint) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    endpoint->enabled = true;
+    return ESP_OK;
+}
+
+} // namespace endpoint
+
+namespace cluster {
+
+cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
+{
+    Scope scope;
+    if (!endpoint) {
+        return nullptr;
+    }
+    endpoint->clusters.emplace_back(new cluster_{cluster_id, flags, {}, {}});
+    current_stats.clusters_created++;
+    return endpoint->clusters.back().get();
+}
+
+} // namespace cluster
+
+namespace attribute {
+
+attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, esp_matter_attr_val_t val,
+                    uint16_t max_val_size)
+{
+    Scope scope;
+    if (!cluster) {
+        return nullptr;
+    }
+    std::unique_ptr<attribute_> attribute(new attribute_{attribute_id, flags, {}, nullptr, false, {}, {}, nullptr});
+    store_val(attribute.get(), val, max_val_size);
+    cluster->attributes.push_back(std::move(attribute));
+    current_stats.attributes_created++;
+    return cluster->attributes.back().get();
+}
+
+attribute_t *get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    endpoint_t *endpoint = endpoint::get(current_node.get(), endpoint_id);
+    if (!endpoint) {
+        return nullptr;
+    }
+    for (const std::unique_ptr<cluster_> &cluster : endpoint->clusters) {
+        current_stats.lookup_steps++;
+        if (cluster->id != cluster_id) {
+            continue;
+        }
+        for (const std::unique_ptr<attribute_> &attribute : cluster->attributes) {
+            current_stats.lookup_steps++;
+            if (attribute->id == attribute_id) {
+                return attribute.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matter_attr_val_t max)
+{
+    if (!attribute) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    attribute->has_bounds = true;
+    attribute->min = min;
+    attribute->max = max;
+    current_stats.bounds_added++;
+    return ESP_OK;
+}
+
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    Scope scope;
+    attribute_t *attribute = get(endpoint_id, cluster_id, attribute_id);
+    if (!attribute || !val) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    store_val(attribute, *val, 0);
+    current_stats.attributes_updated++;
+    return ESP_OK;
+}
+
+esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (!get(endpoint_id, cluster_id, attribute_id) || !val) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    current_stats.attributes_reported++;
+    return ESP_OK;
+}
+
+esp_err_t set_override_callback(attribute_t *attribute, callback_t callback)
+{
+    if (!attribute) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    attribute->override_callback = callback;
+    return ESP_OK;
+}
+
+} // namespace attribute
+
+namespace event {
+
+event_t *create(cluster_t *cluster, uint32_t event_id)
+{
+    Scope scope;
+    if (!cluster) {
+        return nullptr;
+    }
+    cluster->events.emplace_back(new event_{event_id});
+    current_stats.events_created++;
+    return cluster->events.back().get();
+}
+
+} // namespace event
+
+namespace lock {
+
+ScopedChipStackLock::ScopedChipStackLock(uint32_t ticks_to_wait)
+{
+    current_stats.lock_acquisitions++;
+}
+
+ScopedChipStackLock::~ScopedChipStackLock() {}
+
+} // namespace lock
+
+} // namespace esp_matter
+
+esp_err_t esp_matter_stand_in::read_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                              esp_matter_attr_val_t &val)
+{
+    esp_matter::attribute_t *attribute = esp_matter::attribute::get(endpoint_id, cluster_id, attribute_id);
+    if (!attribute) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if ((attribute->flags & esp_matter::ATTRIBUTE_FLAG_OVERRIDE) && attribute->override_callback) {
+        current_stats.override_reads++;
+        val = attribute->val;
+        return attribute->override_callback(esp_matter::attribute::READ, endpoint_id, cluster_id, attribute_id, &val,
+                                            nullptr);
+    }
+    val = attribute->val;
+    return ESP_OK;
+}
+
+void esp_matter_stand_in::reset()
+{
+    Scope scope;
+    esp_matter::current_node.reset();
+    current_stats = {};
+    esp_matter_stand_in::external_peak = esp_matter_stand_in::external_used;
+}
+
+//////////////////////
+// Attribute values //
+//////////////////////
+
+#define ESP_MATTER_STAND_IN_VAL(name, c_type, member, val_type)             \
+    esp_matter_attr_val_t esp_matter_##name(c_type val)                   \
+    {                                                                     \
+        esp_matter_attr_val_t attr_val = {};                              \
+        attr_val.type = val_type;                                         \
+        attr_val.val.member = val;                                        \
+        return attr_val;                                                  \
+    }                                                                     \
+    esp_matter_attr_val_t esp_matter_nullable_##name(nullable<c_type> val)\
+    {                                                                     \
+        esp_matter_attr_val_t attr_val = {};                              \
+        attr_val.type = static_cast<esp_matter_val_type_t>(val_type | ESP_MATTER_VAL_NULLABLE_BASE); \
+        attr_val.val.member = val.value();                                \
+        return attr_val;                                                  \
+    }
+
+ESP_MATTER_STAND_IN_VAL(bool, bool, b, ESP_MATTER_VAL_TYPE_BOOLEAN)
+ESP_MATTER_STAND_IN_VAL(int8, int8_t, i8, ESP_MATTER_VAL_TYPE_INT8)
+ESP_MATTER_STAND_IN_VAL(uint8, uint8_t, u8, ESP_MATTER_VAL_TYPE_UINT8)
+ESP_MATTER_STAND_IN_VAL(int16, int16_t, i16, ESP_MATTER_VAL_TYPE_INT16)
+ESP_MATTER_STAND_IN_VAL(uint16, uint16_t, u16, ESP_MATTER_VAL_TYPE_UINT16)
+ESP_MATTER_STAND_IN_VAL(int32, int32_t, i32, ESP_MATTER_VAL_TYPE_INT32)
+ESP_MATTER_STAND_IN_VAL(uint32, uint32_t, u32, ESP_MATTER_VAL_TYPE_UINT32)
+ESP_MATTER_STAND_IN_VAL(int64, int64_t, i64, ESP_MATTER_VAL_TYPE_INT64)
+ESP_MATTER_STAND_IN_VAL(uint64, uint64_t, u64, ESP_MATTER_VAL_TYPE_UINT64)
+ESP_MATTER_STAND_IN_VAL(float, float, f, ESP_MATTER_VAL_TYPE_FLOAT)
+ESP_MATTER_STAND_IN_VAL(enum8, uint8_t, u8, ESP_MATTER_VAL_TYPE_ENUM8)
+ESP_MATTER_STAND_IN_VAL(enum16, uint16_t, u16, ESP_MATTER_VAL_TYPE_ENUM16)
+ESP_MATTER_STAND_IN_VAL(bitmap8, uint8_t, u8, ESP_MATTER_VAL_TYPE_BITMAP8)
+ESP_MATTER_STAND_IN_VAL(bitmap16, uint16_t, u16, ESP_MATTER_VAL_TYPE_BITMAP16)
+ESP_MATTER_STAND_IN_VAL(bitmap32, uint32_t, u32, ESP_MATTER_VAL_TYPE_BITMAP32)
+
+#undef ESP_MATTER_STAND_IN_VAL
+
+static esp_matter_attr_val_t payload_val(esp_matter_val_type_t type, void *data, uint16_t size, uint16_t count)
+{
+    esp_matter_attr_val_t attr_val = {};
+    attr_val.type = type;
+    attr_val.val.a.b = static_cast<uint8_t *>(data);
+    attr_val.val.a.s = size;
+    attr_val.val.a.n = count;
+    attr_val.val.a.t = size;
+    return attr_val;
+}
+
+esp_matter_attr_val_t esp_matter_char_str(char *val, uint16_t data_size)
+{
+    return payload_val(ESP_MATTER_VAL_TYPE_CHAR_STRING, val, data_size, data_size);
+}
+
+esp_matter_attr_val_t esp_matter_long_char_str(char *val, uint16_t data_size)
+{
+    return payload_val(ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING, val, data_size, data_size);
+}
+
+esp_matter_attr_val_t esp_matter_octet_str(uint8_t *val, uint16_t data_size)
+{
+    return payload_val(ESP_MATTER_VAL_TYPE_OCTET_STRING, val, data_size, data_size);
+}
+
+esp_matter_attr_val_t esp_matter_long_octet_str(uint8_t *val, uint16_t data_size)
+{
+    return payload_val(ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING, val, data_size, data_size);
+}
+
+esp_matter_attr_val_t esp_matter_array(uint8_t *val, uint16_t data_size, uint16_t count)
+{
+    return payload_val(ESP_MATTER_VAL_TYPE_ARRAY, val, data_size, count);
+}
+
+/////////////////////
+// cmd_c_routines //
+/////////////////////
+
+// Like cmd_c_routines, which only knows the standard clusters, vendor clusters have no plugin and no callbacks.
+static bool is_vendor_cluster(uint32_t cluster_id)
+{
+    return (cluster_id >> 16) != 0;
+}
+
+esp_err_t register_command_cb(esp_matter::cluster_t *cluster, uint32_t cluster_id, uint32_t command_id, uint8_t flag)
+{
+    if (!cluster) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (is_vendor_cluster(cluster_id)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    current_stats.commands_registered++;
+    return ESP_OK;
+}
+
+esp_err_t cluster_plugin_init(esp_matter::cluster_t *cluster, uint32_t cluster_id)
+{
+    if (!cluster) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return is_vendor_cluster(cluster_id) ? ESP_ERR_NOT_FOUND : ESP_OK;
+}
+
+///////////////
+// heap_caps //
+///////////////
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    using namespace esp_matter_stand_in;
+    if (!(caps & MALLOC_CAP_SPIRAM)) {
+        return malloc(size);
+    }
+    if (size > external_size - external_used) {
+        return nullptr;
+    }
+    Scope scope;
+    void *ptr = malloc(size);
+    if (ptr) {
+        external_blocks[ptr] = size;
+        external_used += size;
+        external_peak = std::max(external_peak, external_used);
+    }
+    return ptr;
+}
+
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...)
+{
+    va_list caps_list;
+    va_start(caps_list, num);
+    void *ptr = nullptr;
+    for (size_t i = 0; i < num && !ptr; i++) {
+        ptr = heap_caps_malloc(size, va_arg(caps_list, uint32_t));
+    }
+    va_end(caps_list);
+    return ptr;
+}
+
+void heap_caps_free(void *ptr)
+{
+    using namespace esp_matter_stand_in;
+    auto block = external_blocks.find(ptr);
+    if (block == external_blocks.end()) {
+        free(ptr);
+        return;
+    }
+    Scope scope;
+    external_used -= block->second;
+    external_blocks.erase(block);
+    free(ptr);
+}
+
+bool esp_ptr_external_ram(const void *p)
+{
+    return esp_matter_stand_in::external_blocks.count(p) != 0;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct esp_partition_iterator_opaque_ {
+    size_t index;
+    std::string label;  // empty to list all the partitions
+};
+
+static esp_partition_iterator_t find_partition_from(esp_partition_iterator_t iterator)
+{
+    using esp_matter_stand_in::app_partitions;
+    for (; iterator->index < app_partitions.size(); iterator->index++) {
+        if (iterator->label.empty() || iterator->label == app_partitions[iterator->index].label) {
+            return iterator;
+        }
+    }
+    delete iterator;
+    return nullptr;
+}
+
+esp_partition_iterator_t esp_partition_find(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                            const char *label)
+{
+    if (type != ESP_PARTITION_TYPE_APP) {
+        return nullptr;
+    }
+    return find_partition_from(new esp_partition_iterator_opaque_{0, label ? label : ""});
+}
+
+const esp_partition_t *esp_partition_get(esp_partition_iterator_t iterator)
+{
+    return &esp_matter_stand_in::app_partitions[iterator->index];
+}
+
+esp_partition_iterator_t esp_partition_next(esp_partition_iterator_t iterator)
+{
+    iterator->index++;
+    return find_partition_from(iterator);
+}
+
+void esp_partition_iterator_release(esp_partition_iterator_t iterator)
+{
+    delete iterator;
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void)
+{
+    using namespace esp_matter_stand_in;
+    return running_partition < app_partitions.size() ? &app_partitions[running_partition] : nullptr;
+}
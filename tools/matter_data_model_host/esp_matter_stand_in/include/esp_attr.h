@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_ATTR_H
+#define ESP_ATTR_H
+
+/* Host stand-in: no RTC memory, the variable is zeroed at every start like after a power-on. */
+#define RTC_NOINIT_ATTR
+
+#endif // ESP_ATTR_H
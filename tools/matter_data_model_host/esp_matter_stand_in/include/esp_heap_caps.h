@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+/*
+ * Host stand-in for the heap_caps allocation functions used by allocator_policy::HeapCapsPolicy.
+ * MALLOC_CAP_SPIRAM allocations come from a simulated external RAM of the size given to
+ * esp_matter_stand_in::set_external_ram(), none by default; all other allocations use malloc().
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_malloc_prefer(size_t size, size_t num, ...);
+void heap_caps_free(void *ptr);
+
+#endif // ESP_HEAP_CAPS_H
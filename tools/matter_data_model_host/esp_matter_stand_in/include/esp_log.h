@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+/* Host stand-in for the ESP-IDF log macros, printing to stderr up to esp_matter_stand_in::log_level. */
+#include <stdio.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+namespace esp_matter_stand_in {
+extern esp_log_level_t log_level;
+}
+
+#define ESP_LOG_LEVEL_HOST(level, letter, tag, format, ...)                                   \
+    do {                                                                                       \
+        if (esp_matter_stand_in::log_level >= level) {                                         \
+            fprintf(stderr, letter " (%s): " format "\n", tag, ##__VA_ARGS__);                \
+        }                                                                                      \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#endif // ESP_LOG_H
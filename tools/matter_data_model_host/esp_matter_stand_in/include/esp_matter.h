@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_MATTER_H
+#define ESP_MATTER_H
+
+/*
+ * Host stand-in for the part of the esp_matter API used by the interpreter.
+ *
+ * The types and signatures follow esp_matter, the implementation in esp_matter_stand_in.cpp keeps
+ * the created data model in memory and records the calls, see esp_matter_stand_in.hpp.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum {
+    ESP_MATTER_VAL_TYPE_INVALID = 0,
+    ESP_MATTER_VAL_TYPE_BOOLEAN = 1,
+    ESP_MATTER_VAL_TYPE_INTEGER = 2,
+    ESP_MATTER_VAL_TYPE_FLOAT = 3,
+    ESP_MATTER_VAL_TYPE_ARRAY = 4,
+    ESP_MATTER_VAL_TYPE_CHAR_STRING = 5,
+    ESP_MATTER_VAL_TYPE_OCTET_STRING = 6,
+    ESP_MATTER_VAL_TYPE_INT8 = 7,
+    ESP_MATTER_VAL_TYPE_UINT8 = 8,
+    ESP_MATTER_VAL_TYPE_INT16 = 9,
+    ESP_MATTER_VAL_TYPE_UINT16 = 10,
+    ESP_MATTER_VAL_TYPE_INT32 = 11,
+    ESP_MATTER_VAL_TYPE_UINT32 = 12,
+    ESP_MATTER_VAL_TYPE_INT64 = 13,
+    ESP_MATTER_VAL_TYPE_UINT64 = 14,
+    ESP_MATTER_VAL_TYPE_ENUM8 = 15,
+    ESP_MATTER_VAL_TYPE_BITMAP8 = 16,
+    ESP_MATTER_VAL_TYPE_BITMAP16 = 17,
+    ESP_MATTER_VAL_TYPE_BITMAP32 = 18,
+    ESP_MATTER_VAL_TYPE_ENUM16 = 19,
+    ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING = 20,
+    ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING = 21,
+    ESP_MATTER_VAL_NULLABLE_BASE = 0x80,
+} esp_matter_val_type_t;
+
+typedef union {
+    bool b;
+    int i;
+    float f;
+    int8_t i8;
+    uint8_t u8;
+    int16_t i16;
+    uint16_t u16;
+    int32_t i32;
+    uint32_t u32;
+    int64_t i64;
+    uint64_t u64;
+    struct {
+        uint8_t *b;
+        uint16_t s;
+        uint16_t n;
+        uint16_t t;
+    } a;
+    void *p;
+} esp_matter_val_t;
+
+typedef struct {
+    esp_matter_val_type_t type;
+    esp_matter_val_t val;
+} esp_matter_attr_val_t;
+
+/* Simplified nullable: esp_matter stores null as a reserved value of the type, here it is a flag. */
+template <typename T>
+class nullable {
+public:
+    nullable() : val_(), null_(true) {}
+    nullable(T val) : val_(val), null_(false) {}
+    bool is_null() const { return null_; }
+    T value() const { return val_; }
+
+private:
+    T val_;
+    bool null_;
+};
+
+#define ESP_MATTER_STAND_IN_VAL(name, type)                          \
+    esp_matter_attr_val_t esp_matter_##name(type val);                \
+    esp_matter_attr_val_t esp_matter_nullable_##name(nullable<type> val);
+
+ESP_MATTER_STAND_IN_VAL(bool, bool)
+ESP_MATTER_STAND_IN_VAL(int8, int8_t)
+ESP_MATTER_STAND_IN_VAL(uint8, uint8_t)
+ESP_MATTER_STAND_IN_VAL(int16, int16_t)
+ESP_MATTER_STAND_IN_VAL(uint16, uint16_t)
+ESP_MATTER_STAND_IN_VAL(int32, int32_t)
+ESP_MATTER_STAND_IN_VAL(uint32, uint32_t)
+ESP_MATTER_STAND_IN_VAL(int64, int64_t)
+ESP_MATTER_STAND_IN_VAL(uint64, uint64_t)
+ESP_MATTER_STAND_IN_VAL(float, float)
+ESP_MATTER_STAND_IN_VAL(enum8, uint8_t)
+ESP_MATTER_STAND_IN_VAL(enum16, uint16_t)
+ESP_MATTER_STAND_IN_VAL(bitmap8, uint8_t)
+ESP_MATTER_STAND_IN_VAL(bitmap16, uint16_t)
+ESP_MATTER_STAND_IN_VAL(bitmap32, uint32_t)
+
+#undef ESP_MATTER_STAND_IN_VAL
+
+esp_matter_attr_val_t esp_matter_char_str(char *val, uint16_t data_size);
+esp_matter_attr_val_t esp_matter_long_char_str(char *val, uint16_t data_size);
+esp_matter_attr_val_t esp_matter_octet_str(uint8_t *val, uint16_t data_size);
+esp_matter_attr_val_t esp_matter_long_octet_str(uint8_t *val, uint16_t data_size);
+esp_matter_attr_val_t esp_matter_array(uint8_t *val, uint16_t data_size, uint16_t count);
+
+namespace esp_matter {
+
+typedef struct node_ node_t;
+typedef struct endpoint_ endpoint_t;
+typedef struct cluster_ cluster_t;
+typedef struct attribute_ attribute_t;
+typedef struct command_ command_t;
+typedef struct event_ event_t;
+
+enum attribute_flags {
+    ATTRIBUTE_FLAG_NONE = 0x00,
+    ATTRIBUTE_FLAG_WRITABLE = 0x01,
+    ATTRIBUTE_FLAG_NONVOLATILE = 0x02,
+    ATTRIBUTE_FLAG_MIN_MAX = 0x04,
+    ATTRIBUTE_FLAG_MUST_USE_TIMED_WRITE = 0x08,
+    ATTRIBUTE_FLAG_EXTERNAL_STORAGE = 0x10,
+    ATTRIBUTE_FLAG_SINGLETON = 0x20,
+    ATTRIBUTE_FLAG_NULLABLE = 0x40,
+    ATTRIBUTE_FLAG_OVERRIDE = 0x80,
+    ATTRIBUTE_FLAG_DEFERRED = 0x100,
+    ATTRIBUTE_FLAG_MANAGED_INTERNALLY = 0x200,
+};
+
+enum endpoint_flags {
+    ENDPOINT_FLAG_NONE = 0x00,
+    ENDPOINT_FLAG_DESTROYABLE = 0x01,
+    ENDPOINT_FLAG_BRIDGE = 0x02,
+};
+
+bool is_started();
+
+namespace node {
+node_t *create_raw();
+node_t *get();
+esp_err_t destroy();
+} // namespace node
+
+namespace endpoint {
+endpoint_t *create(node_t *node, uint8_t flags, void *priv_data);
+endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv_data);
+esp_err_t destroy(node_t *node, endpoint_t *endpoint);
+uint16_t get_next_id();
+endpoint_t *get(node_t *node, uint16_t endpoint_id);
+uint16_t get_id(endpoint_t *endpoint);
+esp_err_t add_device_type(endpoint_t *endpoint, uint32_t device_type_id, uint8_t device_type_version);
+esp_err_t enable(endpoint_t *endpoint);
+} // namespace endpoint
+
+namespace cluster {
+cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags);
+} // namespace cluster
+
+namespace attribute {
+typedef enum {
+    PRE_UPDATE,
+    POST_UPDATE,
+    READ,
+    WRITE,
+} callback_type_t;
+
+typedef esp_err_t (*callback_t)(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                esp_matter_attr_val_t *val, void *priv_data);
+
+attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, esp_matter_attr_val_t val,
+                    uint16_t max_val_size = 0);
+attribute_t *get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matter_attr_val_t max);
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+esp_err_t set_override_callback(attribute_t *attribute, callback_t callback);
+} // namespace attribute
+
+namespace event {
+event_t *create(cluster_t *cluster, uint32_t event_id);
+} // namespace event
+
+namespace lock {
+class ScopedChipStackLock {
+public:
+    ScopedChipStackLock(uint32_t ticks_to_wait);
+    ~ScopedChipStackLock();
+};
+} // namespace lock
+
+} // namespace esp_matter
+
+#endif // ESP_MATTER_H
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_MATTER_STAND_IN_HPP
+#define ESP_MATTER_STAND_IN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "esp_log.h"
+#include "esp_matter.h"
+
+namespace esp_matter_stand_in {
+
+/*
+ * The node created by esp_matter::node::create_raw(), the stats and the started flag belong to the
+ * calling thread, so every thread can build its own node.
+ */
+
+/* Calls made to the stand-in by the calling thread since the last reset(). */
+struct Stats {
+    size_t endpoints_created;
+    size_t endpoints_destroyed;
+    size_t device_types_added;
+    size_t clusters_created;
+    size_t attributes_created;
+    size_t attribute_payload_bytes;  // strings and arrays copied into the attributes
+    size_t bounds_added;
+    size_t attributes_updated;
+    size_t attributes_reported;
+    size_t commands_registered;
+    size_t events_created;
+    size_t lock_acquisitions;
+    size_t lookup_steps;  // clusters and attributes visited by attribute::get() by ids
+    size_t override_reads;  // reads of read_attribute() answered by an override callback
+};
+
+const Stats &stats();
+
+/* Destroy the node of the calling thread and clear its stats. */
+void reset();
+
+/*
+ * Read an attribute like the interaction model does for a controller: through the override callback
+ * of the attribute if it has one, otherwise from the stored value. val points into the attribute or
+ * into memory owned by the callback.
+ */
+esp_err_t read_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t &val);
+
+/* Return value of esp_matter::is_started(), false by default. */
+void set_started(bool started);
+
+/*
+ * True while the calling thread is inside the stand-in. Allocation counters use it to leave out the
+ * memory the stand-in allocates for the data model, which esp_matter accounts for on the device.
+ */
+bool in_stand_in();
+
+/*
+ * Size of the simulated external RAM of the calling thread, used by heap_caps_malloc() with
+ * MALLOC_CAP_SPIRAM, 0 (no PSRAM) by default. Blocks in it are not counted by the allocation
+ * counters, as they are not taken from the internal heap.
+ */
+void set_external_ram(size_t bytes);
+
+/* Peak use of the simulated external RAM since the last reset(). */
+size_t external_ram_peak();
+
+/*
+ * App partitions of the calling thread, listed by esp_partition_find(), "ota_0" and "ota_1" by
+ * default. The running partition, returned by esp_ota_get_running_partition(), is the first one
+ * until set_running_partition() picks another.
+ */
+void set_app_partitions(const std::vector<std::string> &labels);
+
+/* Make the app partition with this label the running one, like a boot after a firmware OTA. */
+void set_running_partition(const char *label);
+
+} // namespace esp_matter_stand_in
+
+#endif // ESP_MATTER_STAND_IN_HPP
@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_MEMORY_UTILS_H
+#define ESP_MEMORY_UTILS_H
+
+/* Host stand-in: true for blocks of the simulated external RAM, see esp_heap_caps.h. */
+bool esp_ptr_external_ram(const void *p);
+
+#endif // ESP_MEMORY_UTILS_H
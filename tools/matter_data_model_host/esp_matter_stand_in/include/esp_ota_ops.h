@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_OTA_OPS_H
+#define ESP_OTA_OPS_H
+
+/* Host stand-in: the running partition is set with esp_matter_stand_in::set_running_partition(). */
+#include "esp_partition.h"
+
+const esp_partition_t *esp_ota_get_running_partition(void);
+
+#endif // ESP_OTA_OPS_H
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_ROM_CRC_H
+#define ESP_ROM_CRC_H
+
+/* Host stand-in: CRC-32 (IEEE 802.3), esp_rom_crc32_le(0, buf, len) is zlib's crc32(buf, len). */
+#include <stdint.h>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len);
+
+#endif // ESP_ROM_CRC_H
@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+/* Host stand-in: every start is a power-on. */
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+} esp_reset_reason_t;
+
+static inline esp_reset_reason_t esp_reset_reason(void)
+{
+    return ESP_RST_POWERON;
+}
+
+#endif // ESP_SYSTEM_H
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+/* Host stand-in: microseconds from a monotonic clock. */
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+/* Host stand-in for the FreeRTOS definitions the interpreter uses. */
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdTRUE ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS pdTRUE
+#define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY ((BaseType_t)-1)
+
+/* Threads are not pinned to cores on the host, they all report core 0. */
+static inline BaseType_t xPortGetCoreID(void)
+{
+    return 0;
+}
+
+#endif // FREERTOS_H
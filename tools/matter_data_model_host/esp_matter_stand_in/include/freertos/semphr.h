@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef SEMPHR_H
+#define SEMPHR_H
+
+/*
+ * Host stand-in for the FreeRTOS mutexes and binary semaphores, on top of pthreads. A mutex is a
+ * binary semaphore created given, without priority inheritance. Only waits forever.
+ */
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t given;
+    int count;    // 0 or 1
+    int dynamic;  // created by xSemaphoreCreateBinary()
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t stand_in_semaphore_init(StaticSemaphore_t *buffer, int count, int dynamic)
+{
+    pthread_mutex_init(&buffer->mutex, NULL);
+    pthread_cond_init(&buffer->given, NULL);
+    buffer->count = count;
+    buffer->dynamic = dynamic;
+    return buffer;
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+    return stand_in_semaphore_init(buffer, 1, 0);
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    StaticSemaphore_t *buffer = (StaticSemaphore_t *)malloc(sizeof(StaticSemaphore_t));
+    return buffer ? stand_in_semaphore_init(buffer, 0, 1) : NULL;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    (void)ticks;
+    pthread_mutex_lock(&semaphore->mutex);
+    while (semaphore->count == 0) {
+        pthread_cond_wait(&semaphore->given, &semaphore->mutex);
+    }
+    semaphore->count = 0;
+    pthread_mutex_unlock(&semaphore->mutex);
+    return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    pthread_mutex_lock(&semaphore->mutex);
+    BaseType_t given = semaphore->count == 0 ? pdTRUE : pdFALSE;
+    semaphore->count = 1;
+    pthread_cond_signal(&semaphore->given);
+    pthread_mutex_unlock(&semaphore->mutex);
+    return given;
+}
+
+static inline void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    pthread_cond_destroy(&semaphore->given);
+    pthread_mutex_destroy(&semaphore->mutex);
+    if (semaphore->dynamic) {
+        free(semaphore);
+    }
+}
+
+#endif // SEMPHR_H
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef TASK_H
+#define TASK_H
+
+/*
+ * Host stand-in for the FreeRTOS tasks of the pipelined decode: a task is a detached thread. The
+ * name, stack depth, priority and core are not used, and a task can only delete itself.
+ */
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+typedef void *TaskHandle_t;
+
+typedef struct {
+    TaskFunction_t function;
+    void *arg;
+} stand_in_task_t;
+
+static inline void *stand_in_task_entry(void *start)
+{
+    stand_in_task_t task = *(stand_in_task_t *)start;
+    free(start);
+    task.function(task.arg);
+    return NULL;
+}
+
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack_depth,
+                                                 void *arg, UBaseType_t priority, TaskHandle_t *created,
+                                                 BaseType_t core_id)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    (void)core_id;
+    stand_in_task_t *start = (stand_in_task_t *)malloc(sizeof(stand_in_task_t));
+    if (!start) {
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+    start->function = function;
+    start->arg = arg;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_t thread;
+    int err = pthread_create(&thread, &attr, stand_in_task_entry, start);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        free(start);
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+    if (created) {
+        *created = NULL;
+    }
+    return pdPASS;
+}
+
+static inline UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    (void)task;
+    return 0;
+}
+
+static inline void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+    pthread_exit(NULL);
+}
+
+#endif // TASK_H
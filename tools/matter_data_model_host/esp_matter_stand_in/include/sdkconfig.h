@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+/*
+ * Host configuration of the interpreter. Like the IDF Linux target, each thread has its own node.
+ * The interpreter decodes sequentially, except in the dm_interpreter_pipelined library, built with
+ * DM_HOST_PIPELINED_DECODE, whose decode task is a thread of the FreeRTOS stand-in.
+ */
+#define CONFIG_IDF_TARGET_LINUX 1
+#define CONFIG_DM_INTERPRETER_VALIDATE 1
+#define CONFIG_DM_INTERPRETER_ATTRIBUTE_INDEX 1
+
+#ifdef DM_HOST_PIPELINED_DECODE
+#define CONFIG_DM_INTERPRETER_PIPELINED_DECODE 1
+#define CONFIG_DM_INTERPRETER_DECODE_RING_SIZE 32
+#define CONFIG_DM_INTERPRETER_DECODE_TASK_STACK_SIZE 3072
+#endif
+
+#endif // SDKCONFIG_H
@@ -0,0 +1,573 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host benchmark of Interpreter::interpret_data() on synthetic data models.
+ *
+ *   matter_dm_bench [--endpoints 1,10,50,100,250,500] [--mix scalar,string,mixed,pooled] [--runs <n>]
+ *                   [--psram <bytes>] [--output <file>] [--compare <baseline> [--tolerance <percent>]]
+ *   matter_dm_bench --lookups <n> [--endpoints ...] [--mix ...] [--runs <n>] [--output <file>]
+ *
+ * The interpreter is linked against the recording esp_matter stand-in, so the numbers cover the
+ * decoding and the interpreter's own work, not the esp_matter data model. Each case prints one JSON
+ * object (JSON Lines):
+ *
+ *   decode              "sequential", or "pipelined" for matter_dm_bench_pipelined, built with
+ *                       CONFIG_DM_INTERPRETER_PIPELINED_DECODE and a thread as the decode task
+ *   ns_per_message      median over the runs of the interpret_data() time per message
+ *   allocs_per_message  heap allocations made by the interpreter per message
+ *   peak_heap_bytes     peak heap used by the interpreter above what it held before the run
+ *   external_peak_bytes peak use of the simulated PSRAM, 0 without --psram
+ *
+ * With --psram, the interpreter takes its buffers from an allocator_policy::HeapCapsPolicy with
+ * MALLOC_CAP_SPIRAM, backed by a simulated PSRAM of that size, so peak_heap_bytes shows the
+ * internal RAM left to the rest of the application.
+ *
+ * With --compare, the cases are checked against a previous output and the exit status is 1 when
+ * one of the metrics grew by more than the tolerance (10% by default, allocations and heap are
+ * compared exactly as they do not depend on the machine). The pipelined decode overlaps decoding
+ * with the work of the calling thread only when the host has a second core to run it on.
+ *
+ * With --lookups, the benchmark times the attribute lookup of the interaction model read and write
+ * path instead: esp_matter::attribute::get() by ids, which walks the endpoints, the clusters of the
+ * endpoint and the attributes of the cluster in creation order. The model is created once in the
+ * default order and once ordered by synthetic_model::light_profile(), like the serializer does with
+ * --access-profile, and both are looked up with the same <n> accesses per run: 90% drawn from the
+ * profile, the rest from all attributes. The model in the default order is also looked up with
+ * Interpreter::get_attribute(), through the attribute index of the interpreter.
+ *
+ *   ns_per_lookup              median over the runs, model in the default order
+ *   ns_per_lookup_profiled     median over the runs, model ordered by the profile
+ *   steps_per_lookup           clusters and attributes visited per lookup, model in the default order
+ *   steps_per_lookup_profiled  clusters and attributes visited per lookup, model ordered by the profile
+ *   ns_per_lookup_indexed      median over the runs, Interpreter::get_attribute()
+ *   index_bytes                heap taken by the attribute index
+ *
+ * The steps do not depend on the machine. On the host the lists stay in the L1 cache, so the time
+ * gained per step is much smaller than on a device.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <malloc.h>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "allocator_policy.hpp"
+#include "esp_heap_caps.h"
+#include "esp_matter_data_model_interpreter.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "sdkconfig.h"
+#include "synthetic_model.hpp"
+
+/*
+ * Heap accounting, by replacing malloc and friends with wrappers around glibc. Only the allocations
+ * made while a run is measured and outside of the stand-in are counted.
+ */
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+const char *const DECODE_MODE = "pipelined";
+#else
+const char *const DECODE_MODE = "sequential";
+#endif
+
+// Atomic, as the decode task of the pipelined decode allocates the messages the calling thread frees.
+struct HeapCounters {
+    std::atomic<bool> enabled{false};
+    std::atomic<size_t> allocations{0};
+    std::atomic<long long> live{0};
+    std::atomic<long long> peak{0};
+};
+
+HeapCounters heap;
+
+void start_counting()
+{
+    heap.allocations = 0;
+    heap.live = 0;
+    heap.peak = 0;
+    heap.enabled = true;
+}
+
+bool counted()
+{
+    return heap.enabled && !esp_matter_stand_in::in_stand_in();
+}
+
+void on_alloc(void *ptr)
+{
+    if (ptr && counted()) {
+        heap.allocations++;
+        long long live = heap.live += malloc_usable_size(ptr);
+        long long peak = heap.peak;
+        while (live > peak && !heap.peak.compare_exchange_weak(peak, live)) {
+        }
+    }
+}
+
+void on_free(void *ptr)
+{
+    if (ptr && counted()) {
+        heap.live -= malloc_usable_size(ptr);
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+void *malloc(size_t size)
+{
+    void *ptr = __libc_malloc(size);
+    on_alloc(ptr);
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size)
+{
+    void *ptr = __libc_calloc(count, size);
+    on_alloc(ptr);
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    on_free(ptr);
+    void *new_ptr = __libc_realloc(ptr, size);
+    on_alloc(new_ptr);
+    return new_ptr;
+}
+
+void free(void *ptr)
+{
+    on_free(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+namespace {
+
+using synthetic_model::Mix;
+
+struct Result {
+    std::string mix;
+    unsigned endpoints;
+    size_t bytes;
+    size_t messages;
+    size_t attributes;
+    unsigned runs;
+    double ns_per_message;
+    double ns_per_message_min;
+    double allocs_per_message;
+    long long peak_heap_bytes;
+    size_t external_peak_bytes;
+};
+
+bool run_case(Mix mix, unsigned endpoints, unsigned runs, size_t psram, Result &result)
+{
+    synthetic_model::Shape shape;
+    shape.endpoints = endpoints;
+    shape.mix = mix;
+    synthetic_model::Model model = synthetic_model::generate(shape);
+
+    std::vector<double> ns_per_message;
+    size_t allocations = 0;
+    long long peak = 0;
+    size_t external_peak = 0;
+    esp_matter_stand_in::set_external_ram(psram);
+    allocator_policy::HeapCapsPolicy psram_policy(MALLOC_CAP_SPIRAM);
+    allocator_policy::Policy &policy = psram ? psram_policy : allocator_policy::default_policy();
+    // The first run warms up the caches and is not recorded.
+    for (unsigned run = 0; run <= runs; run++) {
+        esp_matter_stand_in::reset();
+        esp_matter_data_model_interpreter::Interpreter interpreter(policy);
+
+        start_counting();
+        auto start = std::chrono::steady_clock::now();
+        esp_matter::node_t *node = interpreter.interpret_data(model.data.data(), model.data.size());
+        auto end = std::chrono::steady_clock::now();
+        heap.enabled = false;
+
+        if (!node) {
+            fprintf(stderr, "%s/%u: interpret_data() failed\n", synthetic_model::mix_name(mix), endpoints);
+            return false;
+        }
+        if (esp_matter_stand_in::stats().attributes_created != model.attributes) {
+            fprintf(stderr, "%s/%u: created %zu attributes, expected %zu\n", synthetic_model::mix_name(mix), endpoints,
+                    esp_matter_stand_in::stats().attributes_created, model.attributes);
+            return false;
+        }
+        if (run == 0) {
+            continue;
+        }
+        ns_per_message.push_back(std::chrono::duration<double, std::nano>(end - start).count() / model.messages);
+        allocations = std::max(allocations, heap.allocations.load());
+        peak = std::max(peak, heap.peak.load());
+        external_peak = std::max(external_peak, esp_matter_stand_in::external_ram_peak());
+    }
+    esp_matter_stand_in::reset();
+
+    std::sort(ns_per_message.begin(), ns_per_message.end());
+    result.mix = synthetic_model::mix_name(mix);
+    result.endpoints = endpoints;
+    result.bytes = model.data.size();
+    result.messages = model.messages;
+    result.attributes = model.attributes;
+    result.runs = runs;
+    result.ns_per_message = ns_per_message[ns_per_message.size() / 2];
+    result.ns_per_message_min = ns_per_message.front();
+    result.allocs_per_message = static_cast<double>(allocations) / model.messages;
+    result.peak_heap_bytes = peak;
+    result.external_peak_bytes = external_peak;
+    return true;
+}
+
+struct LookupResult {
+    std::string mix;
+    unsigned endpoints;
+    size_t lookups;
+    unsigned runs;
+    double ns_per_lookup;
+    double ns_per_lookup_profiled;
+    double steps_per_lookup;
+    double steps_per_lookup_profiled;
+    double ns_per_lookup_indexed;
+    size_t index_bytes;
+};
+
+struct AttributePath {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+};
+
+/* Accesses of a run: 90% drawn from the profile, weighted by count, the rest from all attributes. */
+std::vector<AttributePath> access_sequence(const synthetic_model::Shape &shape, size_t lookups)
+{
+    const std::vector<synthetic_model::Access> &profile = synthetic_model::light_profile();
+    uint32_t total = 0;
+    for (const synthetic_model::Access &access : profile) {
+        total += access.count;
+    }
+    // Fixed seed, so that every run and both orders see the same accesses.
+    std::mt19937 random(1);
+    std::vector<AttributePath> paths(lookups);
+    for (AttributePath &path : paths) {
+        path.endpoint_id = random() % shape.endpoints;
+        if (random() % 10 == 0) {
+            path.cluster_id = synthetic_model::cluster_id_at(random() % shape.clusters_per_endpoint);
+            path.attribute_id = random() % shape.attributes_per_cluster;
+            continue;
+        }
+        uint32_t pick = random() % total;
+        for (const synthetic_model::Access &access : profile) {
+            if (pick < access.count) {
+                path.cluster_id = access.cluster_id;
+                path.attribute_id = access.attribute_id;
+                break;
+            }
+            pick -= access.count;
+        }
+    }
+    return paths;
+}
+
+/*
+ * Median time per lookup of paths on a model of shape, or a negative value on failure. With indexed, the
+ * attributes are looked up with Interpreter::get_attribute() and index_bytes is set.
+ */
+double time_lookups(const synthetic_model::Shape &shape, const std::vector<AttributePath> &paths, unsigned runs,
+                    bool indexed, double &steps_per_lookup, size_t &index_bytes)
+{
+    synthetic_model::Model model = synthetic_model::generate(shape);
+    esp_matter_stand_in::reset();
+    esp_matter_data_model_interpreter::Interpreter interpreter;
+    if (!interpreter.interpret_data(model.data.data(), model.data.size())) {
+        return -1;
+    }
+
+    std::vector<double> ns_per_lookup;
+    size_t steps = esp_matter_stand_in::stats().lookup_steps;
+    // The first run warms up the caches and is not recorded.
+    for (unsigned run = 0; run <= runs; run++) {
+        size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        if (indexed) {
+            for (const AttributePath &path : paths) {
+                found += interpreter.get_attribute(path.endpoint_id, path.cluster_id, path.attribute_id) != nullptr;
+            }
+        } else {
+            for (const AttributePath &path : paths) {
+                found += esp_matter::attribute::get(path.endpoint_id, path.cluster_id, path.attribute_id) != nullptr;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (found != paths.size()) {
+            return -1;
+        }
+        if (run > 0) {
+            ns_per_lookup.push_back(std::chrono::duration<double, std::nano>(end - start).count() / paths.size());
+        }
+    }
+    steps = esp_matter_stand_in::stats().lookup_steps - steps;
+    steps_per_lookup = static_cast<double>(steps) / (paths.size() * (runs + 1));
+    index_bytes = interpreter.attribute_index_stats().bytes;
+    esp_matter_stand_in::reset();
+    std::sort(ns_per_lookup.begin(), ns_per_lookup.end());
+    return ns_per_lookup[ns_per_lookup.size() / 2];
+}
+
+bool run_lookup_case(Mix mix, unsigned endpoints, unsigned runs, size_t lookups, LookupResult &result)
+{
+    synthetic_model::Shape shape;
+    shape.endpoints = endpoints;
+    shape.mix = mix;
+    std::vector<AttributePath> paths = access_sequence(shape, lookups);
+
+    double index_steps;
+    result.ns_per_lookup = time_lookups(shape, paths, runs, false, result.steps_per_lookup, result.index_bytes);
+    result.ns_per_lookup_indexed = time_lookups(shape, paths, runs, true, index_steps, result.index_bytes);
+    shape.profile = &synthetic_model::light_profile();
+    result.ns_per_lookup_profiled =
+        time_lookups(shape, paths, runs, false, result.steps_per_lookup_profiled, result.index_bytes);
+    if (result.ns_per_lookup < 0 || result.ns_per_lookup_profiled < 0 || result.ns_per_lookup_indexed < 0) {
+        fprintf(stderr, "%s/%u: interpret_data() failed or attributes are missing\n", synthetic_model::mix_name(mix),
+                endpoints);
+        return false;
+    }
+    result.mix = synthetic_model::mix_name(mix);
+    result.endpoints = endpoints;
+    result.lookups = lookups;
+    result.runs = runs;
+    return true;
+}
+
+std::string to_json(const LookupResult &result)
+{
+    char line[384];
+    snprintf(line, sizeof(line),
+             "{\"mix\": \"%s\", \"endpoints\": %u, \"lookups\": %zu, \"runs\": %u, \"ns_per_lookup\": %.1f, "
+             "\"ns_per_lookup_profiled\": %.1f, \"steps_per_lookup\": %.2f, \"steps_per_lookup_profiled\": %.2f, "
+             "\"ns_per_lookup_indexed\": %.1f, \"index_bytes\": %zu}",
+             result.mix.c_str(), result.endpoints, result.lookups, result.runs, result.ns_per_lookup,
+             result.ns_per_lookup_profiled, result.steps_per_lookup, result.steps_per_lookup_profiled,
+             result.ns_per_lookup_indexed, result.index_bytes);
+    return line;
+}
+
+std::string to_json(const Result &result)
+{
+    char line[512];
+    snprintf(line, sizeof(line),
+             "{\"decode\": \"%s\", \"mix\": \"%s\", \"endpoints\": %u, \"bytes\": %zu, \"messages\": %zu, "
+             "\"attributes\": %zu, \"runs\": %u, \"ns_per_message\": %.1f, \"ns_per_message_min\": %.1f, "
+             "\"allocs_per_message\": %.3f, \"peak_heap_bytes\": %lld, \"external_peak_bytes\": %zu}",
+             DECODE_MODE, result.mix.c_str(), result.endpoints, result.bytes, result.messages, result.attributes, result.runs,
+             result.ns_per_message, result.ns_per_message_min, result.allocs_per_message, result.peak_heap_bytes,
+             result.external_peak_bytes);
+    return line;
+}
+
+/* Value of a number or string field in a line written by to_json(). */
+std::string json_field(const std::string &line, const std::string &name)
+{
+    std::string key = "\"" + name + "\": ";
+    size_t pos = line.find(key);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += key.size();
+    if (line[pos] == '"') {
+        return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+    }
+    return line.substr(pos, line.find_first_of(",}", pos) - pos);
+}
+
+bool load_baseline(const std::string &path, std::map<std::string, std::string> &baseline)
+{
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty()) {
+            baseline[json_field(line, "mix") + "/" + json_field(line, "endpoints")] = line;
+        }
+    }
+    return true;
+}
+
+/* Return false when result regressed compared to the baseline line. */
+bool compare(const Result &result, const std::string &baseline, double tolerance)
+{
+    bool ok = true;
+    auto check = [&](const char *name, double value, double tolerance) {
+        double previous = std::strtod(json_field(baseline, name).c_str(), nullptr);
+        if (value > previous * (1 + tolerance / 100) + 1e-9) {
+            fprintf(stderr, "%s/%u: %s regressed from %.3f to %.3f\n", result.mix.c_str(), result.endpoints, name,
+                    previous, value);
+            ok = false;
+        }
+    };
+    check("ns_per_message", result.ns_per_message, tolerance);
+    check("allocs_per_message", result.allocs_per_message, 0);
+    check("peak_heap_bytes", static_cast<double>(result.peak_heap_bytes), 0);
+    return ok;
+}
+
+std::vector<std::string> split(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+void usage()
+{
+    fprintf(stderr,
+            "usage: matter_dm_bench [--endpoints 1,10,50,100,250,500] [--mix scalar,string,mixed,pooled] [--runs <n>]\n"
+            "                       [--psram <bytes>] [--output <file>] [--compare <baseline> [--tolerance <percent>]]\n"
+            "       matter_dm_bench --lookups <n> [--endpoints ...] [--mix ...] [--runs <n>] [--output <file>]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<unsigned> endpoint_counts = {1, 10, 50, 100, 250, 500};
+    std::vector<Mix> mixes = {Mix::Scalar, Mix::String, Mix::Mixed, Mix::Pooled};
+    unsigned runs = 20;
+    std::string output_path;
+    std::string baseline_path;
+    double tolerance = 10;
+    size_t psram = 0;
+    size_t lookups = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (arg == "--endpoints") {
+            endpoint_counts.clear();
+            for (const std::string &item : split(value)) {
+                unsigned count = std::strtoul(item.c_str(), nullptr, 10);
+                if (count == 0 || count > 0xfffe) {
+                    fprintf(stderr, "invalid endpoint count: %s\n", item.c_str());
+                    return 2;
+                }
+                endpoint_counts.push_back(count);
+            }
+        } else if (arg == "--mix") {
+            mixes.clear();
+            for (const std::string &item : split(value)) {
+                Mix mix;
+                if (!synthetic_model::parse_mix(item, mix)) {
+                    fprintf(stderr, "unknown mix: %s\n", item.c_str());
+                    return 2;
+                }
+                mixes.push_back(mix);
+            }
+        } else if (arg == "--runs") {
+            runs = std::max(1ul, std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--lookups") {
+            lookups = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--psram") {
+            psram = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--output") {
+            output_path = value;
+        } else if (arg == "--compare") {
+            baseline_path = value;
+        } else if (arg == "--tolerance") {
+            tolerance = std::strtod(value.c_str(), nullptr);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (lookups && (!baseline_path.empty() || psram)) {
+        fprintf(stderr, "--compare and --psram do not apply to --lookups\n");
+        return 2;
+    }
+#if CONFIG_DM_INTERPRETER_PIPELINED_DECODE
+    if (psram) {
+        // The simulated PSRAM belongs to the calling thread, not to the decode task.
+        fprintf(stderr, "--psram does not apply to the pipelined decode\n");
+        return 2;
+    }
+#endif
+
+    std::map<std::string, std::string> baseline;
+    if (!baseline_path.empty() && !load_baseline(baseline_path, baseline)) {
+        return 2;
+    }
+    FILE *output = stdout;
+    if (!output_path.empty() && !(output = fopen(output_path.c_str(), "w"))) {
+        fprintf(stderr, "%s: cannot open\n", output_path.c_str());
+        return 2;
+    }
+
+    bool ok = true;
+    for (Mix mix : mixes) {
+        for (unsigned endpoints : endpoint_counts) {
+            if (lookups) {
+                LookupResult result;
+                if (!run_lookup_case(mix, endpoints, runs, lookups, result)) {
+                    ok = false;
+                    continue;
+                }
+                fprintf(output, "%s\n", to_json(result).c_str());
+                fflush(output);
+                continue;
+            }
+            Result result;
+            if (!run_case(mix, endpoints, runs, psram, result)) {
+                ok = false;
+                continue;
+            }
+            fprintf(output, "%s\n", to_json(result).c_str());
+            fflush(output);
+            if (!baseline.empty()) {
+                auto it = baseline.find(result.mix + "/" + std::to_string(endpoints));
+                if (it == baseline.end()) {
+                    fprintf(stderr, "%s/%u: not in the baseline\n", result.mix.c_str(), endpoints);
+                } else if (!compare(result, it->second, tolerance)) {
+                    ok = false;
+                }
+            }
+        }
+    }
+    if (output != stdout) {
+        fclose(output);
+    }
+    return ok ? 0 : 1;
+}
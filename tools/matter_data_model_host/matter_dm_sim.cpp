@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Build the nodes of many virtual devices in parallel, one data model binary per device.
+ *
+ *   matter_dm_sim [-j <threads>] [-n <runs>] <bin|dir>...
+ *   matter_dm_sim [-j <threads>] [-n <runs>] --synthetic <devices>
+ *
+ * Each thread of the pool has its own Interpreter and its own node in the esp_matter stand-in, so
+ * devices are built independently. An Interpreter builds one device after the other and keeps its
+ * decode buffer across them. Directories are searched recursively for .bin files, --synthetic
+ * generates devices of 1 to 8 endpoints instead. Every binary is built -n times (1 by default).
+ *
+ * The aggregate throughput is printed as one JSON object; the exit status is 1 if a device failed.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "esp_matter_data_model_interpreter.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "synthetic_model.hpp"
+
+namespace {
+
+struct Device {
+    std::string name;
+    std::vector<uint8_t> data;
+};
+
+bool read_file(const std::filesystem::path &path, std::vector<Device> &devices)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+    devices.push_back({path.string(), std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {})});
+    return true;
+}
+
+bool load_devices(const std::string &arg, std::vector<Device> &devices)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(arg, ec)) {
+        return read_file(arg, devices);
+    }
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(arg, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    for (const std::filesystem::path &path : paths) {
+        if (!read_file(path, devices)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void synthetic_devices(unsigned count, std::vector<Device> &devices)
+{
+    static const synthetic_model::Mix mixes[] = {synthetic_model::Mix::Mixed, synthetic_model::Mix::Pooled,
+                                                 synthetic_model::Mix::Scalar, synthetic_model::Mix::String};
+    for (unsigned i = 0; i < count; i++) {
+        synthetic_model::Shape shape;
+        shape.endpoints = 1 + i % 8;
+        shape.mix = mixes[i % 4];
+        devices.push_back({"synthetic/" + std::to_string(i), synthetic_model::generate(shape).data});
+    }
+}
+
+struct Totals {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> built{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> endpoints{0};
+    std::atomic<size_t> attributes{0};
+};
+
+void worker(const std::vector<Device> &devices, size_t jobs, Totals &totals)
+{
+    esp_matter_data_model_interpreter::Interpreter interpreter;
+    for (size_t job = totals.next++; job < jobs; job = totals.next++) {
+        const Device &device = devices[job % devices.size()];
+        esp_matter_stand_in::reset();
+        if (!interpreter.interpret_data(device.data.data(), device.data.size())) {
+            fprintf(stderr, "%s: interpret_data() failed\n", device.name.c_str());
+            totals.failed++;
+            continue;
+        }
+        const esp_matter_stand_in::Stats &stats = esp_matter_stand_in::stats();
+        totals.built++;
+        totals.bytes += device.data.size();
+        totals.endpoints += stats.endpoints_created;
+        totals.attributes += stats.attributes_created;
+    }
+    esp_matter_stand_in::reset();
+}
+
+void usage()
+{
+    fprintf(stderr,
+            "usage: matter_dm_sim [-j <threads>] [-n <runs>] <bin|dir>...\n"
+            "       matter_dm_sim [-j <threads>] [-n <runs>] --synthetic <devices>\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned runs = 1;
+    std::vector<Device> devices;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "-n" || arg == "--synthetic") && i + 1 < argc) {
+            unsigned value = std::strtoul(argv[++i], nullptr, 10);
+            if (value == 0) {
+                usage();
+                return 2;
+            }
+            if (arg == "-j") {
+                threads = value;
+            } else if (arg == "-n") {
+                runs = value;
+            } else {
+                synthetic_devices(value, devices);
+            }
+        } else if (arg[0] == '-') {
+            usage();
+            return 2;
+        } else if (!load_devices(arg, devices)) {
+            return 2;
+        }
+    }
+    if (devices.empty()) {
+        usage();
+        return 2;
+    }
+
+    size_t jobs = devices.size() * runs;
+    threads = std::min<size_t>(threads, jobs);
+    Totals totals;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) {
+        pool.emplace_back(worker, std::cref(devices), jobs, std::ref(totals));
+    }
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("{\"devices\": %zu, \"runs\": %u, \"threads\": %u, \"built\": %zu, \"failed\": %zu, \"endpoints\": %zu, "
+           "\"attributes\": %zu, \"seconds\": %.3f, \"models_per_sec\": %.1f, \"mb_per_sec\": %.2f}\n",
+           devices.size(), runs, threads, totals.built.load(), totals.failed.load(), totals.endpoints.load(),
+           totals.attributes.load(), seconds, totals.built / seconds, totals.bytes / seconds / 1e6);
+    return totals.failed ? 1 : 0;
+}
@@ -0,0 +1,700 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host tool to inspect data model binaries with the decoding code of the interpreter component.
+ *
+ *   matter_dm_tool dump <bin|dir>...                 one JSON object per message (JSON Lines)
+ *   matter_dm_tool validate [--delta] <bin|dir>...   check the framing and the order of the messages
+ *   matter_dm_tool stats <bin|dir>...                count and size of the messages per type
+ *   matter_dm_tool bench [-n <iterations>] <bin|dir>...
+ *
+ * Directories are searched recursively for .bin files.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "esp_matter_data_model_api_messages.pb-c.h"
+#include "message_framing.hpp"
+#include "message_validation.hpp"
+
+using esp_matter_data_model_interpreter::FramingError;
+using esp_matter_data_model_interpreter::framing_error_str;
+using esp_matter_data_model_interpreter::messages_length;
+using esp_matter_data_model_interpreter::scan_length_prefixed_data;
+using esp_matter_data_model_interpreter::value_case_for_type;
+
+namespace {
+
+struct Input {
+    std::string path;
+    std::vector<uint8_t> data;
+};
+
+struct Message {
+    size_t index;
+    size_t offset;
+    size_t size;  // including the length prefix
+    Datamodel__FunctionCall *call;
+};
+
+bool read_file(const std::string &path, std::vector<uint8_t> &data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char *>(data.data()), data.size()));
+}
+
+bool load_inputs(const std::vector<std::string> &paths, std::vector<Input> &inputs)
+{
+    std::vector<std::string> files;
+    for (const std::string &path : paths) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec)) {
+            size_t first = files.size();
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+                    files.push_back(entry.path().string());
+                }
+            }
+            std::sort(files.begin() + first, files.end());
+        } else {
+            files.push_back(path);
+        }
+    }
+
+    inputs.reserve(files.size());
+    for (const std::string &file : files) {
+        Input input{file, {}};
+        if (!read_file(file, input.data)) {
+            fprintf(stderr, "%s: cannot read file\n", file.c_str());
+            return false;
+        }
+        inputs.push_back(std::move(input));
+    }
+    return true;
+}
+
+/* Size of the messages of data, without the payload section declared by the first message. */
+bool split_messages(const std::vector<uint8_t> &data, size_t &messages_size, std::string &error)
+{
+    if (!messages_length(data.data(), data.size(), messages_size)) {
+        error = "message 0: payload section larger than the binary";
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Decode the messages of data in order and pass them to handler, which returns false to stop.
+ * Returns false and sets error if the binary cannot be decoded.
+ */
+template <typename Handler>
+bool for_each_message(const std::vector<uint8_t> &data, std::string &error, Handler handler)
+{
+    size_t messages_size = 0;
+    if (!split_messages(data, messages_size, error)) {
+        return false;
+    }
+    size_t offset = 0;
+    size_t index = 0;
+    while (offset < messages_size) {
+        size_t prefix_len = 0;
+        size_t message_len = 0;
+        FramingError framing_err = scan_length_prefixed_data(messages_size - offset, &data[offset], prefix_len, message_len);
+        if (framing_err != FramingError::None) {
+            error = "message " + std::to_string(index) + " (offset " + std::to_string(offset) + "): " +
+                    framing_error_str(framing_err);
+            return false;
+        }
+
+        Datamodel__FunctionCall *call = datamodel__function_call__unpack(nullptr, message_len, &data[offset + prefix_len]);
+        if (!call) {
+            error = "message " + std::to_string(index) + " (offset " + std::to_string(offset) + "): cannot unpack";
+            return false;
+        }
+        Message message{index, offset, prefix_len + message_len, call};
+        bool keep_going = handler(message);
+        datamodel__function_call__free_unpacked(call, nullptr);
+        if (!keep_going) {
+            return true;
+        }
+        offset += prefix_len + message_len;
+        index++;
+    }
+    return true;
+}
+
+const char *function_name(const Datamodel__FunctionCall *call)
+{
+    for (unsigned i = 0; i < datamodel__function_call__descriptor.n_fields; i++) {
+        const ProtobufCFieldDescriptor &field = datamodel__function_call__descriptor.fields[i];
+        if ((field.flags & PROTOBUF_C_FIELD_FLAG_ONEOF) && field.id == static_cast<uint32_t>(call->params_case)) {
+            return field.name;
+        }
+    }
+    return "unknown";
+}
+
+//////////
+// dump //
+//////////
+
+void write_json_string(std::string &out, const char *str, size_t len)
+{
+    out += '"';
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+/* Whether an optional field of an unpacked message is present. */
+bool has_field(const ProtobufCMessage *message, const ProtobufCFieldDescriptor &field)
+{
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(message);
+    if (field.flags & PROTOBUF_C_FIELD_FLAG_ONEOF) {
+        return *reinterpret_cast<const uint32_t *>(base + field.quantifier_offset) == field.id;
+    }
+    if (field.type == PROTOBUF_C_TYPE_MESSAGE || field.type == PROTOBUF_C_TYPE_STRING) {
+        return *reinterpret_cast<const void *const *>(base + field.offset) != nullptr;
+    }
+    return *reinterpret_cast<const protobuf_c_boolean *>(base + field.quantifier_offset);
+}
+
+/* Write an unpacked message as JSON, from its descriptor. Only optional fields are used by the format. */
+void write_json_message(std::string &out, const ProtobufCMessage *message)
+{
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(message);
+    bool first = true;
+    out += '{';
+    for (unsigned i = 0; i < message->descriptor->n_fields; i++) {
+        const ProtobufCFieldDescriptor &field = message->descriptor->fields[i];
+        if (!has_field(message, field)) {
+            continue;
+        }
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        write_json_string(out, field.name, strlen(field.name));
+        out += ':';
+
+        const void *value = base + field.offset;
+        char number[32];
+        switch (field.type) {
+        case PROTOBUF_C_TYPE_INT32:
+        case PROTOBUF_C_TYPE_SINT32:
+        case PROTOBUF_C_TYPE_SFIXED32:
+            snprintf(number, sizeof(number), "%" PRId32, *static_cast<const int32_t *>(value));
+            out += number;
+            break;
+        case PROTOBUF_C_TYPE_UINT32:
+        case PROTOBUF_C_TYPE_FIXED32:
+            snprintf(number, sizeof(number), "%" PRIu32, *static_cast<const uint32_t *>(value));
+            out += number;
+            break;
+        case PROTOBUF_C_TYPE_INT64:
+        case PROTOBUF_C_TYPE_SINT64:
+        case PROTOBUF_C_TYPE_SFIXED64:
+            snprintf(number, sizeof(number), "%" PRId64, *static_cast<const int64_t *>(value));
+            out += number;
+            break;
+        case PROTOBUF_C_TYPE_UINT64:
+        case PROTOBUF_C_TYPE_FIXED64:
+            snprintf(number, sizeof(number), "%" PRIu64, *static_cast<const uint64_t *>(value));
+            out += number;
+            break;
+        case PROTOBUF_C_TYPE_FLOAT:
+        case PROTOBUF_C_TYPE_DOUBLE: {
+            double d = field.type == PROTOBUF_C_TYPE_FLOAT ? *static_cast<const float *>(value)
+                                                           : *static_cast<const double *>(value);
+            if (std::isfinite(d)) {
+                snprintf(number, sizeof(number), "%.9g", d);
+                out += number;
+            } else {
+                out += "null";
+            }
+            break;
+        }
+        case PROTOBUF_C_TYPE_BOOL:
+            out += *static_cast<const protobuf_c_boolean *>(value) ? "true" : "false";
+            break;
+        case PROTOBUF_C_TYPE_ENUM: {
+            int enum_value = *static_cast<const int *>(value);
+            const ProtobufCEnumValue *enum_desc = protobuf_c_enum_descriptor_get_value(
+                static_cast<const ProtobufCEnumDescriptor *>(field.descriptor), enum_value);
+            if (enum_desc) {
+                write_json_string(out, enum_desc->name, strlen(enum_desc->name));
+            } else {
+                out += std::to_string(enum_value);
+            }
+            break;
+        }
+        case PROTOBUF_C_TYPE_STRING: {
+            const char *str = *static_cast<const char *const *>(value);
+            write_json_string(out, str, strlen(str));
+            break;
+        }
+        case PROTOBUF_C_TYPE_BYTES: {
+            const ProtobufCBinaryData *bytes = static_cast<const ProtobufCBinaryData *>(value);
+            out += '"';
+            for (size_t j = 0; j < bytes->len; j++) {
+                snprintf(number, sizeof(number), "%02x", bytes->data[j]);
+                out += number;
+            }
+            out += '"';
+            break;
+        }
+        case PROTOBUF_C_TYPE_MESSAGE:
+            write_json_message(out, *static_cast<const ProtobufCMessage *const *>(value));
+            break;
+        }
+    }
+    out += '}';
+}
+
+int cmd_dump(const std::vector<Input> &inputs)
+{
+    int status = 0;
+    std::string line;
+    for (const Input &input : inputs) {
+        std::string error;
+        bool ok = for_each_message(input.data, error, [&](const Message &message) {
+            line.clear();
+            line += "{\"file\":";
+            write_json_string(line, input.path.c_str(), input.path.size());
+            line += ",\"index\":" + std::to_string(message.index) + ",\"offset\":" + std::to_string(message.offset) +
+                    ",\"size\":" + std::to_string(message.size) + ",\"message\":";
+            write_json_message(line, &message.call->base);
+            line += "}\n";
+            fwrite(line.data(), 1, line.size(), stdout);
+            return true;
+        });
+        if (!ok) {
+            fprintf(stderr, "%s: %s\n", input.path.c_str(), error.c_str());
+            status = 1;
+        }
+    }
+    return status;
+}
+
+//////////////
+// validate //
+//////////////
+
+/* Checks the order and references of the messages the way the interpreter applies them. */
+class Validator {
+public:
+    Validator(bool delta, size_t payload_section_size) : delta_(delta), payload_section_size_(payload_section_size) {}
+
+    std::vector<std::string> errors;
+
+    void check(const Message &message)
+    {
+        index_ = message.index;
+        const Datamodel__FunctionCall *call = message.call;
+        switch (call->params_case) {
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DEFINE_VALUE_PARAMS:
+            if (call->define_value_params->index != pool_.size()) {
+                error("define_value: index %" PRIu32 ", expected %zu", call->define_value_params->index, pool_.size());
+            }
+            pool_.push_back(call->define_value_params->val ? call->define_value_params->val->value_case
+                                                           : DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_DECLARE_PAYLOADS_PARAMS:
+            if (delta_) {
+                error("declare_payloads: not allowed in a delta");
+            } else if (index_ != 0) {
+                error("declare_payloads: only allowed as the first message");
+            }
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ENDPOINT_PARAMS: {
+            uint32_t endpoint_id = call->create_endpoint_params->endpoint_id;
+            if (!endpoints_.insert(endpoint_id).second) {
+                error("create_endpoint: endpoint %" PRIu32 " created twice", endpoint_id);
+            }
+            endpoint_ = endpoint_id;
+            has_endpoint_ = true;
+            has_cluster_ = false;
+            clusters_.clear();
+            break;
+        }
+        case DATAMODEL__FUNCTION_CALL__PARAMS_ENDPOINT_ADD_DEVICE_TYPE_PARAMS:
+            check_endpoint("endpoint_add_device_type", call->endpoint_add_device_type_params->endpoint_id);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_CLUSTER_PARAMS: {
+            const Datamodel__CreateClusterParams *params = call->create_cluster_params;
+            check_endpoint("create_cluster", params->endpoint_id);
+            if (!clusters_.insert(params->cluster_id).second) {
+                error("create_cluster: cluster 0x%04" PRIx32 " created twice on endpoint %" PRIu32, params->cluster_id,
+                      params->endpoint_id);
+            }
+            cluster_ = params->cluster_id;
+            has_cluster_ = true;
+            attributes_.clear();
+            commands_.clear();
+            events_.clear();
+            break;
+        }
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_ATTRIBUTE_PARAMS:
+            check_attribute(call->create_attribute_params);
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_COMMAND_PARAMS: {
+            const Datamodel__CreateCommandParams *params = call->create_command_params;
+            check_cluster("create_command", params->endpoint_id, params->cluster_id);
+            if (!commands_.insert({params->command_id, params->flags}).second) {
+                error("create_command: command 0x%04" PRIx32 " created twice", params->command_id);
+            }
+            break;
+        }
+        case DATAMODEL__FUNCTION_CALL__PARAMS_CREATE_EVENT_PARAMS: {
+            const Datamodel__CreateEventParams *params = call->create_event_params;
+            check_cluster("create_event", params->endpoint_id, params->cluster_id);
+            if (!events_.insert(params->event_id).second) {
+                error("create_event: event 0x%04" PRIx32 " created twice", params->event_id);
+            }
+            break;
+        }
+        case DATAMODEL__FUNCTION_CALL__PARAMS_REMOVE_ENDPOINT_PARAMS:
+            if (!delta_) {
+                error("remove_endpoint: only allowed in a delta (--delta)");
+            }
+            endpoints_.erase(call->remove_endpoint_params->endpoint_id);
+            if (has_endpoint_ && endpoint_ == call->remove_endpoint_params->endpoint_id) {
+                has_endpoint_ = false;
+                has_cluster_ = false;
+            }
+            break;
+        case DATAMODEL__FUNCTION_CALL__PARAMS_UPDATE_ATTRIBUTE_PARAMS: {
+            const Datamodel__UpdateAttributeParams *params = call->update_attribute_params;
+            if (!delta_) {
+                error("update_attribute: only allowed in a delta (--delta)");
+            }
+            if (!params->val) {
+                error("update_attribute: attribute 0x%04" PRIx32 " has no value type", params->attribute_id);
+            } else if (params->val->val) {
+                check_value_case("update_attribute", params->attribute_id, params->val->type, params->val->val->value_case);
+            }
+            break;
+        }
+        default:
+            error("unknown message");
+            break;
+        }
+    }
+
+private:
+    bool delta_;
+    size_t payload_section_size_;
+    size_t index_ = 0;
+    std::vector<Datamodel__EspMatterVal__ValueCase> pool_;
+    std::set<uint32_t> endpoints_;
+    std::set<uint32_t> clusters_;
+    std::set<uint32_t> attributes_;
+    std::set<std::pair<uint32_t, uint32_t>> commands_;
+    std::set<uint32_t> events_;
+    bool has_endpoint_ = false;
+    bool has_cluster_ = false;
+    uint32_t endpoint_ = 0;
+    uint32_t cluster_ = 0;
+
+    template <typename... Args>
+    void error(const char *format, Args... args)
+    {
+        char text[160];
+        snprintf(text, sizeof(text), format, args...);
+        errors.push_back("message " + std::to_string(index_) + ": " + text);
+    }
+
+    void check_endpoint(const char *what, uint32_t endpoint_id)
+    {
+        if (!has_endpoint_) {
+            error("%s: no endpoint created before", what);
+        } else if (endpoint_id != endpoint_) {
+            error("%s: endpoint %" PRIu32 " is not the current endpoint %" PRIu32, what, endpoint_id, endpoint_);
+        }
+    }
+
+    void check_cluster(const char *what, uint32_t endpoint_id, uint32_t cluster_id)
+    {
+        check_endpoint(what, endpoint_id);
+        if (!has_cluster_) {
+            error("%s: no cluster created before", what);
+        } else if (cluster_id != cluster_) {
+            error("%s: cluster 0x%04" PRIx32 " is not the current cluster 0x%04" PRIx32, what, cluster_id, cluster_);
+        }
+    }
+
+    bool check_ref(const char *what, uint32_t attribute_id, uint32_t ref, Datamodel__EspMatterVal__ValueCase &value_case)
+    {
+        if (ref >= pool_.size()) {
+            error("%s: attribute 0x%04" PRIx32 " references value %" PRIu32 ", only %zu defined", what, attribute_id, ref,
+                  pool_.size());
+            return false;
+        }
+        value_case = pool_[ref];
+        return true;
+    }
+
+    void check_value_case(const char *what, uint32_t attribute_id, Datamodel__EspMatterValType type,
+                          Datamodel__EspMatterVal__ValueCase value_case)
+    {
+        Datamodel__EspMatterVal__ValueCase expected = value_case_for_type(type);
+        if (expected == DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET) {
+            error("%s: attribute 0x%04" PRIx32 " has unknown type %d", what, attribute_id, type);
+        } else if (value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET && value_case != expected) {
+            error("%s: attribute 0x%04" PRIx32 " value field %d does not match type %d", what, attribute_id, value_case, type);
+        }
+    }
+
+    void check_payload(const Datamodel__CreateAttributeParams *params, Datamodel__EspMatterVal__ValueCase value_case)
+    {
+        Datamodel__EspMatterVal__ValueCase payload_case = value_case_for_type(params->val->type);
+        if (payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_CHAR_STRING &&
+            payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_OCTET_STRING && payload_case != DATAMODEL__ESP_MATTER_VAL__VALUE_A) {
+            error("create_attribute: attribute 0x%04" PRIx32 " of type %d cannot have an out-of-line payload",
+                  params->attribute_id, params->val->type);
+        } else if ((value_case != DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET &&
+                    value_case != DATAMODEL__ESP_MATTER_VAL__VALUE_A) || params->has_val_ref ||
+                   (params->val->val && params->val->val->value_case == DATAMODEL__ESP_MATTER_VAL__VALUE_A &&
+                    params->val->val->a->has_elements)) {
+            error("create_attribute: attribute 0x%04" PRIx32 " has both a value and an out-of-line payload",
+                  params->attribute_id);
+        }
+        if (!params->has_payload_offset || !params->has_payload_crc32) {
+            error("create_attribute: attribute 0x%04" PRIx32 " has an incomplete payload reference", params->attribute_id);
+        } else if (params->payload_size == 0 || params->payload_size > UINT16_MAX ||
+                   params->payload_offset > payload_section_size_ ||
+                   params->payload_size > payload_section_size_ - params->payload_offset) {
+            error("create_attribute: attribute 0x%04" PRIx32 " payload %" PRIu32 "+%" PRIu32
+                  " is outside of the %zu byte payload section",
+                  params->attribute_id, params->payload_offset, params->payload_size, payload_section_size_);
+        }
+    }
+
+    void check_attribute(const Datamodel__CreateAttributeParams *params)
+    {
+        check_cluster("create_attribute", params->endpoint_id, params->cluster_id);
+        if (!attributes_.insert(params->attribute_id).second) {
+            error("create_attribute: attribute 0x%04" PRIx32 " created twice", params->attribute_id);
+        }
+        if (!params->val) {
+            error("create_attribute: attribute 0x%04" PRIx32 " has no value type", params->attribute_id);
+            return;
+        }
+
+        Datamodel__EspMatterVal__ValueCase value_case =
+            params->val->val ? params->val->val->value_case : DATAMODEL__ESP_MATTER_VAL__VALUE__NOT_SET;
+        if (params->has_val_ref && !check_ref("create_attribute", params->attribute_id, params->val_ref, value_case)) {
+            return;
+        }
+        check_value_case("create_attribute", params->attribute_id, params->val->type, value_case);
+        if (params->has_payload_size) {
+            check_payload(params, value_case);
+        }
+
+        Datamodel__EspMatterVal__ValueCase bound_case;
+        if (params->has_bounds_min_ref) {
+            check_ref("create_attribute", params->attribute_id, params->bounds_min_ref, bound_case);
+        }
+        if (params->has_bounds_max_ref) {
+            check_ref("create_attribute", params->attribute_id, params->bounds_max_ref, bound_case);
+        }
+    }
+};
+
+int cmd_validate(const std::vector<Input> &inputs, bool delta)
+{
+    size_t invalid = 0;
+    for (const Input &input : inputs) {
+        std::string error;
+        size_t messages_size = input.data.size();
+        split_messages(input.data, messages_size, error);
+        Validator validator(delta, input.data.size() - messages_size);
+        if (!for_each_message(input.data, error, [&](const Message &message) {
+                validator.check(message);
+                return true;
+            })) {
+            validator.errors.push_back(error);
+        }
+        for (const std::string &text : validator.errors) {
+            printf("%s: %s\n", input.path.c_str(), text.c_str());
+        }
+        if (!validator.errors.empty()) {
+            invalid++;
+        }
+    }
+    printf("%zu files checked, %zu invalid\n", inputs.size(), invalid);
+    return invalid ? 1 : 0;
+}
+
+///////////
+// stats //
+///////////
+
+int cmd_stats(const std::vector<Input> &inputs)
+{
+    struct Totals {
+        size_t count = 0;
+        size_t bytes = 0;
+        size_t max_bytes = 0;
+    };
+    std::map<std::string, Totals> totals;
+    size_t total_bytes = 0;
+    size_t total_count = 0;
+    int status = 0;
+
+    for (const Input &input : inputs) {
+        std::string error;
+        if (!for_each_message(input.data, error, [&](const Message &message) {
+                Totals &entry = totals[function_name(message.call)];
+                entry.count++;
+                entry.bytes += message.size;
+                entry.max_bytes = std::max(entry.max_bytes, message.size);
+                total_count++;
+                return true;
+            })) {
+            fprintf(stderr, "%s: %s\n", input.path.c_str(), error.c_str());
+            status = 1;
+        }
+        total_bytes += input.data.size();
+    }
+
+    printf("%-32s %10s %12s %10s %10s\n", "message", "count", "bytes", "avg", "max");
+    for (const auto &[name, entry] : totals) {
+        printf("%-32s %10zu %12zu %10.1f %10zu\n", name.c_str(), entry.count, entry.bytes,
+               static_cast<double>(entry.bytes) / entry.count, entry.max_bytes);
+    }
+    printf("%-32s %10zu %12zu\n", "total", total_count, total_bytes);
+    printf("%zu files\n", inputs.size());
+    return status;
+}
+
+///////////
+// bench //
+///////////
+
+int cmd_bench(const std::vector<Input> &inputs, size_t iterations)
+{
+    size_t total_bytes = 0;
+    size_t messages = 0;
+    for (const Input &input : inputs) {
+        std::string error;
+        // The first pass checks the inputs and warms up the caches and the allocator.
+        if (!for_each_message(input.data, error, [&](const Message &) {
+                messages++;
+                return true;
+            })) {
+            fprintf(stderr, "%s: %s\n", input.path.c_str(), error.c_str());
+            return 1;
+        }
+        total_bytes += input.data.size();
+    }
+
+    std::vector<double> times_us;
+    times_us.reserve(iterations);
+    for (size_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        for (const Input &input : inputs) {
+            std::string error;
+            for_each_message(input.data, error, [](const Message &) { return true; });
+        }
+        times_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::sort(times_us.begin(), times_us.end());
+    double mean = 0;
+    for (double t : times_us) {
+        mean += t;
+    }
+    mean /= times_us.size();
+    double median = times_us[times_us.size() / 2];
+    printf("%zu files, %zu bytes, %zu messages, %zu iterations\n", inputs.size(), total_bytes, messages, iterations);
+    printf("decode time per iteration: min %.1f us, median %.1f us, mean %.1f us\n", times_us.front(), median, mean);
+    printf("throughput (median): %.1f MB/s, %.0f messages/s\n", total_bytes / median, messages / (median / 1e6));
+    return 0;
+}
+
+void usage()
+{
+    fprintf(stderr,
+            "usage: matter_dm_tool dump <bin|dir>...\n"
+            "       matter_dm_tool validate [--delta] <bin|dir>...\n"
+            "       matter_dm_tool stats <bin|dir>...\n"
+            "       matter_dm_tool bench [-n <iterations>] <bin|dir>...\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    std::string command = argv[1];
+    bool delta = false;
+    size_t iterations = 1000;
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--delta") {
+            delta = true;
+        } else if (arg == "-n" && i + 1 < argc) {
+            iterations = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty() || iterations == 0) {
+        usage();
+        return 2;
+    }
+
+    std::vector<Input> inputs;
+    if (!load_inputs(paths, inputs)) {
+        return 2;
+    }
+
+    if (command == "dump") {
+        return cmd_dump(inputs);
+    } else if (command == "validate") {
+        return cmd_validate(inputs, delta);
+    } else if (command == "stats") {
+        return cmd_stats(inputs);
+    } else if (command == "bench") {
+        return cmd_bench(inputs, iterations);
+    }
+    usage();
+    return 2;
+}
@@ -0,0 +1,411 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef SYNTHETIC_MODEL_HPP
+#define SYNTHETIC_MODEL_HPP
+
+/*
+ * Synthetic data model binaries for the host benchmarks, encoded directly in the binary format so
+ * that any model size can be generated without the serializer and the connectedhomeip SDK.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace synthetic_model {
+
+/* Minimal protobuf encoder for the messages of esp_matter_data_model_api_messages.proto. */
+class Writer {
+public:
+    std::vector<uint8_t> buf;
+
+    void varint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            buf.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buf.push_back(static_cast<uint8_t>(value));
+    }
+
+    void uint_field(uint32_t field, uint64_t value)
+    {
+        varint(field << 3);
+        varint(value);
+    }
+
+    /* int32 and int64 fields: negative values are sign-extended to 10 bytes. */
+    void int_field(uint32_t field, int64_t value) { uint_field(field, static_cast<uint64_t>(value)); }
+
+    void float_field(uint32_t field, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        varint(field << 3 | 5);
+        for (int i = 0; i < 4; i++) {
+            buf.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    void bytes_field(uint32_t field, const void *data, size_t size)
+    {
+        varint(field << 3 | 2);
+        varint(size);
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        buf.insert(buf.end(), bytes, bytes + size);
+    }
+
+    void message_field(uint32_t field, const Writer &message) { bytes_field(field, message.buf.data(), message.buf.size()); }
+
+    /* Append message as a length-prefixed FunctionCall. */
+    void frame(const Writer &message)
+    {
+        varint(message.buf.size());
+        buf.insert(buf.end(), message.buf.begin(), message.buf.end());
+    }
+};
+
+/* Mix of attribute value types in the generated clusters. */
+enum class Mix {
+    Scalar,  // integers, enums, bitmaps and booleans, some with bounds
+    String,  // char and octet strings
+    Mixed,   // mostly scalars, some strings, arrays and nullable values, like real device types
+    Pooled,  // Mixed, with the strings and bounds in the value pool
+};
+
+inline const char *mix_name(Mix mix)
+{
+    switch (mix) {
+    case Mix::Scalar:
+        return "scalar";
+    case Mix::String:
+        return "string";
+    case Mix::Mixed:
+        return "mixed";
+    case Mix::Pooled:
+        return "pooled";
+    }
+    return "unknown";
+}
+
+inline bool parse_mix(const std::string &name, Mix &mix)
+{
+    for (Mix candidate : {Mix::Scalar, Mix::String, Mix::Mixed, Mix::Pooled}) {
+        if (name == mix_name(candidate)) {
+            mix = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Accesses to an attribute of every endpoint, like an entry of the serializer's access profile. */
+struct Access {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint32_t count;
+};
+
+/* Accesses of a light under a typical load: mostly OnOff and CurrentLevel, then the color temperature. */
+inline const std::vector<Access> &light_profile()
+{
+    static const std::vector<Access> profile = {
+        {0x0006, 0x0000, 500}, {0x0008, 0x0000, 300}, {0x0300, 0x0007, 120}, {0x0008, 0x0001, 40},
+        {0x0300, 0x0002, 40},
+    };
+    return profile;
+}
+
+struct Shape {
+    uint16_t endpoints = 1;
+    uint16_t clusters_per_endpoint = 6;
+    uint16_t attributes_per_cluster = 8;
+    uint16_t commands_per_cluster = 3;
+    uint16_t events_per_cluster = 1;
+    Mix mix = Mix::Mixed;
+    // With a profile, clusters and attributes are created by descending access count, like the
+    // serializer does with --access-profile, instead of in cluster_id_at() and attribute id order.
+    // The values do not change.
+    const std::vector<Access> *profile = nullptr;
+};
+
+struct Model {
+    std::vector<uint8_t> data;
+    size_t messages = 0;
+    size_t attributes = 0;
+};
+
+/* Id of the cluster at index c of an endpoint. */
+inline uint32_t cluster_id_at(uint16_t c)
+{
+    static const uint32_t CLUSTER_IDS[] = {0x001d, 0x0003, 0x0004, 0x0006, 0x0008, 0x0300, 0x0028, 0x0402};
+    return c < 8 ? CLUSTER_IDS[c] : 0xfc00 + c;
+}
+
+namespace detail {
+
+// Field numbers of the binary format.
+enum Function : uint32_t {
+    CREATE_ATTRIBUTE = 1,
+    CREATE_COMMAND = 2,
+    CREATE_EVENT = 3,
+    CREATE_CLUSTER = 4,
+    CREATE_ENDPOINT = 5,
+    ENDPOINT_ADD_DEVICE_TYPE = 6,
+    DEFINE_VALUE = 9,
+};
+
+enum ValType : uint32_t {
+    BOOLEAN = 1,
+    ARRAY = 4,
+    CHAR_STRING = 5,
+    OCTET_STRING = 6,
+    INT16 = 9,
+    UINT16 = 10,
+    UINT32 = 12,
+    ENUM8 = 15,
+    BITMAP8 = 16,
+    UINT8 = 8,
+};
+
+constexpr uint32_t ATTRIBUTE_FLAG_WRITABLE = 0x01;
+constexpr uint32_t ATTRIBUTE_FLAG_NONVOLATILE = 0x02;
+constexpr uint32_t ATTRIBUTE_FLAG_NULLABLE = 0x40;
+
+const char *const STRINGS[] = {"Espressif", "ESP32-C6 Light", "1.0.3", "https://www.espressif.com"};
+const uint8_t OCTETS[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+
+inline void frame_call(Model &model, uint32_t function, uint32_t params_field, const Writer &params)
+{
+    Writer call;
+    call.uint_field(1, function);
+    call.message_field(params_field, params);
+    Writer framed;
+    model.data.reserve(model.data.size() + call.buf.size() + 5);
+    framed.frame(call);
+    model.data.insert(model.data.end(), framed.buf.begin(), framed.buf.end());
+    model.messages++;
+}
+
+inline Writer int_val(uint32_t field, int64_t value)
+{
+    Writer val;
+    val.int_field(field, value);
+    return val;
+}
+
+/* The value pool of the Pooled mix: the strings, then the bounds 0 and 254. */
+inline void define_pool(Model &model)
+{
+    uint32_t index = 0;
+    for (const char *str : STRINGS) {
+        Writer val;
+        val.bytes_field(13, str, strlen(str));
+        Writer params;
+        params.uint_field(1, index++);
+        params.message_field(2, val);
+        frame_call(model, DEFINE_VALUE, 10, params);
+    }
+    for (uint32_t bound : {0u, 254u}) {
+        Writer params;
+        params.uint_field(1, index++);
+        params.message_field(2, int_val(5, bound));
+        frame_call(model, DEFINE_VALUE, 10, params);
+    }
+}
+
+constexpr uint32_t POOL_STRINGS = 0;
+constexpr uint32_t POOL_BOUND_MIN = 4;
+constexpr uint32_t POOL_BOUND_MAX = 5;
+
+inline void add_attribute(Model &model, const Shape &shape, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                          unsigned kind)
+{
+    Writer params;
+    params.uint_field(1, endpoint_id);
+    params.uint_field(2, cluster_id);
+    params.uint_field(3, attribute_id);
+
+    Writer attr_val;
+    Writer val;
+    uint32_t flags = 0;
+    const char *str = STRINGS[(attribute_id + cluster_id) % 4];
+    bool pooled = shape.mix == Mix::Pooled;
+    switch (kind) {
+    case 0:  // uint8 with bounds, like a level
+        attr_val.uint_field(1, UINT8);
+        val.uint_field(5, 1 + attribute_id);
+        flags = ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NONVOLATILE;
+        if (pooled) {
+            params.uint_field(10, POOL_BOUND_MIN);
+            params.uint_field(11, POOL_BOUND_MAX);
+        } else {
+            params.message_field(7, int_val(5, 0));
+            params.message_field(8, int_val(5, 254));
+        }
+        break;
+    case 1:
+        attr_val.uint_field(1, UINT16);
+        val.uint_field(7, 300 + attribute_id);
+        break;
+    case 2:
+        attr_val.uint_field(1, UINT32);
+        val.uint_field(9, 0x10000 + attribute_id);
+        break;
+    case 3:
+        attr_val.uint_field(1, BOOLEAN);
+        val.uint_field(1, 1);
+        flags = ATTRIBUTE_FLAG_WRITABLE;
+        break;
+    case 4:
+        attr_val.uint_field(1, ENUM8);
+        val.uint_field(5, 2);
+        break;
+    case 5:
+        attr_val.uint_field(1, BITMAP8);
+        val.uint_field(5, 0x81);
+        break;
+    case 6:  // nullable int16, like a temperature
+        attr_val.uint_field(1, INT16);
+        val.int_field(6, -40);
+        flags = ATTRIBUTE_FLAG_NULLABLE;
+        break;
+    case 7:
+        attr_val.uint_field(1, CHAR_STRING);
+        params.uint_field(6, 32);
+        if (pooled) {
+            params.uint_field(9, POOL_STRINGS + (attribute_id + cluster_id) % 4);
+        } else {
+            val.bytes_field(13, str, strlen(str));
+        }
+        break;
+    case 8:
+        attr_val.uint_field(1, OCTET_STRING);
+        params.uint_field(6, 16);
+        val.bytes_field(14, OCTETS, sizeof(OCTETS));
+        break;
+    default: {  // an array, like a list attribute
+        attr_val.uint_field(1, ARRAY);
+        Writer array;
+        array.bytes_field(1, OCTETS, 4);
+        array.uint_field(2, 4);
+        array.uint_field(3, 2);
+        val.message_field(12, array);
+        break;
+    }
+    }
+    if (!val.buf.empty()) {
+        attr_val.message_field(2, val);
+    }
+    params.uint_field(4, flags);
+    params.message_field(5, attr_val);
+    frame_call(model, CREATE_ATTRIBUTE, 2, params);
+    model.attributes++;
+}
+
+/* Attribute kinds of add_attribute() cycled through by each mix. */
+inline unsigned attribute_kind(Mix mix, uint32_t index)
+{
+    static const unsigned scalar[] = {0, 1, 2, 3, 4, 5};
+    static const unsigned string[] = {7, 8};
+    static const unsigned mixed[] = {0, 1, 2, 3, 4, 5, 6, 7, 1, 9};
+    switch (mix) {
+    case Mix::Scalar:
+        return scalar[index % 6];
+    case Mix::String:
+        return string[index % 2];
+    default:
+        return mixed[index % 10];
+    }
+}
+
+/* Indexes 0..count-1 ordered by descending weight, ties in ascending order. */
+template <typename Weight>
+inline std::vector<uint16_t> order_by(uint16_t count, Weight weight)
+{
+    std::vector<uint16_t> order(count);
+    for (uint16_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b) { return weight(a) > weight(b); });
+    return order;
+}
+
+inline uint64_t access_count(const Shape &shape, uint32_t cluster_id, uint32_t attribute_id)
+{
+    uint64_t count = 0;
+    for (const Access &access : *shape.profile) {
+        if (access.cluster_id == cluster_id && (access.attribute_id == attribute_id || attribute_id == UINT32_MAX)) {
+            count += access.count;
+        }
+    }
+    return count;
+}
+
+} // namespace detail
+
+/* Generate a model of identical endpoints with the given shape. */
+inline Model generate(const Shape &shape)
+{
+    using namespace detail;
+    Model model;
+    if (shape.mix == Mix::Pooled) {
+        define_pool(model);
+    }
+
+    for (uint16_t endpoint_id = 0; endpoint_id < shape.endpoints; endpoint_id++) {
+        Writer endpoint;
+        endpoint.uint_field(1, endpoint_id);
+        endpoint.uint_field(2, 0);
+        frame_call(model, CREATE_ENDPOINT, 6, endpoint);
+
+        Writer device_type;
+        device_type.uint_field(1, endpoint_id);
+        device_type.uint_field(2, endpoint_id == 0 ? 0x0016 : 0x010d);
+        device_type.uint_field(3, 3);
+        frame_call(model, ENDPOINT_ADD_DEVICE_TYPE, 7, device_type);
+
+        std::vector<uint16_t> clusters = order_by(shape.clusters_per_endpoint, [&](uint16_t c) {
+            return shape.profile ? access_count(shape, cluster_id_at(c), UINT32_MAX) : 0;
+        });
+        for (uint16_t c : clusters) {
+            uint32_t cluster_id = cluster_id_at(c);
+            Writer cluster;
+            cluster.uint_field(1, endpoint_id);
+            cluster.uint_field(2, cluster_id);
+            cluster.uint_field(3, 0x01);
+            frame_call(model, CREATE_CLUSTER, 5, cluster);
+
+            std::vector<uint16_t> attributes = order_by(shape.attributes_per_cluster, [&](uint16_t a) {
+                return shape.profile ? access_count(shape, cluster_id, a) : 0;
+            });
+            for (uint16_t a : attributes) {
+                add_attribute(model, shape, endpoint_id, cluster_id, a, attribute_kind(shape.mix, a + c));
+            }
+            for (uint16_t i = 0; i < shape.commands_per_cluster; i++) {
+                Writer command;
+                command.uint_field(1, endpoint_id);
+                command.uint_field(2, cluster_id);
+                command.uint_field(3, i);
+                command.uint_field(4, 0x01);
+                frame_call(model, CREATE_COMMAND, 3, command);
+            }
+            for (uint16_t i = 0; i < shape.events_per_cluster; i++) {
+                Writer event;
+                event.uint_field(1, endpoint_id);
+                event.uint_field(2, cluster_id);
+                event.uint_field(3, i);
+                frame_call(model, CREATE_EVENT, 4, event);
+            }
+        }
+    }
+    return model;
+}
+
+} // namespace synthetic_model
+
+#endif // SYNTHETIC_MODEL_HPP
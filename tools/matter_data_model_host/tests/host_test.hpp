@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef HOST_TEST_HPP
+#define HOST_TEST_HPP
+
+/*
+ * Checks of the host tests, run by ctest. A failed check prints its condition and the test goes on,
+ * host_test::result() is the exit status of the test.
+ */
+
+#include <cstdio>
+
+namespace host_test {
+
+inline int failures = 0;
+
+inline void check(bool ok, const char *condition, const char *file, int line)
+{
+    if (!ok) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+        failures++;
+    }
+}
+
+inline int result()
+{
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace host_test
+
+#define CHECK(condition) host_test::check((condition), #condition, __FILE__, __LINE__)
+
+#endif // HOST_TEST_HPP
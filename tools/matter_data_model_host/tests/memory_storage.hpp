@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef MEMORY_STORAGE_HPP
+#define MEMORY_STORAGE_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "data_model_storage.hpp"
+#include "nvs_flash.h"
+
+namespace host_test {
+
+/* NVS as a map from key to blob, for the DataModelManager of the host tests. */
+class MemoryStorage : public IDataModelStorage {
+public:
+    std::map<std::string, std::vector<uint8_t>> blobs;
+
+    esp_err_t get_data_model(std::string_view key, allocator_policy::Buffer &data) override
+    {
+        data.clear();
+        auto blob = blobs.find(std::string(key));
+        if (blob == blobs.end()) {
+            return ESP_ERR_NVS_NOT_FOUND;
+        }
+        return data.assign(blob->second.data(), blob->second.size());
+    }
+
+    esp_err_t set_data_model(std::string_view key, const allocator_policy::Buffer &data) override
+    {
+        blobs[std::string(key)].assign(data.data(), data.data() + data.size());
+        return ESP_OK;
+    }
+
+    esp_err_t remove_key(std::string_view key) override
+    {
+        return blobs.erase(std::string(key)) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    bool has(const char *key) const { return blobs.count(key) != 0; }
+};
+
+} // namespace host_test
+
+#endif // MEMORY_STORAGE_HPP
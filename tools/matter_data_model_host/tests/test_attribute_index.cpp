@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The attribute index of the interpreter and the table of an AttributeDispatcher, which share one
+ * open-addressing table, follow the node through apply_delta(), instantiate(), forget_endpoint() and a
+ * failed interpret_data().
+ */
+
+#include <vector>
+
+#include "attribute_dispatcher.hpp"
+#include "esp_matter_data_model_interpreter.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "host_test.hpp"
+#include "synthetic_model.hpp"
+
+using esp_matter_data_model_interpreter::AttributeDispatcher;
+using esp_matter_data_model_interpreter::Interpreter;
+
+static const uint32_t ON_OFF_CLUSTER_ID = 0x0006;
+
+static esp_err_t handle(void *, uint16_t, uint32_t, uint32_t, esp_matter_attr_val_t *)
+{
+    return ESP_OK;
+}
+
+/* The index returns the attribute of the node, or nullptr for all of them when present is false. */
+static bool index_matches_node(const Interpreter &interpreter, const synthetic_model::Shape &shape, uint16_t endpoint_id,
+                               bool present)
+{
+    for (uint16_t c = 0; c < shape.clusters_per_endpoint; c++) {
+        uint32_t cluster_id = synthetic_model::cluster_id_at(c);
+        for (uint32_t attribute_id = 0; attribute_id < shape.attributes_per_cluster; attribute_id++) {
+            esp_matter::attribute_t *indexed = interpreter.get_attribute(endpoint_id, cluster_id, attribute_id);
+            if (indexed != esp_matter::attribute::get(endpoint_id, cluster_id, attribute_id) ||
+                (indexed != nullptr) != present) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static std::vector<uint8_t> remove_endpoint_delta(uint16_t endpoint_id)
+{
+    synthetic_model::Model delta;
+    synthetic_model::Writer params;
+    params.uint_field(1, endpoint_id);
+    synthetic_model::detail::frame_call(delta, 7, 8, params);  // REMOVE_ENDPOINT
+    return delta.data;
+}
+
+int main()
+{
+    synthetic_model::Shape shape;
+    shape.endpoints = 5;
+    synthetic_model::Model model = synthetic_model::generate(shape);
+    size_t per_endpoint = model.attributes / shape.endpoints;
+
+    AttributeDispatcher dispatcher;
+    CHECK(dispatcher.register_cluster_handler(ON_OFF_CLUSTER_ID, handle) == ESP_OK);
+    Interpreter interpreter;
+    interpreter.set_attribute_created_callback(AttributeDispatcher::on_attribute_created, &dispatcher);
+    interpreter.set_endpoint_removed_callback(AttributeDispatcher::on_endpoint_removed, &dispatcher);
+
+    esp_matter_stand_in::reset();
+    CHECK(interpreter.interpret_data(model.data.data(), model.data.size()) != nullptr);
+    CHECK(interpreter.attribute_index_stats().attributes == model.attributes);
+    for (uint16_t endpoint_id = 0; endpoint_id < shape.endpoints; endpoint_id++) {
+        CHECK(index_matches_node(interpreter, shape, endpoint_id, true));
+    }
+    CHECK(interpreter.get_attribute(0, ON_OFF_CLUSTER_ID, 99) == nullptr);
+    CHECK(interpreter.get_attribute(9, ON_OFF_CLUSTER_ID, 0) == nullptr);
+    CHECK(dispatcher.size() == shape.endpoints * shape.attributes_per_cluster);
+
+    // A delta removing an endpoint drops its attributes from the index and the dispatcher.
+    std::vector<uint8_t> delta = remove_endpoint_delta(2);
+    CHECK(interpreter.apply_delta(delta.data(), delta.size()) == ESP_OK);
+    CHECK(interpreter.attribute_index_stats().attributes == model.attributes - per_endpoint);
+    CHECK(index_matches_node(interpreter, shape, 2, false));
+    CHECK(index_matches_node(interpreter, shape, 3, true));
+    CHECK(!dispatcher.has_handler(2, ON_OFF_CLUSTER_ID, 0));
+    CHECK(dispatcher.has_handler(3, ON_OFF_CLUSTER_ID, 0));
+    CHECK(dispatcher.size() == (shape.endpoints - 1u) * shape.attributes_per_cluster);
+
+    // Instances of a shape are indexed.
+    synthetic_model::Shape one = shape;
+    one.endpoints = 1;
+    synthetic_model::Model shape_model = synthetic_model::generate(one);
+    uint16_t shape_id = 0;
+    std::vector<uint16_t> endpoint_ids;
+    CHECK(interpreter.register_shape(shape_model.data.data(), shape_model.data.size(), shape_id) == ESP_OK);
+    CHECK(interpreter.instantiate(shape_id, 3, &endpoint_ids) == ESP_OK);
+    CHECK(endpoint_ids.size() == 3);
+    CHECK(interpreter.attribute_index_stats().attributes == model.attributes + 2 * per_endpoint);
+    for (uint16_t endpoint_id : endpoint_ids) {
+        CHECK(index_matches_node(interpreter, shape, endpoint_id, true));
+        CHECK(dispatcher.has_handler(endpoint_id, ON_OFF_CLUSTER_ID, 0));
+    }
+
+    // A forgotten endpoint stays in the node, get_attribute() falls back to esp_matter for it.
+    if (!endpoint_ids.empty()) {
+        uint16_t forgotten = endpoint_ids[0];
+        interpreter.forget_endpoint(forgotten);
+        CHECK(interpreter.attribute_index_stats().attributes == model.attributes + per_endpoint);
+        CHECK(index_matches_node(interpreter, shape, forgotten, true));
+        CHECK(!dispatcher.has_handler(forgotten, ON_OFF_CLUSTER_ID, 0));
+    }
+
+    // A failed interpretation leaves the index empty, and the next one fills it again.
+    esp_matter_stand_in::reset();
+    std::vector<uint8_t> truncated(model.data.begin(), model.data.begin() + model.data.size() / 2);
+    Interpreter other;
+    CHECK(other.interpret_data(truncated.data(), truncated.size()) == nullptr);
+    CHECK(other.attribute_index_stats().attributes == 0);
+    CHECK(other.interpret_data(model.data.data(), model.data.size()) != nullptr);
+    CHECK(other.attribute_index_stats().attributes == model.attributes);
+    for (uint16_t endpoint_id = 0; endpoint_id < shape.endpoints; endpoint_id++) {
+        CHECK(index_matches_node(other, shape, endpoint_id, true));
+    }
+
+    return host_test::result();
+}
@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DataModelManager slots on an in-memory storage and the stand-in app partitions: update, confirmation
+ * and rollback, the fallback after a firmware OTA, shared blobs, the erasure of unreferenced blobs and
+ * the slot state records of older versions.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "data_model_manager.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "esp_rom_crc.h"
+#include "host_test.hpp"
+#include "memory_storage.hpp"
+
+using data_model_manager::DataModelManager;
+using host_test::MemoryStorage;
+
+static std::vector<uint8_t> model(char name)
+{
+    return std::vector<uint8_t>(64, static_cast<uint8_t>(name));
+}
+
+/* The data model the manager returns at boot, or 0 if it returns none. */
+static char boot(MemoryStorage &storage)
+{
+    DataModelManager manager(storage);
+    size_t size = 0;
+    allocator_policy::Buffer binary = manager.get_data_model_binary(size);
+    if (binary.empty() || size != binary.size()) {
+        return 0;
+    }
+    return static_cast<char>(binary.data()[0]);
+}
+
+static bool confirm(MemoryStorage &storage)
+{
+    DataModelManager manager(storage);
+    return manager.mark_data_model_valid() == ESP_OK;
+}
+
+static esp_err_t update(MemoryStorage &storage, char name)
+{
+    std::vector<uint8_t> binary = model(name);
+    DataModelManager manager(storage);
+    esp_err_t err = manager.begin_update(binary.size(), esp_rom_crc32_le(0, binary.data(), binary.size()));
+    if (err == ESP_OK) {
+        // Two chunks, like a transfer.
+        err = manager.write_update(binary.data(), 10);
+    }
+    if (err == ESP_OK) {
+        err = manager.write_update(binary.data() + 10, binary.size() - 10);
+    }
+    return err == ESP_OK ? manager.end_update() : err;
+}
+
+static bool holds(MemoryStorage &storage, const char *key, char name)
+{
+    return storage.has(key) && storage.blobs[key] == model(name);
+}
+
+int main()
+{
+    esp_matter_stand_in::set_app_partitions({"ota_0", "ota_1"});
+    MemoryStorage storage;
+    storage.blobs["ota_0_dm"] = model('A');
+
+    // A fresh device boots the factory data model of slot 0, confirmed.
+    CHECK(boot(storage) == 'A');
+    CHECK(!storage.has("ota_0_dms"));
+
+    // Update and confirm.
+    CHECK(update(storage, 'B') == ESP_OK);
+    CHECK(holds(storage, "ota_0_dm1", 'B'));
+    CHECK(update(storage, 'X') == ESP_ERR_INVALID_STATE);  // B is not confirmed yet
+    {
+        DataModelManager manager(storage);
+        bool pending = false;
+        CHECK(manager.is_data_model_pending(pending) == ESP_OK && pending);
+    }
+    CHECK(boot(storage) == 'B');
+    CHECK(confirm(storage));
+    CHECK(boot(storage) == 'B');
+
+    // An update that is not confirmed is rolled back on the next boot.
+    CHECK(update(storage, 'C') == ESP_OK);
+    CHECK(holds(storage, "ota_0_dm", 'C'));  // over A, which no slot uses any more
+    CHECK(boot(storage) == 'C');
+    CHECK(boot(storage) == 'B');
+    CHECK(boot(storage) == 'B');
+
+    // A firmware OTA to ota_1 adopts the data model ota_0 uses, B in "ota_0_dm1", by reference.
+    esp_matter_stand_in::set_running_partition("ota_1");
+    std::map<std::string, std::vector<uint8_t>> before_ota = storage.blobs;
+    CHECK(boot(storage) == 'B');
+    CHECK(storage.has("ota_1_dms"));
+    for (const auto &blob : storage.blobs) {
+        CHECK(blob.first == "ota_1_dms" || before_ota.count(blob.first) == 1);  // no blob copied
+    }
+    CHECK(boot(storage) == 'B');
+    {
+        DataModelManager manager(storage);
+        allocator_policy::Buffer active;
+        CHECK(manager.get_active_data_model(active) == ESP_OK && !active.empty() && active.data()[0] == 'B');
+    }
+
+    // An update identical to a stored data model shares its blob.
+    size_t blob_count = storage.blobs.size();
+    CHECK(update(storage, 'C') == ESP_OK);
+    CHECK(storage.blobs.size() == blob_count);
+    CHECK(boot(storage) == 'C' && confirm(storage));
+
+    // Blobs are erased only once no record of any partition refers to them.
+    CHECK(update(storage, 'E') == ESP_OK);  // over the slot of "ota_0_dm1", still used by ota_0
+    CHECK(holds(storage, "ota_0_dm1", 'B') && holds(storage, "ota_1_dm", 'E'));
+    CHECK(boot(storage) == 'E' && confirm(storage));
+    CHECK(update(storage, 'F') == ESP_OK);  // over the slot of "ota_0_dm", still used by ota_0
+    CHECK(holds(storage, "ota_0_dm", 'C') && holds(storage, "ota_1_dm1", 'F'));
+    CHECK(boot(storage) == 'F' && confirm(storage));
+    CHECK(update(storage, 'B') == ESP_OK);  // shares "ota_0_dm1" over the slot of E, used by nobody else
+    CHECK(!storage.has("ota_1_dm"));
+    CHECK(boot(storage) == 'B' && confirm(storage));
+
+    // ota_0 is untouched, and can still fall back to its other slot.
+    esp_matter_stand_in::set_running_partition("ota_0");
+    CHECK(boot(storage) == 'B');
+    {
+        DataModelManager manager(storage);
+        allocator_policy::Buffer previous;
+        CHECK(manager.fall_back_to_last_known_good(previous) == ESP_OK && !previous.empty() &&
+              previous.data()[0] == 'C');
+    }
+
+    // The fallback from a confirmed data model is pending; left unconfirmed, the next boot returns to it.
+    {
+        DataModelManager manager(storage);
+        bool pending = false;
+        CHECK(manager.is_data_model_pending(pending) == ESP_OK && pending);
+    }
+    CHECK(boot(storage) == 'B');
+    {
+        DataModelManager manager(storage);
+        bool pending = true;
+        CHECK(manager.is_data_model_pending(pending) == ESP_OK && !pending);
+    }
+
+    // A pending update of ota_0 is not adopted by a partition without a record.
+    MemoryStorage pending;
+    pending.blobs["ota_0_dm"] = model('A');
+    CHECK(update(pending, 'B') == ESP_OK);
+    esp_matter_stand_in::set_running_partition("ota_1");
+    CHECK(boot(pending) == 'A');
+
+    // A record of version 1, without the blob keys, is migrated.
+    MemoryStorage v1;
+    v1.blobs["ota_0_dm"] = model('A');
+    v1.blobs["ota_0_dm1"] = model('B');
+    {
+        std::vector<uint8_t> b = model('B');
+        struct {
+            uint8_t version, active, pending, boot_attempts;
+            uint32_t size[2];
+            uint32_t crc32[2];
+        } record = {1, 1, 0, 0, {0, static_cast<uint32_t>(b.size())}, {0, esp_rom_crc32_le(0, b.data(), b.size())}};
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&record);
+        v1.blobs["ota_0_dms"].assign(bytes, bytes + sizeof(record));
+    }
+    esp_matter_stand_in::set_running_partition("ota_0");
+    CHECK(boot(v1) == 'B');
+    CHECK(update(v1, 'C') == ESP_OK);
+    CHECK(holds(v1, "ota_0_dm", 'C') && holds(v1, "ota_0_dm1", 'B'));
+    CHECK(v1.blobs["ota_0_dms"][0] == 2);  // written as version 2
+    CHECK(boot(v1) == 'C');
+    CHECK(boot(v1) == 'B');
+
+    // A record of an unknown version is rejected, the device boots slot 0.
+    MemoryStorage future;
+    future.blobs["ota_0_dm"] = model('A');
+    future.blobs["ota_0_dm1"] = model('B');
+    future.blobs["ota_0_dms"] = v1.blobs["ota_0_dms"];
+    future.blobs["ota_0_dms"][0] = 9;
+    CHECK(boot(future) == 'A');
+
+    return host_test::result();
+}
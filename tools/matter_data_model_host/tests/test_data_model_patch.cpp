@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DataModelPatcher on an in-memory storage: a patch with copy and insert ops, fed byte by byte, and
+ * the varints of the header, which have to fit a uint32.
+ */
+
+#include <vector>
+
+#include "data_model_manager.hpp"
+#include "data_model_patch.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "esp_rom_crc.h"
+#include "host_test.hpp"
+#include "memory_storage.hpp"
+
+using data_model_manager::DataModelManager;
+using data_model_manager::DataModelPatcher;
+using host_test::MemoryStorage;
+
+static void put_varint(std::vector<uint8_t> &out, uint32_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static void put_u32(std::vector<uint8_t> &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+static uint32_t crc32(const std::vector<uint8_t> &data)
+{
+    return esp_rom_crc32_le(0, data.data(), data.size());
+}
+
+/* The result of the patch header followed by the bytes of the source size varint. */
+static esp_err_t write_source_size(MemoryStorage &storage, const std::vector<uint8_t> &varint)
+{
+    DataModelManager manager(storage);
+    DataModelPatcher patcher(manager);
+    std::vector<uint8_t> patch = {'D', 'M', 'P', 1};
+    patch.insert(patch.end(), varint.begin(), varint.end());
+    CHECK(patcher.begin() == ESP_OK);
+    return patcher.write(patch.data(), patch.size());
+}
+
+int main()
+{
+    esp_matter_stand_in::set_app_partitions({"ota_0", "ota_1"});
+    std::vector<uint8_t> source(100);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = static_cast<uint8_t>(i);
+    }
+    MemoryStorage storage;
+    storage.blobs["ota_0_dm"] = source;
+
+    // The target keeps the first and last 40 bytes of the source, with 5 new bytes in between.
+    std::vector<uint8_t> target(source.begin(), source.begin() + 40);
+    target.insert(target.end(), {'p', 'a', 't', 'c', 'h'});
+    target.insert(target.end(), source.end() - 40, source.end());
+
+    std::vector<uint8_t> patch = {'D', 'M', 'P', 1};
+    put_varint(patch, source.size());
+    put_u32(patch, crc32(source));
+    put_varint(patch, target.size());
+    put_u32(patch, crc32(target));
+    patch.insert(patch.end(), {0x00, 0, 40});  // copy [0, 40)
+    patch.insert(patch.end(), {0x01, 5, 'p', 'a', 't', 'c', 'h'});
+    patch.push_back(0x00);  // copy [60, 100)
+    put_varint(patch, 60);
+    put_varint(patch, 40);
+
+    {
+        DataModelManager manager(storage);
+        DataModelPatcher patcher(manager);
+        CHECK(patcher.begin() == ESP_OK);
+        for (uint8_t byte : patch) {
+            CHECK(patcher.write(&byte, 1) == ESP_OK);
+        }
+        CHECK(patcher.end() == ESP_OK);
+        size_t size = 0;
+        allocator_policy::Buffer binary = manager.get_data_model_binary(size);
+        CHECK(size == target.size() && std::vector<uint8_t>(binary.data(), binary.data() + size) == target);
+    }
+
+    // A 5-byte varint only has room for the top 4 bits of a uint32 in its last byte.
+    CHECK(write_source_size(storage, {0xFF, 0xFF, 0xFF, 0xFF, 0x0F}) == ESP_OK);
+    CHECK(write_source_size(storage, {0xFF, 0xFF, 0xFF, 0xFF, 0x10}) == ESP_ERR_INVALID_SIZE);
+    CHECK(write_source_size(storage, {0xFF, 0xFF, 0xFF, 0xFF, 0x8F}) == ESP_ERR_INVALID_SIZE);
+    CHECK(write_source_size(storage, {0x80, 0x80, 0x80, 0x80, 0x80, 0x00}) == ESP_ERR_INVALID_SIZE);
+
+    return host_test::result();
+}
@@ -0,0 +1,425 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Out-of-line payloads read through a payload source: one batch on the first access, CRC-32 failures
+ * and retries, updates by a delta, attributes of a destroyed interpreter or a forgotten endpoint, the
+ * data model of a DataModelManager pinned across an update and a fallback, and nodes of other threads.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "data_model_manager.hpp"
+#include "esp_matter_data_model_interpreter.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "esp_rom_crc.h"
+#include "host_test.hpp"
+#include "memory_storage.hpp"
+#include "payload_source.hpp"
+#include "synthetic_model.hpp"
+
+using data_model_manager::DataModelManager;
+using esp_matter_data_model_interpreter::ActiveDataModelPayloadSource;
+using esp_matter_data_model_interpreter::Interpreter;
+using esp_matter_data_model_interpreter::IPayloadSource;
+
+static const uint32_t FIXED_LABEL_CLUSTER_ID = 0x0040;
+static const uint16_t LABEL_SIZE = 200;
+static const uint16_t STRING_SIZE = 300;
+static const size_t DEFERRED_ATTRIBUTES = 4;
+
+/*
+ * Two endpoints with a label list (attribute 0) and a long string (attribute 1) in the payload
+ * section, stored once, and a short string inline (attribute 2), like the serializer writes them
+ * with --out-of-line-threshold.
+ */
+static std::vector<uint8_t> payload_binary(char fill = 'x')
+{
+    using namespace synthetic_model::detail;
+    std::vector<uint8_t> section;
+    for (uint16_t i = 0; i < LABEL_SIZE; i++) {
+        section.push_back(static_cast<uint8_t>(i));
+    }
+    section.insert(section.end(), STRING_SIZE, fill);
+
+    synthetic_model::Model model;
+    synthetic_model::Writer declare;
+    declare.uint_field(1, section.size());
+    frame_call(model, 10, 11, declare);  // DECLARE_PAYLOADS
+    for (uint16_t endpoint_id = 0; endpoint_id < 2; endpoint_id++) {
+        synthetic_model::Writer endpoint;
+        endpoint.uint_field(1, endpoint_id);
+        endpoint.uint_field(2, 0);
+        frame_call(model, CREATE_ENDPOINT, 6, endpoint);
+        synthetic_model::Writer cluster;
+        cluster.uint_field(1, endpoint_id);
+        cluster.uint_field(2, FIXED_LABEL_CLUSTER_ID);
+        cluster.uint_field(3, 0x01);
+        frame_call(model, CREATE_CLUSTER, 5, cluster);
+
+        struct {
+            uint32_t type;
+            uint32_t offset;
+            uint32_t size;
+        } const deferred[] = {{ARRAY, 0, LABEL_SIZE}, {20 /* LONG_CHAR_STRING */, LABEL_SIZE, STRING_SIZE}};
+        for (uint32_t attribute_id = 0; attribute_id < 2; attribute_id++) {
+            synthetic_model::Writer attr_val;
+            attr_val.uint_field(1, deferred[attribute_id].type);
+            if (deferred[attribute_id].type == ARRAY) {
+                // Arrays keep their element count.
+                synthetic_model::Writer array;
+                array.uint_field(3, LABEL_SIZE);
+                synthetic_model::Writer val;
+                val.message_field(12, array);
+                attr_val.message_field(2, val);
+            }
+            synthetic_model::Writer params;
+            params.uint_field(1, endpoint_id);
+            params.uint_field(2, FIXED_LABEL_CLUSTER_ID);
+            params.uint_field(3, attribute_id);
+            params.message_field(5, attr_val);
+            params.uint_field(12, deferred[attribute_id].offset);
+            params.uint_field(13, deferred[attribute_id].size);
+            params.uint_field(14, esp_rom_crc32_le(0, section.data() + deferred[attribute_id].offset,
+                                                   deferred[attribute_id].size));
+            frame_call(model, CREATE_ATTRIBUTE, 2, params);
+        }
+
+        synthetic_model::Writer val;
+        val.bytes_field(13, "short", 5);
+        synthetic_model::Writer attr_val;
+        attr_val.uint_field(1, CHAR_STRING);
+        attr_val.message_field(2, val);
+        synthetic_model::Writer params;
+        params.uint_field(1, endpoint_id);
+        params.uint_field(2, FIXED_LABEL_CLUSTER_ID);
+        params.uint_field(3, 2);
+        params.message_field(5, attr_val);
+        frame_call(model, CREATE_ATTRIBUTE, 2, params);
+    }
+    model.data.insert(model.data.end(), section.begin(), section.end());
+    return model.data;
+}
+
+/* Serves the reads from a copy of the binary and counts them. */
+class CountingSource : public IPayloadSource {
+public:
+    std::vector<uint8_t> data;
+    esp_err_t begin_error = ESP_OK;
+    size_t reads = 0;
+    size_t batches = 0;
+    bool in_batch = false;
+
+    esp_err_t read(size_t offset, uint8_t *out, size_t size) override
+    {
+        reads++;
+        if (offset > data.size() || size > data.size() - offset) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        memcpy(out, data.data() + offset, size);
+        return ESP_OK;
+    }
+
+    esp_err_t begin_reads() override
+    {
+        if (begin_error != ESP_OK) {
+            return begin_error;
+        }
+        batches++;
+        in_batch = true;
+        return ESP_OK;
+    }
+
+    void end_reads() override { in_batch = false; }
+};
+
+static bool has_label(uint16_t endpoint_id)
+{
+    esp_matter_attr_val_t val;
+    return esp_matter_stand_in::read_attribute(endpoint_id, FIXED_LABEL_CLUSTER_ID, 0, val) == ESP_OK &&
+           val.type == ESP_MATTER_VAL_TYPE_ARRAY && val.val.a.s == LABEL_SIZE && val.val.a.n == LABEL_SIZE &&
+           val.val.a.b && val.val.a.b[LABEL_SIZE - 1] == LABEL_SIZE - 1;
+}
+
+static bool has_string(uint16_t endpoint_id, char fill = 'x')
+{
+    esp_matter_attr_val_t val;
+    return esp_matter_stand_in::read_attribute(endpoint_id, FIXED_LABEL_CLUSTER_ID, 1, val) == ESP_OK &&
+           val.val.a.s == STRING_SIZE && val.val.a.b && val.val.a.b[STRING_SIZE - 1] == fill;
+}
+
+/* A delta updating the string of attribute 1, or the label list of attribute 0 to its first count bytes. */
+static std::vector<uint8_t> update_delta(uint16_t endpoint_id, uint32_t attribute_id, const char *value, uint8_t count)
+{
+    synthetic_model::Writer val;
+    synthetic_model::Writer attr_val;
+    if (attribute_id == 0) {
+        std::vector<uint8_t> elements;
+        for (uint8_t i = 0; i < count; i++) {
+            elements.push_back(i);
+        }
+        synthetic_model::Writer array;
+        array.bytes_field(1, elements.data(), elements.size());
+        array.uint_field(3, count);
+        val.message_field(12, array);
+        attr_val.uint_field(1, synthetic_model::detail::ARRAY);
+    } else {
+        val.bytes_field(13, value, strlen(value));
+        attr_val.uint_field(1, 20);  // LONG_CHAR_STRING
+    }
+    attr_val.message_field(2, val);
+    synthetic_model::Writer params;
+    params.uint_field(1, endpoint_id);
+    params.uint_field(2, FIXED_LABEL_CLUSTER_ID);
+    params.uint_field(3, attribute_id);
+    params.message_field(5, attr_val);
+    synthetic_model::Model delta;
+    synthetic_model::detail::frame_call(delta, 8, 9, params);  // UPDATE_ATTRIBUTE
+    return delta.data;
+}
+
+static bool reads_string(uint16_t endpoint_id, const char *value)
+{
+    esp_matter_attr_val_t val;
+    return esp_matter_stand_in::read_attribute(endpoint_id, FIXED_LABEL_CLUSTER_ID, 1, val) == ESP_OK &&
+           val.val.a.s == strlen(value) && (val.val.a.s == 0 || memcmp(val.val.a.b, value, val.val.a.s) == 0);
+}
+
+static esp_err_t read_label(uint16_t endpoint_id)
+{
+    esp_matter_attr_val_t val;
+    return esp_matter_stand_in::read_attribute(endpoint_id, FIXED_LABEL_CLUSTER_ID, 0, val);
+}
+
+int main()
+{
+    const std::vector<uint8_t> binary = payload_binary();
+
+    // Without a source, the payloads are copied at boot.
+    {
+        esp_matter_stand_in::reset();
+        Interpreter interpreter;
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+        CHECK(interpreter.deferred_payload_stats().attributes == 0);
+        CHECK(has_label(1) && has_string(1));
+    }
+
+    // With a source, the first read reads all the payloads in one batch.
+    {
+        esp_matter_stand_in::reset();
+        CountingSource source;
+        source.data = binary;
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+        Interpreter::DeferredPayloadStats stats = interpreter.deferred_payload_stats();
+        CHECK(stats.attributes == DEFERRED_ATTRIBUTES && stats.loaded == 0);
+        CHECK(stats.deferred_bytes == 2u * (LABEL_SIZE + STRING_SIZE));
+        CHECK(source.reads == 0);
+
+        CHECK(has_label(1));
+        CHECK(source.batches == 1 && source.reads == DEFERRED_ATTRIBUTES && !source.in_batch);
+        CHECK(has_string(0) && has_label(0) && has_string(1));
+        CHECK(source.batches == 1 && source.reads == DEFERRED_ATTRIBUTES);
+        stats = interpreter.deferred_payload_stats();
+        CHECK(stats.loaded == DEFERRED_ATTRIBUTES && stats.loaded_bytes == 2u * (LABEL_SIZE + STRING_SIZE));
+        CHECK(stats.failures == 0);
+
+        esp_matter_attr_val_t val;
+        CHECK(esp_matter_stand_in::read_attribute(0, FIXED_LABEL_CLUSTER_ID, 2, val) == ESP_OK && val.val.a.s == 5);
+    }
+
+    // Payloads failing their CRC-32, e.g. of another binary, fail the read and are read again next time.
+    {
+        esp_matter_stand_in::reset();
+        CountingSource source;
+        source.data = binary;
+        source.data[source.data.size() - 1] ^= 0x01;
+        source.data[source.data.size() - STRING_SIZE - 1] ^= 0x01;
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+
+        CHECK(read_label(0) == ESP_ERR_INVALID_CRC);
+        Interpreter::DeferredPayloadStats stats = interpreter.deferred_payload_stats();
+        CHECK(stats.loaded == 0 && stats.failures == DEFERRED_ATTRIBUTES);
+
+        source.data = binary;
+        CHECK(has_label(0) && has_string(1));
+        stats = interpreter.deferred_payload_stats();
+        CHECK(stats.loaded == DEFERRED_ATTRIBUTES && stats.failures == DEFERRED_ATTRIBUTES);
+    }
+
+    // A batch the source cannot start fails the read without reading.
+    {
+        esp_matter_stand_in::reset();
+        CountingSource source;
+        source.data = binary;
+        source.begin_error = ESP_ERR_NO_MEM;
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+        CHECK(read_label(0) == ESP_ERR_NO_MEM);
+        CHECK(source.reads == 0 && interpreter.deferred_payload_stats().failures == 1);
+        source.begin_error = ESP_OK;
+        CHECK(has_label(0));
+    }
+
+    // A delta updating an attribute with a deferred payload replaces the payload, read or not.
+    {
+        esp_matter_stand_in::reset();
+        CountingSource source;
+        source.data = binary;
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+
+        std::vector<uint8_t> delta = update_delta(0, 1, "updated", 0);
+        CHECK(interpreter.apply_delta(delta.data(), delta.size()) == ESP_OK);
+        CHECK(esp_matter_stand_in::stats().attributes_updated == 0);
+        CHECK(esp_matter_stand_in::stats().attributes_reported == 1);
+        CHECK(reads_string(0, "updated") && source.reads == 0);
+        CHECK(has_string(1) && has_label(0));
+        CHECK(source.reads == DEFERRED_ATTRIBUTES - 1);  // the updated payload is not read
+
+        delta = update_delta(1, 0, nullptr, 3);
+        CHECK(interpreter.apply_delta(delta.data(), delta.size()) == ESP_OK);
+        esp_matter_attr_val_t val;
+        CHECK(esp_matter_stand_in::read_attribute(1, FIXED_LABEL_CLUSTER_ID, 0, val) == ESP_OK);
+        CHECK(val.type == ESP_MATTER_VAL_TYPE_ARRAY && val.val.a.s == 3 && val.val.a.n == 3 && val.val.a.b[2] == 2);
+
+        delta = update_delta(0, 1, "", 0);
+        CHECK(interpreter.apply_delta(delta.data(), delta.size()) == ESP_OK);
+        CHECK(reads_string(0, ""));
+        CHECK(source.reads == DEFERRED_ATTRIBUTES - 1);
+        Interpreter::DeferredPayloadStats stats = interpreter.deferred_payload_stats();
+        CHECK(stats.loaded == DEFERRED_ATTRIBUTES && stats.loaded_bytes == LABEL_SIZE + STRING_SIZE + 3u);
+
+        // A value without a payload cannot replace one.
+        synthetic_model::Writer attr_val;
+        attr_val.uint_field(1, synthetic_model::detail::UINT8);
+        synthetic_model::Writer number;
+        number.uint_field(5, 1);
+        attr_val.message_field(2, number);
+        synthetic_model::Writer params;
+        params.uint_field(1, 0);
+        params.uint_field(2, FIXED_LABEL_CLUSTER_ID);
+        params.uint_field(3, 1);
+        params.message_field(5, attr_val);
+        synthetic_model::Model scalar;
+        synthetic_model::detail::frame_call(scalar, 8, 9, params);
+        CHECK(interpreter.apply_delta(scalar.data.data(), scalar.data.size()) == ESP_ERR_INVALID_ARG);
+        CHECK(reads_string(0, ""));
+    }
+
+    // The attributes of a destroyed interpreter or of a forgotten endpoint are not read any more.
+    {
+        esp_matter_stand_in::reset();
+        CountingSource source;
+        source.data = binary;
+        {
+            Interpreter interpreter;
+            interpreter.set_payload_source(&source);
+            CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+        }
+        CHECK(read_label(1) == ESP_ERR_NOT_FOUND);
+        CHECK(source.reads == 0);
+
+        esp_matter_stand_in::reset();
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(binary.data(), binary.size()) != nullptr);
+        interpreter.forget_endpoint(1);
+        CHECK(interpreter.deferred_payload_stats().attributes == DEFERRED_ATTRIBUTES / 2);
+        CHECK(read_label(1) == ESP_ERR_NOT_FOUND);
+        CHECK(has_label(0) && source.reads == DEFERRED_ATTRIBUTES / 2);
+    }
+
+    // The payloads are read from the blob the manager returned the binary from, while another one is active.
+    {
+        esp_matter_stand_in::reset();
+        host_test::MemoryStorage storage;
+        storage.blobs["ota_0_dm"] = binary;
+        const std::vector<uint8_t> update = payload_binary('y');
+        {
+            DataModelManager manager(storage);
+            size_t size = 0;
+            allocator_policy::Buffer booted = manager.get_data_model_binary(size);
+            ActiveDataModelPayloadSource source(manager);
+            Interpreter interpreter;
+            interpreter.set_payload_source(&source);
+            CHECK(interpreter.interpret_data(booted.data(), size) != nullptr);
+            booted.release();
+
+            CHECK(manager.begin_update(update.size(), esp_rom_crc32_le(0, update.data(), update.size())) == ESP_OK);
+            CHECK(manager.write_update(update.data(), update.size()) == ESP_OK);
+            CHECK(manager.end_update() == ESP_OK);
+            CHECK(has_label(0) && has_string(1, 'x'));
+        }
+
+        // The next boot interprets the update, which then falls back to the previous data model.
+        esp_matter_stand_in::reset();
+        DataModelManager manager(storage);
+        size_t size = 0;
+        allocator_policy::Buffer booted = manager.get_data_model_binary(size);
+        ActiveDataModelPayloadSource source(manager);
+        Interpreter interpreter;
+        interpreter.set_payload_source(&source);
+        CHECK(interpreter.interpret_data(booted.data(), size) != nullptr);
+        allocator_policy::Buffer previous(allocator_policy::default_policy(), allocator_policy::Usage::Binary);
+        CHECK(manager.fall_back_to_last_known_good(previous) == ESP_OK);
+        CHECK(has_string(0, 'y') && has_label(1));
+
+        // A binary the manager did not return is not interpreted with its source.
+        esp_matter_stand_in::reset();
+        Interpreter other;
+        other.set_payload_source(&source);
+        CHECK(other.interpret_data(update.data(), update.size()) == nullptr);  // the fallback is pinned now
+    }
+
+    // Threads build their own node from binaries with the same attribute paths, and read their own payloads,
+    // here one after the other has built its node.
+    {
+        std::atomic<int> step{0};
+        std::atomic<size_t> mismatches{0};
+        auto device = [&step, &mismatches](char fill, int built, int read) {
+            const std::vector<uint8_t> own = payload_binary(fill);
+            while (step != built - 1) {
+                std::this_thread::yield();
+            }
+            esp_matter_stand_in::reset();
+            CountingSource source;
+            source.data.assign(own.begin(), own.end());
+            Interpreter interpreter;
+            interpreter.set_payload_source(&source);
+            if (interpreter.interpret_data(own.data(), own.size()) == nullptr) {
+                mismatches++;
+            }
+            step = built;
+            while (step != read - 1) {
+                std::this_thread::yield();
+            }
+            if (!has_string(0, fill) || !has_label(1) || !has_string(1, fill)) {
+                mismatches++;
+            }
+            step = read;
+            while (step != 4) {
+                std::this_thread::yield();
+            }
+            esp_matter_stand_in::reset();
+        };
+        std::thread x(device, 'x', 1, 3);
+        std::thread y(device, 'y', 2, 4);
+        x.join();
+        y.join();
+        CHECK(mismatches == 0);
+    }
+
+    return host_test::result();
+}
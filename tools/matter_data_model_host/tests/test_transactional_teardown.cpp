@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * A binary failing validation part way through leaves no node behind, as interpret_data() validates
+ * in the same pass as it creates the node, and the vendor clusters of a shape instantiate without
+ * plugin or command callbacks.
+ */
+
+#include <vector>
+
+#include "esp_matter_data_model_interpreter.hpp"
+#include "esp_matter_stand_in.hpp"
+#include "host_test.hpp"
+#include "synthetic_model.hpp"
+
+using esp_matter_data_model_interpreter::Interpreter;
+
+static void check_rejected(Interpreter &interpreter, const std::vector<uint8_t> &data, bool creates_endpoints)
+{
+    esp_matter_stand_in::reset();
+    CHECK(interpreter.interpret_data(data.data(), data.size()) == nullptr);
+    const esp_matter_stand_in::Stats &stats = esp_matter_stand_in::stats();
+    CHECK(!creates_endpoints || stats.endpoints_created > 0);
+    CHECK(stats.endpoints_destroyed == stats.endpoints_created);
+    CHECK(esp_matter::attribute::get(0, synthetic_model::cluster_id_at(0), 0) == nullptr);
+    CHECK(interpreter.attribute_index_stats().attributes == 0);
+}
+
+int main()
+{
+    synthetic_model::Shape shape;
+    shape.endpoints = 5;
+    shape.mix = synthetic_model::Mix::Pooled;
+    synthetic_model::Model model = synthetic_model::generate(shape);
+    Interpreter interpreter;
+
+    std::vector<uint8_t> truncated(model.data.begin(), model.data.end() - 3);
+    check_rejected(interpreter, truncated, true);
+
+    std::vector<uint8_t> corrupt = model.data;
+    for (size_t i = corrupt.size() / 2; i < corrupt.size() / 2 + 8; i++) {
+        corrupt[i] ^= 0x5a;
+    }
+    check_rejected(interpreter, corrupt, true);
+
+    // The same interpreter then builds a good binary in full.
+    esp_matter_stand_in::reset();
+    CHECK(interpreter.interpret_data(model.data.data(), model.data.size()) != nullptr);
+    CHECK(esp_matter_stand_in::stats().endpoints_created == shape.endpoints);
+    CHECK(esp_matter_stand_in::stats().attributes_created == model.attributes);
+    CHECK(interpreter.attribute_index_stats().attributes == model.attributes);
+
+    // A vendor cluster has no plugin or command callback, which instantiate() only warns about.
+    using namespace synthetic_model::detail;
+    synthetic_model::Model vendor;
+    synthetic_model::Writer endpoint;
+    endpoint.uint_field(1, 0);
+    endpoint.uint_field(2, 0);
+    frame_call(vendor, CREATE_ENDPOINT, 6, endpoint);
+    synthetic_model::Writer cluster;
+    cluster.uint_field(1, 0);
+    cluster.uint_field(2, 0xfff1fc01);
+    cluster.uint_field(3, 0x01);
+    frame_call(vendor, CREATE_CLUSTER, 5, cluster);
+    synthetic_model::Writer command;
+    command.uint_field(1, 0);
+    command.uint_field(2, 0xfff1fc01);
+    command.uint_field(3, 0);
+    command.uint_field(4, 0x01);
+    frame_call(vendor, CREATE_COMMAND, 3, command);
+
+    uint16_t shape_id = 0;
+    std::vector<uint16_t> endpoint_ids;
+    CHECK(interpreter.register_shape(vendor.data.data(), vendor.data.size(), shape_id) == ESP_OK);
+    CHECK(interpreter.instantiate(shape_id, 2, &endpoint_ids) == ESP_OK);
+    CHECK(endpoint_ids.size() == 2);
+    CHECK(esp_matter_stand_in::stats().endpoints_created == shape.endpoints + 2u);
+
+    return host_test::result();
+}
@@ -1,18 +1,37 @@
 # SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
+import json
 import pickle
 
 
 class BoundsLookup:
-    def __init__(self, pickle_file):
-        with open(pickle_file, "rb") as pfile:
-            self.lookup_table = pickle.load(pfile)
+    """Attribute bounds keyed on (cluster_id, attribute_id), loaded from a JSON bounds index or a legacy pickle."""
+
+    def __init__(self, bounds_file):
+        self.lookup_table = {}
+        if str(bounds_file).endswith(".pkl"):
+            with open(bounds_file, "rb") as pfile:
+                for cluster_id, attributes in pickle.load(pfile).items():
+                    for attribute_id, bounds in attributes.items():
+                        self.lookup_table[(cluster_id, attribute_id)] = bounds
+        else:
+            with open(bounds_file) as f:
+                index = json.load(f)
+            self.xml_sha256 = index["xml_sha256"]
+            self.sdk_revision = index.get("sdk_revision")
+            for cluster_id, attribute_id, min_value, max_value in index["bounds"]:
+                self.lookup_table[(cluster_id, attribute_id)] = {"min": min_value, "max": max_value}
 
     def get_min_max(self, cluster_id, attribute_id):
-        cluster_id = int(cluster_id)
-        attribute_id = int(attribute_id)
+        return self.lookup_table.get((int(cluster_id), int(attribute_id)))
 
-        if cluster_id in self.lookup_table and attribute_id in self.lookup_table[cluster_id]:
-            return self.lookup_table[cluster_id][attribute_id]
-        else:
-            return None
+
+_bounds_lookups = {}
+
+
+def get_bounds_lookup(bounds_file):
+    """Return the BoundsLookup for bounds_file, loading it only once per process."""
+    key = str(bounds_file)
+    if key not in _bounds_lookups:
+        _bounds_lookups[key] = BoundsLookup(bounds_file)
+    return _bounds_lookups[key]
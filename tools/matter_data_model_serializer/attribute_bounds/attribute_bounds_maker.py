@@ -1,10 +1,16 @@
 # SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 import csv
+import hashlib
+import json
 import os
 import pickle
+import subprocess
 import xml.etree.ElementTree as ET
 
+# Bump when the layout of the bounds index changes.
+BOUNDS_INDEX_VERSION = 1
+
 
 def hex_to_int(value):
     try:
@@ -39,15 +45,73 @@ def extract_attributes(xml_file):
     return attributes
 
 
-def process_directories(directories, output_csv, output_pickle):
+def xml_files(directories):
+    return [
+        os.path.join(directory, filename)
+        for directory in directories
+        for filename in sorted(os.listdir(directory))
+        if filename.endswith(".xml")
+    ]
+
+
+def extract_all_attributes(directories):
     all_attributes = []
+    for file_path in xml_files(directories):
+        all_attributes.extend(extract_attributes(file_path))
+    return all_attributes
+
+
+def hash_xml_inputs(directories):
+    """Hash of the names and contents of the cluster XMLs, which identifies the bounds they produce."""
+    digest = hashlib.sha256()
+    digest.update(str(BOUNDS_INDEX_VERSION).encode())
+    for file_path in xml_files(directories):
+        digest.update(os.path.basename(file_path).encode() + b"\0")
+        with open(file_path, "rb") as f:
+            digest.update(f.read())
+    return digest.hexdigest()
+
 
-    for directory in directories:
-        for filename in os.listdir(directory):
-            if filename.endswith(".xml"):
-                file_path = os.path.join(directory, filename)
-                attributes = extract_attributes(file_path)
-                all_attributes.extend(attributes)
+def sdk_revision(chip_sdk_root):
+    """Best effort git revision of the SDK, recorded in the index for reference only."""
+    try:
+        result = subprocess.run(
+            ["git", "-C", str(chip_sdk_root), "rev-parse", "HEAD"], capture_output=True, text=True, check=True
+        )
+        return result.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def write_bounds_index(directories, output_index, xml_sha256, revision=None):
+    """
+    Write the bounds of all attributes to a JSON index:
+        {"version": 1, "xml_sha256": ..., "sdk_revision": ..., "bounds": [[cluster_id, attribute_id, min, max], ...]}
+    The file is written under a temporary name and renamed, so concurrent runs never read a partial index.
+    """
+    bounds = [
+        [
+            hex_to_int(attr["cluster_id"]),
+            hex_to_int(attr["attribute_id"]),
+            hex_to_int(attr["min"]),
+            hex_to_int(attr["max"]),
+        ]
+        for attr in extract_all_attributes(directories)
+    ]
+    index = {
+        "version": BOUNDS_INDEX_VERSION,
+        "xml_sha256": xml_sha256,
+        "sdk_revision": revision,
+        "bounds": bounds,
+    }
+    tmp_index = f"{output_index}.{os.getpid()}.tmp"
+    with open(tmp_index, "w") as f:
+        json.dump(index, f, separators=(",", ":"))
+    os.replace(tmp_index, output_index)
+
+
+def process_directories(directories, output_csv, output_pickle):
+    all_attributes = extract_all_attributes(directories)
 
     # Write to CSV
     with open(output_csv, "w", newline="") as csvfile:
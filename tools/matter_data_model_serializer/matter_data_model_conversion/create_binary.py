@@ -1,6 +1,10 @@
 # SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 import json
+import math
+import zlib
+from collections import Counter
+
 from matter_data_model_conversion.matter_enums import (
     AttributeFlags,
     CommandFlags,
@@ -10,6 +14,7 @@ from matter_data_model_conversion.matter_enums import (
     print_flag_dictionary,
 )
 import matter_data_model_conversion.esp_matter_data_model_api_messages_pb2 as emdm_pb2
+from google.protobuf.internal.decoder import _DecodeVarint32
 from google.protobuf.internal.encoder import _VarintBytes
 
 skip_global_attributes = [
@@ -169,10 +174,7 @@ def process_endpoint(endpoint):
     proto_msg.create_endpoint_params.endpoint_id = endpoint["number"]
     proto_msg.create_endpoint_params.flags = EndpointFlags.ENDPOINT_FLAG_NONE
 
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-    return full_proto_msg.hex()
+    return proto_msg
 
 
 def process_device_type(device_type, endpoint_id):
@@ -182,10 +184,7 @@ def process_device_type(device_type, endpoint_id):
     proto_msg.endpoint_add_device_type_params.device_type_id = device_type["code"]
     proto_msg.endpoint_add_device_type_params.device_type_version = device_type["version"]
 
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-    return full_proto_msg.hex()
+    return proto_msg
 
 
 def process_cluster(cluster, endpoint_id):
@@ -196,10 +195,7 @@ def process_cluster(cluster, endpoint_id):
     proto_msg.create_cluster_params.cluster_id = cluster["code"]
     proto_msg.create_cluster_params.flags = computed_cluster_flags
 
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-    return full_proto_msg.hex()
+    return proto_msg
 
 
 def set_bounds_value(bounds_val, esp_matter_attribute_type, value):
@@ -344,16 +340,11 @@ def process_attribute(attribute, endpoint_id, cluster_id):
             max_value,
         )
 
-    # Serialize and return the protobuf message
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-
-    return full_proto_msg.hex()
+    return proto_msg
 
 
 def process_command(command, endpoint_id, cluster_id):
-    hex_messages = []
+    messages = []
     # Process the main command
     command_flags = ["COMMAND_FLAG_ACCEPTED"]
     computed_command_flags = calculate_flag_value(CommandFlags, command_flags)
@@ -364,10 +355,7 @@ def process_command(command, endpoint_id, cluster_id):
     proto_msg.create_command_params.command_id = command["code"]
     proto_msg.create_command_params.flags = computed_command_flags
 
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-    hex_messages.append(full_proto_msg.hex())
+    messages.append(proto_msg)
 
     # Process generated command if it exists
     if command.get("generated") is not None:
@@ -382,12 +370,9 @@ def process_command(command, endpoint_id, cluster_id):
         proto_msg.create_command_params.command_id = generated_command["code"]
         proto_msg.create_command_params.flags = computed_generated_flags
 
-        size = proto_msg.ByteSize()
-        size = _VarintBytes(size)
-        full_proto_msg = size + proto_msg.SerializeToString()
-        hex_messages.append(full_proto_msg.hex())
+        messages.append(proto_msg)
 
-    return hex_messages
+    return messages
 
 
 def process_event(event, endpoint_id, cluster_id):
@@ -397,45 +382,353 @@ def process_event(event, endpoint_id, cluster_id):
     proto_msg.create_event_params.cluster_id = cluster_id
     proto_msg.create_event_params.event_id = event["code"]
 
-    size = proto_msg.ByteSize()
-    size = _VarintBytes(size)
-    full_proto_msg = size + proto_msg.SerializeToString()
-    return full_proto_msg.hex()
-
-
-def process_data_model(data_model):
-    hex_messages = []
-
-    for endpoint in data_model["data_model"]["endpoints"]:
-        hex_messages.append(process_endpoint(endpoint))
-
-        for device_type in endpoint["device_types"]:
-            hex_messages.append(process_device_type(device_type, endpoint["number"]))
-
-        for cluster in endpoint["clusters"]:
-            hex_messages.append(process_cluster(cluster, endpoint["number"]))
+    return proto_msg
+
+
+def by_code(entries, canonical):
+    return sorted(entries, key=lambda entry: entry["code"]) if canonical else entries
+
+
+def process_endpoint_messages(endpoint, canonical=True, profile=None):
+    """
+    Messages creating the endpoint. With canonical set, device types, clusters, attributes, commands and
+    events are emitted in ascending id order, so the same model always gives the same bytes. With an
+    AccessProfile, the most accessed clusters and attributes are then moved first.
+    """
+    messages = [process_endpoint(endpoint)]
+
+    for device_type in by_code(endpoint["device_types"], canonical):
+        messages.append(process_device_type(device_type, endpoint["number"]))
+
+    clusters = by_code(endpoint["clusters"], canonical)
+    if profile:
+        clusters = profile.order_clusters(endpoint["number"], clusters)
+    for cluster in clusters:
+        messages.append(process_cluster(cluster, endpoint["number"]))
+
+        attributes = cluster["attributes"]
+        if canonical:
+            attributes = sorted(attributes, key=lambda attribute: attribute["definition"]["code"])
+        if profile:
+            attributes = profile.order_attributes(endpoint["number"], cluster["code"], attributes)
+        for attribute in attributes:
+            if attribute["definition"]["name"] not in skip_global_attributes:
+                messages.append(process_attribute(attribute, endpoint["number"], cluster["code"]))
+
+        for command in by_code(cluster["commands"], canonical):
+            messages.extend(process_command(command, endpoint["number"], cluster["code"]))
+
+        for event in by_code(cluster["events"], canonical):
+            messages.append(process_event(event, endpoint["number"], cluster["code"]))
+
+    return messages
+
+
+def process_data_model(data_model, canonical=True, profile=None):
+    messages = []
+
+    endpoints = data_model["data_model"]["endpoints"]
+    if canonical:
+        # The interpreter numbers endpoints in creation order, so they are always created in ascending order.
+        endpoints = sorted(endpoints, key=lambda endpoint: endpoint["number"])
+    for endpoint in endpoints:
+        messages.extend(process_endpoint_messages(endpoint, canonical, profile))
+
+    return messages
+
+
+def framed_size(message):
+    return len(_VarintBytes(message.ByteSize())) + message.ByteSize()
+
+
+STRING_VAL_TYPES = {
+    emdm_pb2.ESP_MATTER_VAL_TYPE_CHAR_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_OCTET_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING,
+}
+
+
+def is_implicit_default(params):
+    """True if the interpreter would create the attribute with the same value if val.val was not set."""
+    # Unset nullable values become null, and bounds are only applied to attributes with a value.
+    if params.flags & AttributeFlags.ATTRIBUTE_FLAG_NULLABLE:
+        return False
+    if params.HasField("bounds_min") or params.HasField("bounds_max"):
+        return False
+    field = params.val.val.WhichOneof("value")
+    if field is None:
+        return False
+    if field == "a":
+        return not params.val.val.a.elements and not params.val.val.a.s and not params.val.val.a.n
+    value = getattr(params.val.val, field)
+    if field == "f":
+        # -0.0 compares equal to 0.0 but is a different attribute value.
+        return value == 0 and math.copysign(1.0, value) > 0
+    return not value
+
+
+def elide_defaults(messages):
+    """
+    Drop attribute values equal to the interpreter's implicit defaults, and max_val_size of non-string
+    attributes, which the interpreter ignores. Returns the bytes saved per cluster id.
+    """
+    saved = Counter()
+    for message in messages:
+        if not message.HasField("create_attribute_params"):
+            continue
+        params = message.create_attribute_params
+        size = framed_size(message)
+        if is_implicit_default(params):
+            params.val.ClearField("val")
+        if params.HasField("max_val_size") and params.val.type not in STRING_VAL_TYPES:
+            params.ClearField("max_val_size")
+        if size != framed_size(message):
+            saved[params.cluster_id] += size - framed_size(message)
+    return saved
+
+
+def cluster_names(data_model):
+    return {
+        cluster["code"]: cluster["name"]
+        for endpoint in data_model["data_model"]["endpoints"]
+        for cluster in endpoint["clusters"]
+    }
 
-            for attribute in cluster["attributes"]:
-                if attribute["definition"]["name"] not in skip_global_attributes:
-                    hex_messages.append(process_attribute(attribute, endpoint["number"], cluster["code"]))
 
-            for command in cluster["commands"]:
-                hex_messages.extend(process_command(command, endpoint["number"], cluster["code"]))
+def serialize_messages(messages):
+    """Write the varint length-prefixed messages into a single buffer."""
+    buf = bytearray()
+    for message in messages:
+        buf += _VarintBytes(message.ByteSize())
+        buf += message.SerializeToString()
+    return bytes(buf)
+
+
+VALUE_FIELDS = (("bounds_min", "bounds_min_ref"), ("bounds_max", "bounds_max_ref"))
+
+
+def attribute_values(params):
+    """Yield (container, field, ref_field) for every value of the attribute that could come from the pool."""
+    # The array count left by an out-of-line payload stays with the payload reference.
+    if params.val.HasField("val") and not params.HasField("payload_size"):
+        yield params.val, "val", "val_ref"
+    for field, ref_field in VALUE_FIELDS:
+        if params.HasField(field):
+            yield params, field, ref_field
+
+
+def intern_values(messages):
+    """
+    Move values repeated across attributes (strings, arrays, bounds) into a value pool.
+
+    Each pooled value is defined once with a DEFINE_VALUE message at the start of the binary, and the
+    attributes reference it by index. A value is only pooled if that makes the binary smaller.
+    The messages are changed in place. Returns the messages to serialize and the number of pooled values.
+    """
+    uses = Counter()
+    for message in messages:
+        if message.HasField("create_attribute_params"):
+            for container, field, _ in attribute_values(message.create_attribute_params):
+                value = getattr(container, field).SerializeToString()
+                if value:
+                    uses[value] += 1
+
+    # Inline, a value costs its field tag, its length and its bytes. A reference costs a tag and the index.
+    def saving(value, count, index):
+        inline = 1 + len(_VarintBytes(len(value))) + len(value)
+        reference = 1 + len(_VarintBytes(index))
+        definition = emdm_pb2.FunctionCall()
+        definition.function = emdm_pb2.FunctionCall.FunctionType.DEFINE_VALUE
+        definition.define_value_params.index = index
+        definition.define_value_params.val.ParseFromString(value)
+        return count * (inline - reference) - framed_size(definition), definition
+
+    pool = {}
+    definitions = []
+    # Values saving the most get the smallest indexes.
+    for value, count in sorted(uses.items(), key=lambda item: -(item[1] - 1) * len(item[0])):
+        if count < 2:
+            continue
+        saved, definition = saving(value, count, len(definitions))
+        if saved > 0:
+            pool[value] = len(definitions)
+            definitions.append(definition)
+
+    for message in messages:
+        if message.HasField("create_attribute_params"):
+            params = message.create_attribute_params
+            for container, field, ref_field in list(attribute_values(params)):
+                index = pool.get(getattr(container, field).SerializeToString())
+                if index is not None:
+                    container.ClearField(field)
+                    setattr(params, ref_field, index)
+
+    return definitions + messages, len(definitions)
+
+
+OUT_OF_LINE_VAL_TYPES = {
+    emdm_pb2.ESP_MATTER_VAL_TYPE_ARRAY,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING,
+}
+
+# Attributes whose value can change keep it inline: esp_matter stores, persists or computes it.
+IN_LINE_FLAGS = (
+    AttributeFlags.ATTRIBUTE_FLAG_WRITABLE
+    | AttributeFlags.ATTRIBUTE_FLAG_NONVOLATILE
+    | AttributeFlags.ATTRIBUTE_FLAG_MANAGED_INTERNALLY
+    | AttributeFlags.ATTRIBUTE_FLAG_NULLABLE
+    | AttributeFlags.ATTRIBUTE_FLAG_OVERRIDE
+    | AttributeFlags.ATTRIBUTE_FLAG_EXTERNAL_STORAGE
+)
 
-            for event in cluster["events"]:
-                hex_messages.append(process_event(event, endpoint["number"], cluster["code"]))
+# The interpreter holds a payload in an esp_matter value, whose size is 16 bits.
+MAX_PAYLOAD_SIZE = 0xFFFF
+
+
+def attribute_payload(params):
+    """The bytes of the attribute value that could move to the payload section, or None."""
+    if params.val.type not in OUT_OF_LINE_VAL_TYPES or params.flags & IN_LINE_FLAGS:
+        return None
+    field = params.val.val.WhichOneof("value")
+    if field == "a":
+        return params.val.val.a.elements
+    if field == "char_string":
+        return params.val.val.char_string.encode("utf-8")
+    if field == "octet_string":
+        return params.val.val.octet_string
+    return None
+
+
+def move_payloads_out_of_line(messages, threshold):
+    """
+    Move the payloads of constant array and long string attributes of at least threshold bytes into a
+    payload section, which the interpreter reads on the first access instead of at boot.
+
+    The attributes keep the offset, size and CRC-32 of their payload, and arrays their element count.
+    Identical payloads are stored once. The messages are changed in place. Returns the section bytes and
+    the number of attributes moved.
+    """
+    section = bytearray()
+    offsets = {}
+    moved = 0
+    for message in messages:
+        if not message.HasField("create_attribute_params"):
+            continue
+        params = message.create_attribute_params
+        payload = attribute_payload(params)
+        if payload is None or len(payload) < max(threshold, 1) or len(payload) > MAX_PAYLOAD_SIZE:
+            continue
+        offset = offsets.get(payload)
+        if offset is None:
+            offset = offsets[payload] = len(section)
+            section += payload
+        if params.val.val.WhichOneof("value") == "a":
+            count = params.val.val.a.n
+            params.val.val.a.Clear()
+            params.val.val.a.n = count
+        else:
+            params.val.ClearField("val")
+        params.payload_offset = offset
+        params.payload_size = len(payload)
+        params.payload_crc32 = zlib.crc32(payload)
+        moved += 1
+    return bytes(section), moved
+
+
+def declare_payloads(size):
+    message = emdm_pb2.FunctionCall()
+    message.function = emdm_pb2.FunctionCall.FunctionType.DECLARE_PAYLOADS
+    message.declare_payloads_params.size = size
+    return message
+
+
+def split_payload_section(data):
+    """Split a data model binary into its messages and its payload section, empty if it has none."""
+    if not data:
+        return data, b""
+    size, pos = _DecodeVarint32(data, 0)
+    first = emdm_pb2.FunctionCall.FromString(data[pos : pos + size])
+    if not first.HasField("declare_payloads_params"):
+        return data, b""
+    section_size = first.declare_payloads_params.size
+    if section_size > len(data) - pos - size:
+        raise ValueError("Payload section larger than the data model binary")
+    return data[: len(data) - section_size], data[len(data) - section_size :]
+
+
+def create_binary(data_model, use_value_pool=True, optimize=True, profile=None, out_of_line_threshold=0):
+    """
+    Serialize an in-memory data model (as returned by generate_json_data_model) into the binary format.
+    optimize sorts the messages canonically and drops implicit default values. profile (an AccessProfile)
+    creates the most accessed clusters and attributes first. out_of_line_threshold, if not 0, moves the
+    constant array and long string payloads of at least that many bytes to a payload section.
+    """
+    messages = process_data_model(data_model, canonical=optimize, profile=profile)
+    if profile:
+        steps = profile.lookup_steps(process_data_model(data_model, canonical=optimize))
+        print(
+            f"Access profile: {steps:.2f} -> {profile.lookup_steps(messages):.2f} clusters and attributes "
+            f"visited per attribute lookup"
+        )
+    if optimize:
+        saved = elide_defaults(messages)
+        names = cluster_names(data_model)
+        print(f"Default elision: {sum(saved.values())} bytes saved")
+        for cluster_id, cluster_saved in saved.most_common():
+            print(f"- {names.get(cluster_id, 'Unknown')} (0x{cluster_id:04x}): {cluster_saved} bytes")
+    payloads = b""
+    if out_of_line_threshold:
+        payloads, moved = move_payloads_out_of_line(messages, out_of_line_threshold)
+        print(
+            f"Out-of-line payloads: {moved} attributes, {len(payloads)} byte payload section "
+            f"(not decoded at boot, read on the first access)"
+        )
+    # The payload section is declared by the first message, before the pooled values.
+    declaration = [declare_payloads(len(payloads))] if payloads else []
+    if not use_value_pool:
+        return serialize_messages(declaration + messages) + payloads
+
+    inline_size = sum(framed_size(m) for m in messages)
+    messages, pooled_values = intern_values(messages)
+    bin_data = serialize_messages(messages)
+    # The device reads the whole binary into RAM before interpreting it.
+    print(
+        f"Value pool: {pooled_values} values, binary {inline_size} -> {len(bin_data)} bytes "
+        f"({inline_size - len(bin_data)} bytes less to store and hold in RAM during interpretation)"
+    )
+    return serialize_messages(declaration) + bin_data + payloads
+
+
+def write_binary_file(data_model, bin_file_path, use_value_pool=True, optimize=True, profile=None,
+                      out_of_line_threshold=0):
+    bin_data = create_binary(data_model, use_value_pool, optimize, profile, out_of_line_threshold)
+    with open(bin_file_path, "wb") as bin_file:
+        bin_file.write(bin_data)
 
-    return hex_messages
+    print(f"Binary file written to: {bin_file_path}")
+    return bin_data
 
 
-def create_binary_file(json_file_path, bin_file_path):
+def create_binary_file(json_file_path, bin_file_path, use_value_pool=True, optimize=True):
     with open(json_file_path) as f:
         data_model = json.load(f)
-        hex_messages = process_data_model(data_model)
+    return write_binary_file(data_model, bin_file_path, use_value_pool, optimize)
 
-    combined_hex = "".join(hex_messages)
-    bin_data = bytes.fromhex(combined_hex)
-    with open(bin_file_path, "wb") as bin_file:
-        bin_file.write(bin_data)
 
-    print(f"Binary file written to: {bin_file_path}")
+def create_shape_file(data_model, endpoint_id, shape_file_path, profile=None):
+    """Write the messages of a single endpoint, to be registered with Interpreter::register_shape."""
+    for endpoint in data_model["data_model"]["endpoints"]:
+        if endpoint["number"] == endpoint_id:
+            break
+    else:
+        raise ValueError(f"Endpoint {endpoint_id} not found in the data model")
+    if endpoint_id == 0:
+        raise ValueError("The root endpoint cannot be used as a shape")
+
+    bin_data = serialize_messages(process_endpoint_messages(endpoint, profile=profile))
+    with open(shape_file_path, "wb") as shape_file:
+        shape_file.write(bin_data)
+
+    print(f"Shape file written to: {shape_file_path}")
@@ -0,0 +1,125 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Create a data model delta binary from two JSON data models.
+
+The delta is applied on a running device with `Interpreter::apply_delta`:
+- Endpoints that only exist in the old data model are removed.
+- Endpoints that only exist in the new data model are created.
+- Endpoints whose structure (device types, clusters, attributes, commands, events or flags) changed
+  are removed and created again, since esp_matter cannot remove a single cluster from an endpoint.
+- Attributes whose default value or bounds changed are updated in place.
+"""
+import json
+
+from matter_data_model_conversion.create_binary import process_endpoint_messages, serialize_messages
+import matter_data_model_conversion.esp_matter_data_model_api_messages_pb2 as emdm_pb2
+
+
+def endpoint_messages(data_model, profile=None):
+    """Map each endpoint number to the FunctionCall messages creating it, in data model order."""
+    return {
+        endpoint["number"]: process_endpoint_messages(endpoint, profile=profile)
+        for endpoint in data_model["data_model"]["endpoints"]
+    }
+
+
+def structure_key(messages):
+    """Serialize the messages without attribute values and bounds (but keeping whether they are present)."""
+    key = []
+    for message in messages:
+        stripped = emdm_pb2.FunctionCall()
+        stripped.CopyFrom(message)
+        if stripped.HasField("create_attribute_params"):
+            params = stripped.create_attribute_params
+            for field in ("bounds_min", "bounds_max"):
+                if params.HasField(field):
+                    getattr(params, field).Clear()
+                    getattr(params, field).SetInParent()
+            if params.val.HasField("val"):
+                params.val.val.Clear()
+                params.val.val.SetInParent()
+        key.append(stripped.SerializeToString())
+    return key
+
+
+def update_attribute_message(create_message):
+    create_params = create_message.create_attribute_params
+    proto_msg = emdm_pb2.FunctionCall()
+    proto_msg.function = emdm_pb2.FunctionCall.FunctionType.UPDATE_ATTRIBUTE
+    params = proto_msg.update_attribute_params
+    params.endpoint_id = create_params.endpoint_id
+    params.cluster_id = create_params.cluster_id
+    params.attribute_id = create_params.attribute_id
+    params.flags = create_params.flags
+    params.val.CopyFrom(create_params.val)
+    if create_params.HasField("bounds_min") and create_params.HasField("bounds_max"):
+        params.bounds_min.CopyFrom(create_params.bounds_min)
+        params.bounds_max.CopyFrom(create_params.bounds_max)
+    return proto_msg
+
+
+def remove_endpoint_message(endpoint_id):
+    proto_msg = emdm_pb2.FunctionCall()
+    proto_msg.function = emdm_pb2.FunctionCall.FunctionType.REMOVE_ENDPOINT
+    proto_msg.remove_endpoint_params.endpoint_id = endpoint_id
+    return proto_msg
+
+
+def compute_delta(old_data_model, new_data_model, profile=None):
+    """
+    Return the delta messages and a summary of the changes. Both data models are ordered with profile,
+    which has to be the access profile the binary on the device was created with.
+    """
+    old_endpoints = endpoint_messages(old_data_model, profile)
+    new_endpoints = endpoint_messages(new_data_model, profile)
+    removals = []
+    creations = []
+    updates = []
+    summary = {"removed": [], "added": [], "rebuilt": [], "updated_attributes": 0}
+
+    for endpoint_id in old_endpoints:
+        if endpoint_id not in new_endpoints:
+            removals.append(remove_endpoint_message(endpoint_id))
+            summary["removed"].append(endpoint_id)
+
+    # The device creates endpoints in increasing id order, like process_data_model emits them.
+    for endpoint_id, new_messages in sorted(new_endpoints.items()):
+        old_messages = old_endpoints.get(endpoint_id)
+        if old_messages is None:
+            creations.extend(new_messages)
+            summary["added"].append(endpoint_id)
+        elif structure_key(old_messages) != structure_key(new_messages):
+            if endpoint_id == 0:
+                raise ValueError("The structure of the root endpoint changed, a full data model update is required")
+            removals.append(remove_endpoint_message(endpoint_id))
+            creations.extend(new_messages)
+            summary["rebuilt"].append(endpoint_id)
+        else:
+            # Same structure, so the messages pair up one to one.
+            for old_message, new_message in zip(old_messages, new_messages):
+                if old_message.SerializeToString() != new_message.SerializeToString():
+                    updates.append(update_attribute_message(new_message))
+                    summary["updated_attributes"] += 1
+
+    return removals + creations + updates, summary
+
+
+def write_delta_file(old_data_model, new_data_model, delta_file_path, profile=None):
+    messages, summary = compute_delta(old_data_model, new_data_model, profile)
+    with open(delta_file_path, "wb") as delta_file:
+        delta_file.write(serialize_messages(messages))
+
+    print(f"Delta file written to: {delta_file_path}")
+    print(f"- Removed endpoints: {summary['removed']}")
+    print(f"- Added endpoints: {summary['added']}")
+    print(f"- Rebuilt endpoints: {summary['rebuilt']}")
+    print(f"- Updated attributes: {summary['updated_attributes']}")
+
+
+def create_delta_file(old_json_file_path, new_json_file_path, delta_file_path):
+    with open(old_json_file_path) as f:
+        old_data_model = json.load(f)
+    with open(new_json_file_path) as f:
+        new_data_model = json.load(f)
+    write_delta_file(old_data_model, new_data_model, delta_file_path)
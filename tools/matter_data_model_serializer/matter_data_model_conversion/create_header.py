@@ -0,0 +1,195 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Create a C++ header with the data model as constexpr tables, for Interpreter::interpret_static.
+
+The tables are built from the same messages as the binary (canonical order, implicit defaults elided),
+so the node created from the header is the same as the one created from the binary. Values are
+deduplicated into one table and referenced by pointer, like the value pool of the binary.
+"""
+import string
+import struct
+
+from matter_data_model_conversion.create_binary import elide_defaults, process_data_model
+
+DEFAULT_NAMESPACE = "esp_matter_static_data_model"
+
+PLAIN_CHARS = set(string.ascii_letters + string.digits + " _-.,:;/()[]{}<>=+*#@!%&'|~^$")
+
+
+def cpp_bytes(data):
+    return "{" + ", ".join(f"0x{b:02x}" for b in data) + "}"
+
+
+class HeaderWriter:
+    def __init__(self):
+        self.values = []
+        self.value_index = {}
+        self.payloads = []
+        self.tables = []
+
+    def value_ref(self, val):
+        """Pointer expression of the value in the values table, or nullptr if the value is not set."""
+        field = val.WhichOneof("value")
+        if field is None:
+            return "nullptr"
+        key = val.SerializeToString()
+        if key not in self.value_index:
+            self.value_index[key] = len(self.values)
+            self.values.append(self.value_entry(val, field, len(self.values)))
+        return f"&values[{self.value_index[key]}]"
+
+    def payload(self, index, data):
+        name = f"value_{index}_data"
+        self.payloads.append(f"inline constexpr uint8_t {name}[] = {cpp_bytes(data)};")
+        return name
+
+    def value_entry(self, val, field, index):
+        number = val.DESCRIPTOR.fields_by_name[field].number
+        bits, data, size, count = 0, "nullptr", 0, 0
+        if field == "char_string":
+            text = val.char_string
+            if text and all(c in PLAIN_CHARS for c in text):
+                data = f'"{text}"'
+            else:
+                data = self.payload(index, text.encode() + b"\0")
+        elif field == "octet_string":
+            size = len(val.octet_string)
+            if size:
+                data = self.payload(index, val.octet_string)
+        elif field == "a":
+            size = len(val.a.elements)
+            count = val.a.n
+            if size:
+                data = self.payload(index, val.a.elements)
+        elif field == "f":
+            bits = struct.unpack("<I", struct.pack("<f", val.f))[0]
+        else:
+            bits = int(getattr(val, field)) & 0xFFFFFFFFFFFFFFFF
+        return f"{{{number}, 0x{bits:x}, {data}, {size}, {count}}}"
+
+    def table(self, type_name, name, entries):
+        """Emit a table and return (name, count), with nullptr for empty tables."""
+        if not entries:
+            return "nullptr", 0
+        body = "\n".join(f"    {entry}," for entry in entries)
+        self.tables.append(f"inline constexpr sm::{type_name} {name}[] = {{\n{body}\n}};")
+        return name, len(entries)
+
+    def cluster_entry(self, endpoint_id, cluster):
+        prefix = f"ep{endpoint_id}_cluster_0x{cluster['params'].cluster_id:04x}"
+        attributes = []
+        for params in cluster["attributes"]:
+            val = self.value_ref(params.val.val) if params.val.HasField("val") else "nullptr"
+            bounds_min, bounds_max = "nullptr", "nullptr"
+            if params.HasField("bounds_min") and params.HasField("bounds_max"):
+                bounds_min = self.value_ref(params.bounds_min)
+                bounds_max = self.value_ref(params.bounds_max)
+            max_val_size = params.max_val_size if params.HasField("max_val_size") else 0
+            attributes.append(
+                f"{{0x{params.attribute_id:08x}, 0x{params.flags:04x}, {params.val.type}, {max_val_size}, "
+                f"{val}, {bounds_min}, {bounds_max}}}"
+            )
+        commands = [f"{{0x{params.command_id:08x}, 0x{params.flags:x}}}" for params in cluster["commands"]]
+        events = [f"0x{params.event_id:08x}" for params in cluster["events"]]
+
+        attributes = self.table("Attribute", f"{prefix}_attributes", attributes)
+        commands = self.table("Command", f"{prefix}_commands", commands)
+        if events:
+            self.tables.append(f"inline constexpr uint32_t {prefix}_events[] = {{{', '.join(events)}}};")
+            events = (f"{prefix}_events", len(events))
+        else:
+            events = ("nullptr", 0)
+        params = cluster["params"]
+        return (
+            f"{{0x{params.cluster_id:08x}, 0x{params.flags:02x}, {attributes[0]}, {attributes[1]}, "
+            f"{commands[0]}, {commands[1]}, {events[0]}, {events[1]}}}"
+        )
+
+    def endpoint_entry(self, endpoint):
+        endpoint_id = endpoint["params"].endpoint_id
+        device_types = [
+            f"{{0x{params.device_type_id:08x}, {params.device_type_version}}}" for params in endpoint["device_types"]
+        ]
+        device_types = self.table("DeviceType", f"ep{endpoint_id}_device_types", device_types)
+        clusters = [self.cluster_entry(endpoint_id, cluster) for cluster in endpoint["clusters"]]
+        clusters = self.table("Cluster", f"ep{endpoint_id}_clusters", clusters)
+        return (
+            f"{{{endpoint_id}, 0x{endpoint['params'].flags:02x}, {device_types[0]}, {device_types[1]}, "
+            f"{clusters[0]}, {clusters[1]}}}"
+        )
+
+    def render(self, endpoints, namespace, source):
+        endpoint_entries = [self.endpoint_entry(endpoint) for endpoint in endpoints]
+        values = "\n".join(f"    {value}," for value in self.values)
+        guard = namespace.upper() + "_HPP"
+        lines = [
+            f"// Generated by the matter data model serializer from {source}, do not edit.",
+            f"#ifndef {guard}",
+            f"#define {guard}",
+            "",
+            "#include <cstdint>",
+            "",
+            '#include "esp_matter_data_model_static.hpp"',
+            "",
+            f"namespace {namespace} {{",
+            "",
+            "namespace sm = esp_matter_data_model_interpreter::static_model;",
+            "",
+            *self.payloads,
+        ]
+        if self.values:
+            lines += ["", f"inline constexpr sm::Value values[] = {{\n{values}\n}};"]
+        for table in self.tables:
+            lines += ["", table]
+        body = "\n".join(f"    {entry}," for entry in endpoint_entries)
+        lines += [
+            "",
+            f"inline constexpr sm::Endpoint endpoints[] = {{\n{body}\n}};",
+            "",
+            f"inline constexpr sm::Model model = {{endpoints, {len(endpoint_entries)}}};",
+            "",
+            f"}} // namespace {namespace}",
+            "",
+            f"#endif // {guard}",
+            "",
+        ]
+        return "\n".join(lines)
+
+
+def group_messages(messages):
+    """Nest the flat message list into endpoints and clusters, in message order."""
+    endpoints = []
+    for message in messages:
+        kind = message.WhichOneof("params")
+        if kind == "create_endpoint_params":
+            endpoints.append({"params": message.create_endpoint_params, "device_types": [], "clusters": []})
+        elif kind == "endpoint_add_device_type_params":
+            endpoints[-1]["device_types"].append(message.endpoint_add_device_type_params)
+        elif kind == "create_cluster_params":
+            endpoints[-1]["clusters"].append(
+                {"params": message.create_cluster_params, "attributes": [], "commands": [], "events": []}
+            )
+        elif kind == "create_attribute_params":
+            endpoints[-1]["clusters"][-1]["attributes"].append(message.create_attribute_params)
+        elif kind == "create_command_params":
+            endpoints[-1]["clusters"][-1]["commands"].append(message.create_command_params)
+        elif kind == "create_event_params":
+            endpoints[-1]["clusters"][-1]["events"].append(message.create_event_params)
+        else:
+            raise ValueError(f"Unexpected message {kind} in data model")
+    return endpoints
+
+
+def create_header(data_model, namespace=DEFAULT_NAMESPACE, source="data model", profile=None):
+    messages = process_data_model(data_model, profile=profile)
+    elide_defaults(messages)
+    return HeaderWriter().render(group_messages(messages), namespace, source)
+
+
+def write_header_file(data_model, header_file_path, namespace=DEFAULT_NAMESPACE, source="data model", profile=None):
+    header = create_header(data_model, namespace, source, profile)
+    with open(header_file_path, "w") as header_file:
+        header_file.write(header)
+    print(f"Header file written to: {header_file_path}")
+    return header
@@ -2,7 +2,7 @@
 # SPDX-License-Identifier: Apache-2.0
 import json
 
-from attribute_bounds.attribute_bounds_lookup import BoundsLookup
+from attribute_bounds.attribute_bounds_lookup import get_bounds_lookup
 
 try:
     from matter_idl.matter_idl_parser import CreateParser
@@ -104,9 +104,9 @@ def collect_instantiated_events(endpoints):
     return instantiated_events
 
 
-def generate_json_data_model(idl_text, attribute_bounds_pkl_path):
+def generate_json_data_model(idl_text, attribute_bounds_path):
     parsed_idl = parseText(idl_text)
-    bounds_lookup = BoundsLookup(attribute_bounds_pkl_path)
+    bounds_lookup = get_bounds_lookup(attribute_bounds_path)
 
     instantiated_attributes = collect_instantiated_attributes(parsed_idl.endpoints)
     instantiated_commands = collect_instantiated_commands(parsed_idl.endpoints)
@@ -253,11 +253,14 @@ def generate_json_data_model(idl_text, attribute_bounds_pkl_path):
     return data_model
 
 
-def create_json_data_model(idl_file_path, json_file_path, attribute_bounds_pkl_path):
-    idl_text = load_idl_text(idl_file_path)
-    json_data_model = generate_json_data_model(idl_text, attribute_bounds_pkl_path)
-
+def write_json_data_model(data_model, json_file_path):
     with open(json_file_path, "w") as json_file:
-        json.dump(json_data_model, json_file, indent=4)
+        json.dump(data_model, json_file, indent=4)
 
     print(f"JSON file written to: {json_file_path}")
+
+
+def create_json_data_model(idl_file_path, json_file_path, attribute_bounds_path):
+    idl_text = load_idl_text(idl_file_path)
+    json_data_model = generate_json_data_model(idl_text, attribute_bounds_path)
+    write_json_data_model(json_data_model, json_file_path)
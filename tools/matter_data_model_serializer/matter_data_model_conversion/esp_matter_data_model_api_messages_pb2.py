@@ -14,15 +14,15 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n(esp_matter_data_model_api_messages.proto\x12\tdatamodel\"\x8b\x02\n\x0c\x45spMatterVal\x12\x0b\n\x01\x62\x18\x01 \x01(\x08H\x00\x12\x0b\n\x01i\x18\x02 \x01(\x05H\x00\x12\x0b\n\x01\x66\x18\x03 \x01(\x02H\x00\x12\x0c\n\x02i8\x18\x04 \x01(\x05H\x00\x12\x0c\n\x02u8\x18\x05 \x01(\rH\x00\x12\r\n\x03i16\x18\x06 \x01(\x05H\x00\x12\r\n\x03u16\x18\x07 \x01(\rH\x00\x12\r\n\x03i32\x18\x08 \x01(\x05H\x00\x12\r\n\x03u32\x18\t \x01(\rH\x00\x12\r\n\x03i64\x18\n \x01(\x03H\x00\x12\r\n\x03u64\x18\x0b \x01(\x04H\x00\x12&\n\x01\x61\x18\x0c \x01(\x0b\x32\x19.datamodel.EspMatterArrayH\x00\x12\x15\n\x0b\x63har_string\x18\r \x01(\tH\x00\x12\x16\n\x0coctet_string\x18\x0e \x01(\x0cH\x00\x42\x07\n\x05value\"C\n\x0e\x45spMatterArray\x12\x10\n\x08\x65lements\x18\x01 \x01(\x0c\x12\t\n\x01s\x18\x02 \x01(\r\x12\t\n\x01n\x18\x03 \x01(\r\x12\t\n\x01t\x18\x04 \x01(\r\"c\n\x10\x45spMatterAttrVal\x12)\n\x04type\x18\x01 \x01(\x0e\x32\x1b.datamodel.EspMatterValType\x12$\n\x03val\x18\x02 \x01(\x0b\x32\x17.datamodel.EspMatterVal\"\xff\x01\n\x15\x43reateAttributeParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x14\n\x0c\x61ttribute_id\x18\x03 \x01(\r\x12\r\n\x05\x66lags\x18\x04 \x01(\r\x12(\n\x03val\x18\x05 \x01(\x0b\x32\x1b.datamodel.EspMatterAttrVal\x12\x14\n\x0cmax_val_size\x18\x06 \x01(\r\x12+\n\nbounds_min\x18\x07 \x01(\x0b\x32\x17.datamodel.EspMatterVal\x12+\n\nbounds_max\x18\x08 \x01(\x0b\x32\x17.datamodel.EspMatterVal\"a\n\x13\x43reateCommandParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x12\n\ncommand_id\x18\x03 \x01(\r\x12\r\n\x05\x66lags\x18\x04 \x01(\r\"N\n\x11\x43reateEventParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x10\n\x08\x65vent_id\x18\x03 \x01(\r\"M\n\x13\x43reateClusterParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\r\n\x05\x66lags\x18\x03 \x01(\r\":\n\x14\x43reateEndpointParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\r\n\x05\x66lags\x18\x02 \x01(\r\"g\n\x1b\x45ndpointAddDeviceTypeParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x16\n\x0e\x64\x65vice_type_id\x18\x02 \x01(\r\x12\x1b\n\x13\x64\x65vice_type_version\x18\x03 \x01(\r\"\xfe\x04\n\x0c\x46unctionCall\x12\x36\n\x08\x66unction\x18\x01 \x01(\x0e\x32$.datamodel.FunctionCall.FunctionType\x12\x43\n\x17\x63reate_attribute_params\x18\x02 \x01(\x0b\x32 .datamodel.CreateAttributeParamsH\x00\x12?\n\x15\x63reate_command_params\x18\x03 \x01(\x0b\x32\x1e.datamodel.CreateCommandParamsH\x00\x12;\n\x13\x63reate_event_params\x18\x04 \x01(\x0b\x32\x1c.datamodel.CreateEventParamsH\x00\x12?\n\x15\x63reate_cluster_params\x18\x05 \x01(\x0b\x32\x1e.datamodel.CreateClusterParamsH\x00\x12\x41\n\x16\x63reate_endpoint_params\x18\x06 \x01(\x0b\x32\x1f.datamodel.CreateEndpointParamsH\x00\x12Q\n\x1f\x65ndpoint_add_device_type_params\x18\x07 \x01(\x0b\x32&.datamodel.EndpointAddDeviceTypeParamsH\x00\"\x91\x01\n\x0c\x46unctionType\x12\x14\n\x10\x43REATE_ATTRIBUTE\x10\x01\x12\x12\n\x0e\x43REATE_COMMAND\x10\x02\x12\x10\n\x0c\x43REATE_EVENT\x10\x03\x12\x12\n\x0e\x43REATE_CLUSTER\x10\x04\x12\x13\n\x0f\x43REATE_ENDPOINT\x10\x05\x12\x1c\n\x18\x45NDPOINT_ADD_DEVICE_TYPE\x10\x06\x42\x08\n\x06params*\xf1\x05\n\x10\x45spMatterValType\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_INVALID\x10\x00\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_BOOLEAN\x10\x01\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_INTEGER\x10\x02\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_FLOAT\x10\x03\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_ARRAY\x10\x04\x12#\n\x1f\x45SP_MATTER_VAL_TYPE_CHAR_STRING\x10\x05\x12$\n ESP_MATTER_VAL_TYPE_OCTET_STRING\x10\x06\x12\x1c\n\x18\x45SP_MATTER_VAL_TYPE_INT8\x10\x07\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_UINT8\x10\x08\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT16\x10\t\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT16\x10\n\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT32\x10\x0b\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT32\x10\x0c\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT64\x10\r\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT64\x10\x0e\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_ENUM8\x10\x0f\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_BITMAP8\x10\x10\x12 \n\x1c\x45SP_MATTER_VAL_TYPE_BITMAP16\x10\x11\x12 \n\x1c\x45SP_MATTER_VAL_TYPE_BITMAP32\x10\x12\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_ENUM16\x10\x13\x12(\n$ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING\x10\x14\x12)\n%ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING\x10\x15')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n(esp_matter_data_model_api_messages.proto\x12\tdatamodel\"\x8b\x02\n\x0c\x45spMatterVal\x12\x0b\n\x01\x62\x18\x01 \x01(\x08H\x00\x12\x0b\n\x01i\x18\x02 \x01(\x05H\x00\x12\x0b\n\x01\x66\x18\x03 \x01(\x02H\x00\x12\x0c\n\x02i8\x18\x04 \x01(\x05H\x00\x12\x0c\n\x02u8\x18\x05 \x01(\rH\x00\x12\r\n\x03i16\x18\x06 \x01(\x05H\x00\x12\r\n\x03u16\x18\x07 \x01(\rH\x00\x12\r\n\x03i32\x18\x08 \x01(\x05H\x00\x12\r\n\x03u32\x18\t \x01(\rH\x00\x12\r\n\x03i64\x18\n \x01(\x03H\x00\x12\r\n\x03u64\x18\x0b \x01(\x04H\x00\x12&\n\x01\x61\x18\x0c \x01(\x0b\x32\x19.datamodel.EspMatterArrayH\x00\x12\x15\n\x0b\x63har_string\x18\r \x01(\tH\x00\x12\x16\n\x0coctet_string\x18\x0e \x01(\x0cH\x00\x42\x07\n\x05value\"C\n\x0e\x45spMatterArray\x12\x10\n\x08\x65lements\x18\x01 \x01(\x0c\x12\t\n\x01s\x18\x02 \x01(\r\x12\t\n\x01n\x18\x03 \x01(\r\x12\t\n\x01t\x18\x04 \x01(\r\"c\n\x10\x45spMatterAttrVal\x12)\n\x04type\x18\x01 \x01(\x0e\x32\x1b.datamodel.EspMatterValType\x12$\n\x03val\x18\x02 \x01(\x0b\x32\x17.datamodel.EspMatterVal\"\x85\x03\n\x15\x43reateAttributeParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x14\n\x0c\x61ttribute_id\x18\x03 \x01(\r\x12\r\n\x05\x66lags\x18\x04 \x01(\r\x12(\n\x03val\x18\x05 \x01(\x0b\x32\x1b.datamodel.EspMatterAttrVal\x12\x14\n\x0cmax_val_size\x18\x06 \x01(\r\x12+\n\nbounds_min\x18\x07 \x01(\x0b\x32\x17.datamodel.EspMatterVal\x12+\n\nbounds_max\x18\x08 \x01(\x0b\x32\x17.datamodel.EspMatterVal\x12\x0f\n\x07val_ref\x18\t \x01(\r\x12\x16\n\x0e\x62ounds_min_ref\x18\n \x01(\r\x12\x16\n\x0e\x62ounds_max_ref\x18\x0b \x01(\r\x12\x16\n\x0epayload_offset\x18\x0c \x01(\r\x12\x14\n\x0cpayload_size\x18\r \x01(\r\x12\x15\n\rpayload_crc32\x18\x0e \x01(\r\"a\n\x13\x43reateCommandParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x12\n\ncommand_id\x18\x03 \x01(\r\x12\r\n\x05\x66lags\x18\x04 \x01(\r\"N\n\x11\x43reateEventParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x10\n\x08\x65vent_id\x18\x03 \x01(\r\"M\n\x13\x43reateClusterParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\r\n\x05\x66lags\x18\x03 \x01(\r\":\n\x14\x43reateEndpointParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\r\n\x05\x66lags\x18\x02 \x01(\r\"g\n\x1b\x45ndpointAddDeviceTypeParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x16\n\x0e\x64\x65vice_type_id\x18\x02 \x01(\r\x12\x1b\n\x13\x64\x65vice_type_version\x18\x03 \x01(\r\"+\n\x14RemoveEndpointParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\"\xe9\x01\n\x15UpdateAttributeParams\x12\x13\n\x0b\x65ndpoint_id\x18\x01 \x01(\r\x12\x12\n\ncluster_id\x18\x02 \x01(\r\x12\x14\n\x0c\x61ttribute_id\x18\x03 \x01(\r\x12\r\n\x05\x66lags\x18\x04 \x01(\r\x12(\n\x03val\x18\x05 \x01(\x0b\x32\x1b.datamodel.EspMatterAttrVal\x12+\n\nbounds_min\x18\x06 \x01(\x0b\x32\x17.datamodel.EspMatterVal\x12+\n\nbounds_max\x18\x07 \x01(\x0b\x32\x17.datamodel.EspMatterVal\"H\n\x11\x44\x65\x66ineValueParams\x12\r\n\x05index\x18\x01 \x01(\r\x12$\n\x03val\x18\x02 \x01(\x0b\x32\x17.datamodel.EspMatterVal\"%\n\x15\x44\x65\x63larePayloadsParams\x12\x0c\n\x04size\x18\x01 \x01(\r\"\xdb\x07\n\x0c\x46unctionCall\x12\x36\n\x08\x66unction\x18\x01 \x01(\x0e\x32$.datamodel.FunctionCall.FunctionType\x12\x43\n\x17\x63reate_attribute_params\x18\x02 \x01(\x0b\x32 .datamodel.CreateAttributeParamsH\x00\x12?\n\x15\x63reate_command_params\x18\x03 \x01(\x0b\x32\x1e.datamodel.CreateCommandParamsH\x00\x12;\n\x13\x63reate_event_params\x18\x04 \x01(\x0b\x32\x1c.datamodel.CreateEventParamsH\x00\x12?\n\x15\x63reate_cluster_params\x18\x05 \x01(\x0b\x32\x1e.datamodel.CreateClusterParamsH\x00\x12\x41\n\x16\x63reate_endpoint_params\x18\x06 \x01(\x0b\x32\x1f.datamodel.CreateEndpointParamsH\x00\x12Q\n\x1f\x65ndpoint_add_device_type_params\x18\x07 \x01(\x0b\x32&.datamodel.EndpointAddDeviceTypeParamsH\x00\x12\x41\n\x16remove_endpoint_params\x18\x08 \x01(\x0b\x32\x1f.datamodel.RemoveEndpointParamsH\x00\x12\x43\n\x17update_attribute_params\x18\t \x01(\x0b\x32 .datamodel.UpdateAttributeParamsH\x00\x12;\n\x13\x64\x65\x66ine_value_params\x18\n \x01(\x0b\x32\x1c.datamodel.DefineValueParamsH\x00\x12\x43\n\x17\x64\x65\x63lare_payloads_params\x18\x0b \x01(\x0b\x32 .datamodel.DeclarePayloadsParamsH\x00\"\xe4\x01\n\x0c\x46unctionType\x12\x14\n\x10\x43REATE_ATTRIBUTE\x10\x01\x12\x12\n\x0e\x43REATE_COMMAND\x10\x02\x12\x10\n\x0c\x43REATE_EVENT\x10\x03\x12\x12\n\x0e\x43REATE_CLUSTER\x10\x04\x12\x13\n\x0f\x43REATE_ENDPOINT\x10\x05\x12\x1c\n\x18\x45NDPOINT_ADD_DEVICE_TYPE\x10\x06\x12\x13\n\x0fREMOVE_ENDPOINT\x10\x07\x12\x14\n\x10UPDATE_ATTRIBUTE\x10\x08\x12\x10\n\x0c\x44\x45\x46INE_VALUE\x10\t\x12\x14\n\x10\x44\x45\x43LARE_PAYLOADS\x10\nB\x08\n\x06params*\xf1\x05\n\x10\x45spMatterValType\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_INVALID\x10\x00\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_BOOLEAN\x10\x01\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_INTEGER\x10\x02\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_FLOAT\x10\x03\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_ARRAY\x10\x04\x12#\n\x1f\x45SP_MATTER_VAL_TYPE_CHAR_STRING\x10\x05\x12$\n ESP_MATTER_VAL_TYPE_OCTET_STRING\x10\x06\x12\x1c\n\x18\x45SP_MATTER_VAL_TYPE_INT8\x10\x07\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_UINT8\x10\x08\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT16\x10\t\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT16\x10\n\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT32\x10\x0b\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT32\x10\x0c\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_INT64\x10\r\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_UINT64\x10\x0e\x12\x1d\n\x19\x45SP_MATTER_VAL_TYPE_ENUM8\x10\x0f\x12\x1f\n\x1b\x45SP_MATTER_VAL_TYPE_BITMAP8\x10\x10\x12 \n\x1c\x45SP_MATTER_VAL_TYPE_BITMAP16\x10\x11\x12 \n\x1c\x45SP_MATTER_VAL_TYPE_BITMAP32\x10\x12\x12\x1e\n\x1a\x45SP_MATTER_VAL_TYPE_ENUM16\x10\x13\x12(\n$ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING\x10\x14\x12)\n%ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING\x10\x15')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'esp_matter_data_model_api_messages_pb2', _globals)
 if _descriptor._USE_C_DESCRIPTORS == False:
   DESCRIPTOR._options = None
-  _globals['_ESPMATTERVALTYPE']._serialized_start=1818
-  _globals['_ESPMATTERVALTYPE']._serialized_end=2571
+  _globals['_ESPMATTERVALTYPE']._serialized_start=2695
+  _globals['_ESPMATTERVALTYPE']._serialized_end=3448
   _globals['_ESPMATTERVAL']._serialized_start=56
   _globals['_ESPMATTERVAL']._serialized_end=323
   _globals['_ESPMATTERARRAY']._serialized_start=325
@@ -30,19 +30,27 @@ if _descriptor._USE_C_DESCRIPTORS == False:
   _globals['_ESPMATTERATTRVAL']._serialized_start=394
   _globals['_ESPMATTERATTRVAL']._serialized_end=493
   _globals['_CREATEATTRIBUTEPARAMS']._serialized_start=496
-  _globals['_CREATEATTRIBUTEPARAMS']._serialized_end=751
-  _globals['_CREATECOMMANDPARAMS']._serialized_start=753
-  _globals['_CREATECOMMANDPARAMS']._serialized_end=850
-  _globals['_CREATEEVENTPARAMS']._serialized_start=852
-  _globals['_CREATEEVENTPARAMS']._serialized_end=930
-  _globals['_CREATECLUSTERPARAMS']._serialized_start=932
-  _globals['_CREATECLUSTERPARAMS']._serialized_end=1009
-  _globals['_CREATEENDPOINTPARAMS']._serialized_start=1011
-  _globals['_CREATEENDPOINTPARAMS']._serialized_end=1069
-  _globals['_ENDPOINTADDDEVICETYPEPARAMS']._serialized_start=1071
-  _globals['_ENDPOINTADDDEVICETYPEPARAMS']._serialized_end=1174
-  _globals['_FUNCTIONCALL']._serialized_start=1177
-  _globals['_FUNCTIONCALL']._serialized_end=1815
-  _globals['_FUNCTIONCALL_FUNCTIONTYPE']._serialized_start=1660
-  _globals['_FUNCTIONCALL_FUNCTIONTYPE']._serialized_end=1805
+  _globals['_CREATEATTRIBUTEPARAMS']._serialized_end=885
+  _globals['_CREATECOMMANDPARAMS']._serialized_start=887
+  _globals['_CREATECOMMANDPARAMS']._serialized_end=984
+  _globals['_CREATEEVENTPARAMS']._serialized_start=986
+  _globals['_CREATEEVENTPARAMS']._serialized_end=1064
+  _globals['_CREATECLUSTERPARAMS']._serialized_start=1066
+  _globals['_CREATECLUSTERPARAMS']._serialized_end=1143
+  _globals['_CREATEENDPOINTPARAMS']._serialized_start=1145
+  _globals['_CREATEENDPOINTPARAMS']._serialized_end=1203
+  _globals['_ENDPOINTADDDEVICETYPEPARAMS']._serialized_start=1205
+  _globals['_ENDPOINTADDDEVICETYPEPARAMS']._serialized_end=1308
+  _globals['_REMOVEENDPOINTPARAMS']._serialized_start=1310
+  _globals['_REMOVEENDPOINTPARAMS']._serialized_end=1353
+  _globals['_UPDATEATTRIBUTEPARAMS']._serialized_start=1356
+  _globals['_UPDATEATTRIBUTEPARAMS']._serialized_end=1589
+  _globals['_DEFINEVALUEPARAMS']._serialized_start=1591
+  _globals['_DEFINEVALUEPARAMS']._serialized_end=1663
+  _globals['_DECLAREPAYLOADSPARAMS']._serialized_start=1665
+  _globals['_DECLAREPAYLOADSPARAMS']._serialized_end=1702
+  _globals['_FUNCTIONCALL']._serialized_start=1705
+  _globals['_FUNCTIONCALL']._serialized_end=2692
+  _globals['_FUNCTIONCALL_FUNCTIONTYPE']._serialized_start=2454
+  _globals['_FUNCTIONCALL_FUNCTIONTYPE']._serialized_end=2682
 # @@protoc_insertion_point(module_scope)
@@ -8,12 +8,21 @@ matter_data_model_serializer.py
 Usage:
     python matter_data_model_serializer.py -z <path_to_.zap_file> [--chip-sdk-path <chip_sdk_root>] [--no-nvs-bin]
     python matter_data_model_serializer.py -m <path_to_.matter_file> [--chip-sdk-path <chip_sdk_root>] [--no-nvs-bin]
+    python matter_data_model_serializer.py -m <path_to_new_.matter_file> --delta-from <path_to_old_.matter_file>
+    python matter_data_model_serializer.py -m <path_to_.matter_file> --shape-endpoint <endpoint_id>
+    python matter_data_model_serializer.py -m <path_to_.matter_file> --target esp32c2 [--footprint-budgets <file>]
+    python matter_data_model_serializer.py -m <path_to_.matter_file> --access-profile <profile.json>
+    python matter_data_model_serializer.py --batch <directory_or_list_file> [-j <jobs>]
 
 """
 
 import argparse
+import hashlib
+import json
 import os
 import sys
+import time
+from concurrent.futures import ProcessPoolExecutor, as_completed
 from pathlib import Path
 from shutil import copy2
 
@@ -48,51 +57,126 @@ def parse_args():
     group = parser.add_mutually_exclusive_group(required=True)
     group.add_argument("-z", "--zap", help="Path to .zap file", type=str)
     group.add_argument("-m", "--matter", help="Path to .matter file", type=str)
+    group.add_argument(
+        "--batch",
+        help="Directory with .zap/.matter files, or a text file listing one input per line, to serialize in parallel",
+        type=str,
+    )
     parser.add_argument(
         "--chip-sdk-path",
         help="Path to connectedhomeip SDK root (if not using esp-matter)",
         type=str,
     )
     parser.add_argument("--no-nvs-bin", help="Do not generate NVS partition binary", action="store_true")
-    return parser.parse_args()
-
-
-def main():
-    args = parse_args()
+    parser.add_argument(
+        "--cache-dir",
+        help="Directory for the attribute bounds cache shared between runs "
+        "(default: $MATTER_DM_SERIALIZER_CACHE or ~/.cache/matter_data_model_serializer)",
+        type=str,
+    )
+    parser.add_argument(
+        "--json",
+        help="Also write the intermediate JSON data model (for debugging, the binary is built in memory)",
+        action="store_true",
+    )
+    parser.add_argument(
+        "--delta-from",
+        help="Path to the .matter file of the data model on the device, to also generate a delta binary",
+        type=str,
+    )
+    parser.add_argument(
+        "--no-value-pool",
+        help="Store every attribute value inline instead of sharing repeated values",
+        action="store_true",
+    )
+    parser.add_argument(
+        "--no-optimize",
+        help="Keep the IDL order and write every default value, instead of sorting canonically and eliding defaults",
+        action="store_true",
+    )
+    parser.add_argument(
+        "--out-of-line-threshold",
+        help="Move the payloads of constant array and long string attributes of at least this many bytes to a "
+        "payload section, read by the device on the first access instead of at boot (default: 0, disabled)",
+        type=int,
+        default=0,
+    )
+    parser.add_argument(
+        "--access-profile",
+        help="JSON file with the access counts per attribute, to create the most accessed clusters and attributes "
+        "first (see utils/matter_data_model_access_profile.py)",
+        type=str,
+    )
+    parser.add_argument(
+        "--header",
+        help="Also generate a C++ header with the data model as constexpr tables, for Interpreter::interpret_static",
+        action="store_true",
+    )
+    parser.add_argument(
+        "--shape-endpoint",
+        help="Also generate an endpoint shape binary from this endpoint, for Interpreter::register_shape",
+        type=int,
+    )
+    parser.add_argument(
+        "--target",
+        help="Check the estimated footprint of the binary against the budgets of this target (e.g. esp32c2)",
+        type=str,
+    )
+    parser.add_argument(
+        "--footprint-budgets",
+        help="JSON file with the footprint budgets per target (default: footprint_budgets.json)",
+        type=str,
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        help="Number of worker processes for --batch (default: number of CPUs)",
+        type=int,
+    )
+    args = parser.parse_args()
+    if args.batch and (args.delta_from or args.shape_endpoint is not None):
+        parser.error("--delta-from and --shape-endpoint apply to a single input, not to --batch")
+    return args
 
-    # Determine chip_sdk_root from --chip-sdk-path or use None to trigger fallback.
-    if args.chip_sdk_path:
-        chip_sdk_root = Path(args.chip_sdk_path)
-    else:
-        chip_sdk_root = None
-    chip_sdk_root = setup_matter_paths(chip_sdk_root)
 
-    from matter_data_model_conversion.create_json import create_json_data_model
-    from matter_data_model_conversion.create_binary import create_binary_file
+def serialize_model(input_file: Path, file_type: str, args, chip_sdk_root: Path, out_dir: Path, bounds_index: Path) -> dict:
+    """
+    Serialize one .zap or .matter file into out_dir/<stem>/ and return the generated files by kind.
+    Exits on failure, like the individual steps do.
+    """
+    from matter_data_model_conversion.create_json import generate_json_data_model, load_idl_text, write_json_data_model
+    from matter_data_model_conversion.create_binary import create_shape_file, write_binary_file
+    from matter_data_model_conversion.create_delta import write_delta_file
+    from matter_data_model_conversion.create_header import write_header_file
     from utils.matter_data_model_serializer_helpers import (
         modify_zap_file,
         run_generate_script,
-        ensure_attribute_files,
         run_linter,
         generate_nvs_input_csv,
         gen_nvs_partition_bin,
     )
+    from utils.matter_data_model_access_profile import load_access_profile
+    from utils.matter_data_model_footprint import DEFAULT_BUDGETS, check_binary
 
-    # Determine input type and file.
-    if args.zap:
-        file_type = "zap"
-        input_file = Path(args.zap)
-    else:
-        file_type = "matter"
-        input_file = Path(args.matter)
+    outputs = {}
+    timings = {}
 
     if not input_file.exists():
         print(f"File not found: {input_file}")
         sys.exit(1)
 
-    # Create output directories.
-    out_dir = Path("serializer_output").resolve()
-    out_dir.mkdir(exist_ok=True)
+    if args.delta_from and not Path(args.delta_from).exists():
+        print(f"File not found: {args.delta_from}")
+        sys.exit(1)
+
+    profile = None
+    if args.access_profile:
+        try:
+            profile = load_access_profile(args.access_profile)
+        except (OSError, ValueError) as e:
+            print(f"Failed to load the access profile: {e}")
+            sys.exit(1)
+
     sub_out_dir = out_dir / input_file.stem
     sub_out_dir.mkdir(exist_ok=True)
 
@@ -102,6 +186,7 @@ def main():
         copy2(input_file, zap_dest)
         print(f"Copied {input_file} to {zap_dest}")
         modify_zap_file(zap_dest, chip_sdk_root)
+        outputs["zap"] = zap_dest
 
         # Run generate.py to convert the .zap file to a .matter file.
         run_generate_script(zap_dest, sub_out_dir, chip_sdk_root)
@@ -115,26 +200,77 @@ def main():
         matter_file = (sub_out_dir / input_file.name).resolve()
         copy2(input_file, matter_file)
         print(f"Copied {input_file} to {matter_file}")
+    outputs["matter"] = matter_file
 
     # Process the .matter file.
 
-    # Create the attribute_bounds files (for looking up attribute bounds)
-    attr_csv = out_dir / "attribute_bounds.csv"
-    attr_pickle = out_dir / "attribute_bounds.pkl"
-    ensure_attribute_files(attr_csv, attr_pickle, chip_sdk_root)
-
     # Run the linter on the .matter file
+    start = time.perf_counter()
     run_linter(matter_file, chip_sdk_root)
-    json_file_path = sub_out_dir / (input_file.stem + ".json")
+    timings["lint"] = time.perf_counter() - start
+
+    # Build the data model in memory, with the attribute bounds from the bounds index
+    start = time.perf_counter()
+    data_model = generate_json_data_model(load_idl_text(matter_file), bounds_index)
+    timings["data model"] = time.perf_counter() - start
 
-    # Pass attribute_bounds pickle file to create_json_data_model
-    create_json_data_model(matter_file, json_file_path, attr_pickle)
-    print(f"Created JSON data model: {json_file_path}")
+    if args.json:
+        json_file_path = sub_out_dir / (input_file.stem + ".json")
+        write_json_data_model(data_model, json_file_path)
+        outputs["json"] = json_file_path
 
-    # Convert the data model JSON to a binary file (containing proto messages)
+    # Serialize the data model into the binary file (containing proto messages)
+    start = time.perf_counter()
     bin_file_path = sub_out_dir / (input_file.stem + ".bin")
-    create_binary_file(json_file_path, bin_file_path)
+    bin_data = write_binary_file(
+        data_model,
+        bin_file_path,
+        use_value_pool=not args.no_value_pool,
+        optimize=not args.no_optimize,
+        profile=profile,
+        out_of_line_threshold=args.out_of_line_threshold,
+    )
+    timings["binary"] = time.perf_counter() - start
     print(f"Created binary file: {bin_file_path}")
+    outputs["bin"] = bin_file_path
+    print("Timing: " + ", ".join(f"{stage} {seconds * 1000:.1f} ms" for stage, seconds in timings.items()))
+
+    # Fail before anything is flashed if the data model does not fit the target.
+    if args.target:
+        try:
+            _, _, exceeded = check_binary(bin_data, args.target, args.footprint_budgets or DEFAULT_BUDGETS)
+        except ValueError as e:
+            print(f"Failed to check the footprint: {e}")
+            sys.exit(1)
+        if exceeded:
+            sys.exit(1)
+
+    # Optionally create the delta from the data model currently on the device.
+    if args.delta_from:
+        old_data_model = generate_json_data_model(load_idl_text(args.delta_from), bounds_index)
+        delta_file_path = sub_out_dir / (input_file.stem + ".delta.bin")
+        try:
+            write_delta_file(old_data_model, data_model, delta_file_path, profile)
+        except ValueError as e:
+            print(f"Failed to create delta: {e}")
+            sys.exit(1)
+        outputs["delta"] = delta_file_path
+
+    # Optionally create an endpoint shape to instantiate at runtime (e.g. for bridged devices).
+    if args.shape_endpoint is not None:
+        shape_file_path = sub_out_dir / f"{input_file.stem}.ep{args.shape_endpoint}.shape.bin"
+        try:
+            create_shape_file(data_model, args.shape_endpoint, shape_file_path, profile)
+        except ValueError as e:
+            print(f"Failed to create shape: {e}")
+            sys.exit(1)
+        outputs["shape"] = shape_file_path
+
+    # Optionally compile the data model into the application instead of interpreting the binary.
+    if args.header:
+        header_file_path = sub_out_dir / (input_file.stem + "_data_model.hpp")
+        write_header_file(data_model, header_file_path, source=matter_file.name, profile=profile)
+        outputs["header"] = header_file_path
 
     # Optionally generate the NVS partition binary.
     if not args.no_nvs_bin:
@@ -168,19 +304,145 @@ def main():
             nvs_input_csv_filename=str(nvs_csv),
             no_unencrypted_fctry=False,
         )
+        outputs["nvs_bin"] = sub_out_dir / (input_file.stem + ".nvs.bin")
     else:
         print("Skipping NVS partition binary generation as per --no-nvs-bin flag.")
 
+    return outputs
+
+
+def batch_inputs(batch: Path) -> list:
+    """Inputs of a batch: the .zap/.matter files of a directory, or the lines of a list file."""
+    if batch.is_dir():
+        inputs = sorted(p for p in batch.iterdir() if p.suffix in (".zap", ".matter"))
+    else:
+        with open(batch) as f:
+            lines = [line.strip() for line in f]
+        # Relative entries are relative to the list file.
+        inputs = [batch.parent / line for line in lines if line and not line.startswith("#")]
+    return inputs
+
+
+def file_entry(path: Path, out_dir: Path) -> dict:
+    data = path.read_bytes()
+    return {"path": str(path.resolve().relative_to(out_dir)), "size": len(data), "sha256": hashlib.sha256(data).hexdigest()}
+
+
+def init_batch_worker(chip_sdk_root: Path, bounds_index: Path):
+    setup_matter_paths(chip_sdk_root)
+    # Loaded once per worker, and inherited from the parent where workers are forked.
+    from attribute_bounds.attribute_bounds_lookup import get_bounds_lookup
+
+    get_bounds_lookup(bounds_index)
+
+
+def serialize_batch_model(input_file: Path, args, chip_sdk_root: Path, out_dir: Path, bounds_index: Path) -> dict:
+    entry = {"input": str(input_file), "input_sha256": hashlib.sha256(input_file.read_bytes()).hexdigest()}
+    try:
+        file_type = "zap" if input_file.suffix == ".zap" else "matter"
+        outputs = serialize_model(input_file, file_type, args, chip_sdk_root, out_dir, bounds_index)
+    except SystemExit as e:
+        entry.update(status="failed", error=f"exited with code {e.code}")
+        return entry
+    except Exception as e:
+        entry.update(status="failed", error=str(e))
+        return entry
+    entry["status"] = "ok"
+    entry["outputs"] = {kind: file_entry(path, out_dir) for kind, path in outputs.items()}
+    return entry
+
+
+def run_batch(args, chip_sdk_root: Path, out_dir: Path, bounds_index: Path):
+    from attribute_bounds.attribute_bounds_lookup import get_bounds_lookup
+
+    batch = Path(args.batch)
+    if not batch.exists():
+        print(f"File not found: {batch}")
+        sys.exit(1)
+    inputs = batch_inputs(batch)
+    missing = [str(p) for p in inputs if not p.exists()]
+    if missing:
+        print(f"Files not found: {', '.join(missing)}")
+        sys.exit(1)
+    stems = [p.stem for p in inputs]
+    duplicates = sorted({stem for stem in stems if stems.count(stem) > 1})
+    if duplicates:
+        print(f"Inputs would share an output directory: {', '.join(duplicates)}")
+        sys.exit(1)
+
+    # Parse the bounds table once, before the workers are started, so that forked workers share it.
+    get_bounds_lookup(bounds_index)
+
+    results = []
+    with ProcessPoolExecutor(
+        max_workers=args.jobs, initializer=init_batch_worker, initargs=(chip_sdk_root, bounds_index)
+    ) as executor:
+        futures = {
+            executor.submit(serialize_batch_model, input_file, args, chip_sdk_root, out_dir, bounds_index): input_file
+            for input_file in inputs
+        }
+        for future in as_completed(futures):
+            result = future.result()
+            print(f"[{result['status']}] {result['input']}")
+            results.append(result)
+
+    results.sort(key=lambda result: result["input"])
+    manifest_path = out_dir / "manifest.json"
+    with open(manifest_path, "w") as f:
+        json.dump({"models": results}, f, indent=2)
+
+    failed = [result for result in results if result["status"] != "ok"]
+    print(f"Serialized {len(results) - len(failed)} of {len(results)} models, manifest: {manifest_path}")
+    if failed:
+        sys.exit(1)
+
+
+def main():
+    args = parse_args()
+
+    # Determine chip_sdk_root from --chip-sdk-path or use None to trigger fallback.
+    if args.chip_sdk_path:
+        chip_sdk_root = Path(args.chip_sdk_path)
+    else:
+        chip_sdk_root = None
+    chip_sdk_root = setup_matter_paths(chip_sdk_root)
+
+    from utils.matter_data_model_serializer_helpers import default_cache_dir, ensure_bounds_index
+
+    # Create output directories.
+    out_dir = Path("serializer_output").resolve()
+    out_dir.mkdir(exist_ok=True)
+
+    # Find or build the attribute bounds index for this SDK
+    cache_dir = Path(args.cache_dir) if args.cache_dir else default_cache_dir()
+    bounds_index = ensure_bounds_index(chip_sdk_root, cache_dir)
+
+    if args.batch:
+        run_batch(args, chip_sdk_root, out_dir, bounds_index)
+        return
+
+    if args.zap:
+        outputs = serialize_model(Path(args.zap), "zap", args, chip_sdk_root, out_dir, bounds_index)
+    else:
+        outputs = serialize_model(Path(args.matter), "matter", args, chip_sdk_root, out_dir, bounds_index)
+
     print("Serialization complete. The output directory contains:")
-    if file_type == "zap":
-        print(f" - Original .zap file: {zap_dest}")
+    if "zap" in outputs:
+        print(f" - Original .zap file: {outputs['zap']}")
     else:
-        print(f" - Provided .matter file: {matter_file}")
-    print(f" - Generated .matter file: {matter_file}")
-    print(f" - JSON data model: {json_file_path}")
-    print(f" - Binary file: {bin_file_path}")
-    if not args.no_nvs_bin:
-        print(f" - NVS partition binary: {sub_out_dir / (input_file.stem + '.nvs.bin')}")
+        print(f" - Provided .matter file: {outputs['matter']}")
+    print(f" - Generated .matter file: {outputs['matter']}")
+    if "json" in outputs:
+        print(f" - JSON data model: {outputs['json']}")
+    print(f" - Binary file: {outputs['bin']}")
+    if "delta" in outputs:
+        print(f" - Delta binary: {outputs['delta']}")
+    if "shape" in outputs:
+        print(f" - Shape binary: {outputs['shape']}")
+    if "header" in outputs:
+        print(f" - Data model header: {outputs['header']}")
+    if "nvs_bin" in outputs:
+        print(f" - NVS partition binary: {outputs['nvs_bin']}")
     else:
         print(" - NVS partition binary: (not generated)")
 
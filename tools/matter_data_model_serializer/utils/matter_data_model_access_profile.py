@@ -0,0 +1,108 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Attribute access profiles, to create the most accessed clusters and attributes first.
+
+esp_matter finds an attribute by walking the clusters of its endpoint, then the attributes of the
+cluster, in creation order. Every read, write and report of the interaction model goes through this
+lookup, so creating the hot attributes (OnOff, CurrentLevel, ...) first shortens the walk for most
+accesses. Endpoints are always created in ascending order, the interpreter relies on it.
+
+A profile is a JSON file with the number of accesses per attribute, e.g. counted on a device under a
+typical load:
+
+    {
+      "attributes": [
+        {"endpoint": 1, "cluster": "0x0006", "attribute": "0x0000", "count": 5200},
+        {"cluster": 8, "attribute": 0, "count": 3100}
+      ]
+    }
+
+Ids are numbers or hex strings. An entry without an endpoint applies to every endpoint. Clusters are
+ordered by the sum of the counts of their attributes, attributes by their count, both in descending
+order. Ties and attributes missing from the profile keep the order they would have without it.
+"""
+import json
+from collections import Counter, defaultdict
+
+
+def parse_id(value, name):
+    if isinstance(value, int) and not isinstance(value, bool) and value >= 0:
+        return value
+    if isinstance(value, str):
+        try:
+            return int(value, 0)
+        except ValueError:
+            pass
+    raise ValueError(f"Invalid {name} id: {value!r}")
+
+
+class AccessProfile:
+    def __init__(self, entries):
+        # Counts by (endpoint or None, cluster, attribute).
+        self.counts = Counter()
+        for entry in entries:
+            if not isinstance(entry, dict) or "cluster" not in entry or "attribute" not in entry:
+                raise ValueError(f"Profile entry without cluster and attribute: {entry!r}")
+            endpoint = parse_id(entry["endpoint"], "endpoint") if entry.get("endpoint") is not None else None
+            count = entry.get("count", 1)
+            if not isinstance(count, int) or count < 0:
+                raise ValueError(f"Invalid count in profile entry: {entry!r}")
+            key = (endpoint, parse_id(entry["cluster"], "cluster"), parse_id(entry["attribute"], "attribute"))
+            self.counts[key] += count
+
+        self.cluster_counts = defaultdict(int)
+        for (endpoint, cluster, _), count in self.counts.items():
+            self.cluster_counts[endpoint, cluster] += count
+
+    def attribute_count(self, endpoint_id, cluster_id, attribute_id):
+        return self.counts[endpoint_id, cluster_id, attribute_id] + self.counts[None, cluster_id, attribute_id]
+
+    def cluster_count(self, endpoint_id, cluster_id):
+        return self.cluster_counts.get((endpoint_id, cluster_id), 0) + self.cluster_counts.get((None, cluster_id), 0)
+
+    def order_clusters(self, endpoint_id, clusters):
+        # sorted() is stable, so the clusters with the same count keep their order.
+        return sorted(clusters, key=lambda cluster: -self.cluster_count(endpoint_id, cluster["code"]))
+
+    def order_attributes(self, endpoint_id, cluster_id, attributes):
+        return sorted(
+            attributes,
+            key=lambda attribute: -self.attribute_count(endpoint_id, cluster_id, attribute["definition"]["code"]),
+        )
+
+    def lookup_steps(self, messages):
+        """
+        Average number of list entries esp_matter visits to find an attribute of the profile, for the
+        clusters and attributes created by messages. Attributes not in messages are not counted.
+        """
+        clusters = defaultdict(list)
+        attributes = defaultdict(list)
+        for message in messages:
+            if message.HasField("create_cluster_params"):
+                params = message.create_cluster_params
+                clusters[params.endpoint_id].append(params.cluster_id)
+            elif message.HasField("create_attribute_params"):
+                params = message.create_attribute_params
+                attributes[params.endpoint_id, params.cluster_id].append(params.attribute_id)
+
+        total_steps = 0
+        total_count = 0
+        for (endpoint_id, cluster_id), attribute_ids in attributes.items():
+            cluster_steps = clusters[endpoint_id].index(cluster_id) + 1
+            for position, attribute_id in enumerate(attribute_ids):
+                count = self.attribute_count(endpoint_id, cluster_id, attribute_id)
+                total_steps += count * (cluster_steps + position + 1)
+                total_count += count
+        return total_steps / total_count if total_count else 0.0
+
+
+def load_access_profile(path):
+    with open(path) as f:
+        try:
+            profile = json.load(f)
+        except json.JSONDecodeError as e:
+            raise ValueError(f"{path}: {e}")
+    if not isinstance(profile, dict) or not isinstance(profile.get("attributes"), list):
+        raise ValueError(f"{path}: expected an object with an \"attributes\" list")
+    return AccessProfile(profile["attributes"])
@@ -15,40 +15,38 @@ def read_protobuf_messages(file_path):
     Generator function that reads Protobuf messages one by one from the given file.
     Yields each message in JSON (dict) form.
     """
-    index = 0
-
     with open(file_path, "rb") as f:
-        while True:
-            # Read the size of the next message (varint)
-            buf = f.read(1)
-            if not buf:
-                break  # End of file
-
-            # Read more bytes if necessary until we can decode the varint
-            while buf[-1] & 0x80:
-                more_byte = f.read(1)
-                if not more_byte:
-                    raise IOError("Unexpected end of file while reading varint.")
-                buf += more_byte
-
-            # Decode the size from the varint
-            size, _ = _DecodeVarint32(buf, 0)
+        data = f.read()
 
-            # Read the message itself
-            message_data = f.read(size)
-            if len(message_data) != size:
-                raise IOError(f"Incomplete message read, expected {size} bytes but got {len(message_data)}.")
-
-            # Parse the message
-            function_call = emdm_pb2.FunctionCall()
-            function_call.ParseFromString(message_data)
-
-            # Convert the message to JSON (dict)
-            message_json = json.loads(function_call_to_json(function_call))
-            message_json["message_index"] = index
-
-            yield message_json
-            index += 1
+    index = 0
+    pos = 0
+    end = len(data)
+    while pos < end:
+        # Decode the size of the next message (varint)
+        try:
+            size, pos = _DecodeVarint32(data, pos)
+        except IndexError:
+            raise IOError("Unexpected end of file while reading varint.")
+
+        # Read the message itself
+        message_data = data[pos : pos + size]
+        if len(message_data) != size:
+            raise IOError(f"Incomplete message read, expected {size} bytes but got {len(message_data)}.")
+        pos += size
+
+        # Parse the message
+        function_call = emdm_pb2.FunctionCall()
+        function_call.ParseFromString(message_data)
+
+        # Convert the message to JSON (dict)
+        message_json = json.loads(function_call_to_json(function_call))
+        message_json["message_index"] = index
+        # The payload section declared by the first message is not made of messages.
+        if function_call.HasField("declare_payloads_params"):
+            end = len(data) - function_call.declare_payloads_params.size
+
+        yield message_json
+        index += 1
 
 
 def function_call_to_json(function_call):
@@ -68,33 +66,45 @@ def function_call_to_json(function_call):
         result["endpoint_add_device_type_params"] = endpoint_add_device_type_params_to_json(
             function_call.endpoint_add_device_type_params
         )
+    elif function_call.HasField("remove_endpoint_params"):
+        result["remove_endpoint_params"] = remove_endpoint_params_to_json(function_call.remove_endpoint_params)
+    elif function_call.HasField("update_attribute_params"):
+        result["update_attribute_params"] = update_attribute_params_to_json(function_call.update_attribute_params)
+    elif function_call.HasField("declare_payloads_params"):
+        result["declare_payloads_params"] = {"size": function_call.declare_payloads_params.size}
+    elif function_call.HasField("define_value_params"):
+        result["define_value_params"] = {
+            "index": function_call.define_value_params.index,
+            "val": extract_val(function_call.define_value_params.val),
+        }
 
     return json.dumps(result, default=str)
 
 
-def create_attribute_params_to_json(params):
-    def extract_val(val):
-        return {
-            key: value
-            for key, value in {
-                "b": val.b if val.HasField("b") else None,
-                "i": val.i if val.HasField("i") else None,
-                "f": val.f if val.HasField("f") else None,
-                "i8": val.i8 if val.HasField("i8") else None,
-                "u8": val.u8 if val.HasField("u8") else None,
-                "i16": val.i16 if val.HasField("i16") else None,
-                "u16": val.u16 if val.HasField("u16") else None,
-                "i32": val.i32 if val.HasField("i32") else None,
-                "u32": val.u32 if val.HasField("u32") else None,
-                "i64": val.i64 if val.HasField("i64") else None,
-                "u64": val.u64 if val.HasField("u64") else None,
-                "a": val.a.elements.hex() if val.HasField("a") else None,
-                "char_string": val.char_string if val.HasField("char_string") else None,
-                "octet_string": val.octet_string.hex() if val.HasField("octet_string") else None,
-            }.items()
-            if value is not None
-        }
+def extract_val(val):
+    return {
+        key: value
+        for key, value in {
+            "b": val.b if val.HasField("b") else None,
+            "i": val.i if val.HasField("i") else None,
+            "f": val.f if val.HasField("f") else None,
+            "i8": val.i8 if val.HasField("i8") else None,
+            "u8": val.u8 if val.HasField("u8") else None,
+            "i16": val.i16 if val.HasField("i16") else None,
+            "u16": val.u16 if val.HasField("u16") else None,
+            "i32": val.i32 if val.HasField("i32") else None,
+            "u32": val.u32 if val.HasField("u32") else None,
+            "i64": val.i64 if val.HasField("i64") else None,
+            "u64": val.u64 if val.HasField("u64") else None,
+            "a": val.a.elements.hex() if val.HasField("a") else None,
+            "char_string": val.char_string if val.HasField("char_string") else None,
+            "octet_string": val.octet_string.hex() if val.HasField("octet_string") else None,
+        }.items()
+        if value is not None
+    }
+
 
+def create_attribute_params_to_json(params):
     return {
         "endpoint_id": params.endpoint_id,
         "cluster_id": params.cluster_id,
@@ -107,6 +117,18 @@ def create_attribute_params_to_json(params):
         "max_val_size": params.max_val_size,
         "bounds_min": extract_val(params.bounds_min),
         "bounds_max": extract_val(params.bounds_max),
+        **{
+            field: getattr(params, field)
+            for field in (
+                "val_ref",
+                "bounds_min_ref",
+                "bounds_max_ref",
+                "payload_offset",
+                "payload_size",
+                "payload_crc32",
+            )
+            if params.HasField(field)
+        },
     }
 
 
@@ -147,6 +169,25 @@ def endpoint_add_device_type_params_to_json(params):
     }
 
 
+def remove_endpoint_params_to_json(params):
+    return {"endpoint_id": params.endpoint_id}
+
+
+def update_attribute_params_to_json(params):
+    return {
+        "endpoint_id": params.endpoint_id,
+        "cluster_id": params.cluster_id,
+        "attribute_id": params.attribute_id,
+        "flags": params.flags,
+        "val": {
+            "type": emdm_pb2.EspMatterValType.Name(params.val.type),
+            "val": extract_val(params.val.val),
+        },
+        "bounds_min": extract_val(params.bounds_min),
+        "bounds_max": extract_val(params.bounds_max),
+    }
+
+
 def main():
     if len(sys.argv) < 2:
         print(
@@ -0,0 +1,251 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Estimate the on-device footprint of a data model binary and check it against per-target budgets.
+
+Run from the serializer directory:
+
+    python -m utils.matter_data_model_footprint <data_model.bin> --target esp32c2 [--budgets <file>] [--json <report>]
+
+The heap estimate covers what esp_matter allocates for the node built from the binary: the endpoint,
+cluster, attribute, command and event objects, attribute value payloads and bounds, and the Ember
+metadata created when an endpoint is enabled. It does not cover the Matter stack itself.
+
+The NVS estimate covers the data model blobs in the esp_matter_dm partition (both A/B slots, since an
+update writes the new blob before the old one is released) and the values of non-volatile attributes
+in the nvs partition.
+
+The exit status is 1 if a budget is exceeded, so the tool can be used as a build step.
+"""
+import argparse
+import json
+import math
+import sys
+from pathlib import Path
+
+from google.protobuf.internal.decoder import _DecodeVarint32
+from matter_data_model_conversion import esp_matter_data_model_api_messages_pb2 as emdm_pb2
+from matter_data_model_conversion.create_binary import split_payload_section
+from matter_data_model_conversion.matter_enums import AttributeFlags
+
+DEFAULT_BUDGETS = Path(__file__).resolve().parent.parent / "footprint_budgets.json"
+
+# Estimated sizes of the esp_matter data model objects on 32-bit targets, in bytes.
+# They follow the structures in esp_matter_data_model.cpp and have to be revisited when those change.
+ALLOC_OVERHEAD = 8
+ENDPOINT_SIZE = 136
+CLUSTER_SIZE = 56
+ATTRIBUTE_BASE_SIZE = 20  # attributes managed internally do not store a value
+ATTRIBUTE_SIZE = 48
+BOUNDS_SIZE = 32
+COMMAND_SIZE = 20
+EVENT_SIZE = 8
+
+# Ember metadata allocated by endpoint::enable().
+EMBER_ENDPOINT_SIZE = 16
+EMBER_CLUSTER_SIZE = 40  # EmberAfCluster and the cluster data version
+EMBER_ATTRIBUTE_SIZE = 16
+EMBER_LIST_ENTRY_SIZE = 4  # accepted and generated command ids, event ids, each list ends with a terminator
+
+# NVS layout: 4096 byte pages with 126 entries of 32 bytes, one page is kept free for garbage collection.
+NVS_PAGE_SIZE = 4096
+NVS_ENTRY_SIZE = 32
+NVS_ENTRIES_PER_PAGE = 126
+NVS_MAX_BLOB_CHUNK = (NVS_ENTRIES_PER_PAGE - 1) * NVS_ENTRY_SIZE
+NVS_SCALAR_MAX_SIZE = 8
+
+STRING_TYPES = {
+    emdm_pb2.ESP_MATTER_VAL_TYPE_CHAR_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_OCTET_STRING,
+    emdm_pb2.ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING,
+}
+
+
+def read_function_calls(data):
+    pos = 0
+    while pos < len(data):
+        size, pos = _DecodeVarint32(data, pos)
+        if pos + size > len(data):
+            raise ValueError("Truncated message in data model binary")
+        yield emdm_pb2.FunctionCall.FromString(data[pos : pos + size])
+        pos += size
+
+
+def allocation(size):
+    return size + ALLOC_OVERHEAD
+
+
+def payload_size(val):
+    """Size of the value payload esp_matter allocates separately from the attribute."""
+    case = val.WhichOneof("value")
+    if case == "char_string":
+        return len(val.char_string.encode()) + 1
+    if case == "octet_string":
+        return len(val.octet_string)
+    if case == "a":
+        return len(val.a.elements)
+    return 0
+
+
+def nvs_blob_entries(size):
+    """Entries used by a blob: one index entry, and one header entry plus the data for each chunk."""
+    entries = 1
+    while True:
+        chunk = min(size, NVS_MAX_BLOB_CHUNK)
+        entries += 1 + math.ceil(chunk / NVS_ENTRY_SIZE)
+        size -= chunk
+        if size <= 0:
+            return entries
+
+
+def nvs_pages(entries):
+    return math.ceil(entries / NVS_ENTRIES_PER_PAGE) + 1
+
+
+def analyze_binary(data):
+    """Return the footprint estimate of a data model binary as a dict."""
+    pool = []
+    endpoints = {}
+    current = None
+    counts = {"endpoints": 0, "clusters": 0, "attributes": 0, "commands": 0, "events": 0}
+    nvs_attribute_entries = 0
+
+    messages, _ = split_payload_section(data)
+    for message in read_function_calls(messages):
+        kind = message.WhichOneof("params")
+        if kind == "define_value_params":
+            pool.append(message.define_value_params.val)
+            continue
+        if kind == "declare_payloads_params":
+            continue
+        if kind == "create_endpoint_params":
+            endpoint_id = message.create_endpoint_params.endpoint_id
+            current = endpoints.setdefault(endpoint_id, {"heap": 0, "clusters": 0, "attributes": 0})
+            current["heap"] += allocation(ENDPOINT_SIZE) + allocation(EMBER_ENDPOINT_SIZE)
+            counts["endpoints"] += 1
+            continue
+        if current is None:
+            raise ValueError(f"Message {kind} before the first endpoint")
+
+        if kind == "create_cluster_params":
+            # The cluster object, its Ember cluster, and the terminators of its command and event lists.
+            current["heap"] += allocation(CLUSTER_SIZE) + EMBER_CLUSTER_SIZE + 3 * EMBER_LIST_ENTRY_SIZE
+            current["clusters"] += 1
+            counts["clusters"] += 1
+        elif kind == "create_attribute_params":
+            params = message.create_attribute_params
+            val = pool[params.val_ref] if params.HasField("val_ref") else params.val.val
+            if params.flags & AttributeFlags.ATTRIBUTE_FLAG_MANAGED_INTERNALLY:
+                heap = allocation(ATTRIBUTE_BASE_SIZE)
+            else:
+                heap = allocation(ATTRIBUTE_SIZE)
+                # Out-of-line payloads are allocated on the first access, count them like the others.
+                size = params.payload_size if params.HasField("payload_size") else payload_size(val)
+                if params.val.type in STRING_TYPES and params.HasField("max_val_size"):
+                    size = max(size, params.max_val_size)
+                if size:
+                    heap += allocation(size)
+                has_bounds = (params.HasField("bounds_min") or params.HasField("bounds_min_ref")) and (
+                    params.HasField("bounds_max") or params.HasField("bounds_max_ref")
+                )
+                if has_bounds:
+                    heap += allocation(BOUNDS_SIZE)
+                if params.flags & AttributeFlags.ATTRIBUTE_FLAG_NONVOLATILE:
+                    nvs_size = size if size else NVS_SCALAR_MAX_SIZE
+                    nvs_attribute_entries += 1 if nvs_size <= NVS_SCALAR_MAX_SIZE else nvs_blob_entries(nvs_size)
+            current["heap"] += heap + EMBER_ATTRIBUTE_SIZE
+            current["attributes"] += 1
+            counts["attributes"] += 1
+        elif kind == "create_command_params":
+            current["heap"] += allocation(COMMAND_SIZE) + EMBER_LIST_ENTRY_SIZE
+            counts["commands"] += 1
+        elif kind == "create_event_params":
+            current["heap"] += allocation(EVENT_SIZE) + EMBER_LIST_ENTRY_SIZE
+            counts["events"] += 1
+
+    # Two data model blobs (A/B slots) and the slot state record.
+    dm_entries = 2 * nvs_blob_entries(len(data)) + nvs_blob_entries(64)
+    return {
+        "binary_bytes": len(data),
+        "counts": counts,
+        "endpoints": endpoints,
+        "heap_bytes": sum(endpoint["heap"] for endpoint in endpoints.values()),
+        "dm_nvs_bytes": nvs_pages(dm_entries) * NVS_PAGE_SIZE,
+        "attribute_nvs_bytes": nvs_pages(nvs_attribute_entries) * NVS_PAGE_SIZE,
+    }
+
+
+def load_budgets(budgets_file, target):
+    with open(budgets_file) as f:
+        budgets = json.load(f)
+    if target not in budgets:
+        raise ValueError(f"No budgets for target {target} in {budgets_file}")
+    return budgets[target]
+
+
+def check_budgets(report, budgets):
+    """Print the report against the budgets and return the list of exceeded budgets."""
+    exceeded = []
+    for key in ("heap_bytes", "dm_nvs_bytes", "attribute_nvs_bytes"):
+        budget = budgets.get(key)
+        status = "no budget"
+        if budget is not None:
+            status = "OK" if report[key] <= budget else "EXCEEDED"
+            if report[key] > budget:
+                exceeded.append(key)
+        print(f"- {key}: {report[key]} / {budget if budget is not None else '-'} ({status})")
+    return exceeded
+
+
+def print_report(report):
+    counts = report["counts"]
+    print(
+        f"Data model: {report['binary_bytes']} bytes, {counts['endpoints']} endpoints, {counts['clusters']} clusters, "
+        f"{counts['attributes']} attributes, {counts['commands']} commands, {counts['events']} events"
+    )
+    for endpoint_id, endpoint in sorted(report["endpoints"].items()):
+        print(
+            f"  endpoint {endpoint_id}: ~{endpoint['heap']} bytes heap "
+            f"({endpoint['clusters']} clusters, {endpoint['attributes']} attributes)"
+        )
+
+
+def check_binary(data, target, budgets_file=DEFAULT_BUDGETS):
+    """Analyze the binary, print the report and return it with the budgets and the exceeded budgets."""
+    budgets = load_budgets(budgets_file, target)
+    report = analyze_binary(data)
+    print_report(report)
+    print(f"Budgets for {target}:")
+    exceeded = check_budgets(report, budgets)
+    if exceeded:
+        print(f"Footprint exceeds the {target} budget: {', '.join(exceeded)}")
+    return report, budgets, exceeded
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Estimate the footprint of a data model binary and check budgets.")
+    parser.add_argument("bin", help="Data model binary")
+    parser.add_argument("--target", required=True, help="Target to take the budgets for, e.g. esp32c2")
+    parser.add_argument("--budgets", default=str(DEFAULT_BUDGETS), help="JSON file with the budgets per target")
+    parser.add_argument("--json", help="Also write the report to this JSON file")
+    args = parser.parse_args()
+
+    with open(args.bin, "rb") as f:
+        data = f.read()
+    try:
+        report, budgets, exceeded = check_binary(data, args.target, args.budgets)
+    except ValueError as e:
+        print(f"Failed to analyze {args.bin}: {e}")
+        sys.exit(1)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"target": args.target, "budgets": budgets, **report}, f, indent=2)
+
+    if exceeded:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,174 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Create and apply binary patches between two data model binaries.
+
+Patch layout (all varints are unsigned LEB128, CRC-32 as computed by zlib.crc32):
+
+    b"DMP" <version:u8>
+    <source size:varint> <source crc32:u32 LE>
+    <target size:varint> <target crc32:u32 LE>
+    <op>...
+
+    COPY   0x00 <offset:varint> <length:varint>   copy bytes from the source binary
+    INSERT 0x01 <length:varint> <bytes>           append literal bytes
+
+Patches are applied on device by `data_model_manager::DataModelPatcher`.
+"""
+import argparse
+import difflib
+import struct
+import sys
+import zlib
+
+PATCH_MAGIC = b"DMP\x01"
+OP_COPY = 0x00
+OP_INSERT = 0x01
+
+# A COPY op costs its opcode and two varints, shorter matches are cheaper as literals.
+MIN_COPY_LENGTH = 8
+
+
+def encode_varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def decode_varint(data, pos):
+    result = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("Truncated varint in patch")
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return result, pos
+        shift += 7
+
+
+def diff_ops(source, target):
+    """Return a list of ("copy", offset, length) and ("insert", bytes) ops turning source into target."""
+    matcher = difflib.SequenceMatcher(None, source, target, autojunk=False)
+    ops = []
+    literal = bytearray()
+    for tag, i1, i2, j1, j2 in matcher.get_opcodes():
+        if tag == "equal" and i2 - i1 >= MIN_COPY_LENGTH:
+            if literal:
+                ops.append(("insert", bytes(literal)))
+                literal = bytearray()
+            ops.append(("copy", i1, i2 - i1))
+        elif tag != "delete":
+            literal += target[j1:j2]
+    if literal:
+        ops.append(("insert", bytes(literal)))
+    return ops
+
+
+def create_patch(source, target):
+    patch = bytearray(PATCH_MAGIC)
+    patch += encode_varint(len(source)) + struct.pack("<I", zlib.crc32(source))
+    patch += encode_varint(len(target)) + struct.pack("<I", zlib.crc32(target))
+    for op in diff_ops(source, target):
+        if op[0] == "copy":
+            patch.append(OP_COPY)
+            patch += encode_varint(op[1]) + encode_varint(op[2])
+        else:
+            patch.append(OP_INSERT)
+            patch += encode_varint(len(op[1])) + op[1]
+    return bytes(patch)
+
+
+def apply_patch(source, patch):
+    """Apply patch to source, verifying the source and target size and CRC-32 like the device does."""
+    if patch[: len(PATCH_MAGIC)] != PATCH_MAGIC:
+        raise ValueError("Unsupported patch header")
+    pos = len(PATCH_MAGIC)
+    source_size, pos = decode_varint(patch, pos)
+    (source_crc,) = struct.unpack_from("<I", patch, pos)
+    pos += 4
+    target_size, pos = decode_varint(patch, pos)
+    (target_crc,) = struct.unpack_from("<I", patch, pos)
+    pos += 4
+
+    if len(source) != source_size or zlib.crc32(source) != source_crc:
+        raise ValueError("Patch does not apply to the given source binary")
+
+    target = bytearray()
+    while pos < len(patch):
+        op = patch[pos]
+        pos += 1
+        if op == OP_COPY:
+            offset, pos = decode_varint(patch, pos)
+            length, pos = decode_varint(patch, pos)
+            if offset + length > len(source):
+                raise ValueError("Patch copies outside of the source binary")
+            target += source[offset : offset + length]
+        elif op == OP_INSERT:
+            length, pos = decode_varint(patch, pos)
+            if pos + length > len(patch):
+                raise ValueError("Truncated insert in patch")
+            target += patch[pos : pos + length]
+            pos += length
+        else:
+            raise ValueError(f"Unknown patch op 0x{op:02x}")
+
+    if len(target) != target_size or zlib.crc32(target) != target_crc:
+        raise ValueError("Patched binary failed verification")
+    return bytes(target)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Create or apply data model binary patches.")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    create_parser = subparsers.add_parser("create", help="Create a patch from the old and the new binary")
+    create_parser.add_argument("old_bin", help="Data model binary currently on the device")
+    create_parser.add_argument("new_bin", help="New data model binary")
+    create_parser.add_argument("patch", help="Output patch file")
+
+    apply_parser = subparsers.add_parser("apply", help="Apply a patch on the host")
+    apply_parser.add_argument("old_bin", help="Source data model binary")
+    apply_parser.add_argument("patch", help="Patch file")
+    apply_parser.add_argument("new_bin", help="Output data model binary")
+
+    args = parser.parse_args()
+
+    if args.command == "create":
+        with open(args.old_bin, "rb") as f:
+            source = f.read()
+        with open(args.new_bin, "rb") as f:
+            target = f.read()
+        patch = create_patch(source, target)
+        # Round trip before handing the patch out.
+        apply_patch(source, patch)
+        with open(args.patch, "wb") as f:
+            f.write(patch)
+        print(f"Patch written to: {args.patch}")
+        print(f"- Patch size: {len(patch)} bytes (new binary: {len(target)} bytes)")
+        print(f"- New binary CRC-32: 0x{zlib.crc32(target):08x}")
+    else:
+        with open(args.old_bin, "rb") as f:
+            source = f.read()
+        with open(args.patch, "rb") as f:
+            patch = f.read()
+        try:
+            target = apply_patch(source, patch)
+        except ValueError as e:
+            print(f"Failed to apply patch: {e}")
+            sys.exit(1)
+        with open(args.new_bin, "wb") as f:
+            f.write(target)
+        print(f"Patched binary written to: {args.new_bin}")
+
+
+if __name__ == "__main__":
+    main()
@@ -69,31 +69,34 @@ def run_generate_script(zap_dest: Path, out_dir: Path, chip_sdk_root: Path):
         sys.path.pop(0)
 
 
-def ensure_attribute_files(output_csv: Path, output_pickle: Path, chip_sdk_root: Path):
-    """
-    Ensure that the specified output_csv and output_pickle files exist.
-    If they do not exist, attempt to generate them using XMLs from chip_sdk_root.
+def default_cache_dir() -> Path:
+    """Cache shared by all checkouts and runs, MATTER_DM_SERIALIZER_CACHE overrides ~/.cache/matter_data_model_serializer."""
+    cache_dir = os.getenv("MATTER_DM_SERIALIZER_CACHE")
+    if cache_dir:
+        return Path(cache_dir)
+    return Path.home() / ".cache" / "matter_data_model_serializer"
 
-    Args:
-        output_csv (Path): The path where the CSV file should be located.
-        output_pickle (Path): The path where the pickle file should be located.
-        chip_sdk_root (Path): The root directory containing the attribute data.
 
-    Returns:
-        bool: True if both files exist after the attempt, False otherwise.
+def ensure_bounds_index(chip_sdk_root: Path, cache_dir: Path) -> Path:
     """
+    Return the attribute bounds index for the cluster XMLs of chip_sdk_root, building it if it is not cached.
 
-    def check_files_exist(file_paths):
-        return all(path.exists() for path in file_paths)
-
-    if not check_files_exist([output_csv, output_pickle]):
-        print(f"{output_csv} or {output_pickle} not found, generating them...")
-        from attribute_bounds.attribute_bounds_maker import process_directories
-
-        directories = [chip_sdk_root / "src" / "app" / "zap-templates" / "zcl" / "data-model" / "chip"]
-        process_directories([str(d) for d in directories], str(output_csv), str(output_pickle))
-
-    return check_files_exist([output_csv, output_pickle])
+    The index is keyed on a hash of the XML inputs, so SDK checkouts with the same cluster definitions share
+    it, and a changed XML never reuses a stale index.
+    """
+    from attribute_bounds.attribute_bounds_maker import hash_xml_inputs, sdk_revision, write_bounds_index
+
+    directories = [str(chip_sdk_root / "src" / "app" / "zap-templates" / "zcl" / "data-model" / "chip")]
+    xml_sha256 = hash_xml_inputs(directories)
+    bounds_index = cache_dir / f"attribute_bounds-{xml_sha256[:16]}.json"
+    if bounds_index.exists():
+        print(f"Using cached attribute bounds: {bounds_index}")
+        return bounds_index
+
+    print(f"{bounds_index} not found, generating it...")
+    cache_dir.mkdir(parents=True, exist_ok=True)
+    write_bounds_index(directories, bounds_index, xml_sha256, sdk_revision(chip_sdk_root))
+    return bounds_index
 
 
 def run_linter(idl_path: Path, chip_sdk_root: Path) -> None: